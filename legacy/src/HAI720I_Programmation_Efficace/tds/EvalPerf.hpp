@@ -39,11 +39,11 @@ struct EvalPerf {
         return (elapsed_s * 1000);
     }; /* renvoie le nombre de secondes*/
 
-    double cpi(int N) {
+    double cpi(double N) {
         return (double) N / nb_tot;
     }; /* renvoie le CPI*/
 
-    double ipc(int N) {
+    double ipc(double N) {
         return (double) nb_tot / N;
     }; /* renvoie l'IPC*/
 };
@@ -0,0 +1,313 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <omp.h>
+#include "Simd.hpp"
+
+/*  Matrices denses (double, rangement par lignes) et produit
+    C <- alpha A B + beta C.
+
+    gemm_bloque : version simple par blocs, un panneau GEMM_BK x GEMM_BJ de
+    B (256 Ko) reste dans le cache L2 pendant qu'on le multiplie par
+    GEMM_BI lignes de A ; la boucle interne c[j] += a(i, k) b[k][j] se
+    vectorise mais recharge et reecrit C a chaque k.
+
+    gemm_packe (et gemm hors petits produits) : schema a cinq boucles avec recopie en panneaux
+    (Goto, BLIS) :
+
+        jc : NC colonnes de B           panneau KC x NC de B dans le L3
+        pc : KC                         B recopie en micro-panneaux KC x NR
+        ic : MC lignes de A             bloc MC x KC de A dans le L2, recopie
+                                        en micro-panneaux MR x KC
+        jr, ir : micro-noyau            tuile MR x NR de C dans les registres,
+                                        KC fma vectorielles par accumulateur,
+                                        micro-panneau de B dans le L1
+
+    Les recopies rendent tous les acces du micro-noyau contigus (quelle que
+    soit la forme de A et B) et completent les bords par des zeros. La
+    tuile depend de l'isa (Simd.hpp) : 8 x 24 en avx512 (24 accumulateurs
+    sur 32 registres), 6 x 8 en avx2 + fma (12 sur 16), 4 x 4 en sse2.
+    Threads : le panneau de B est recopie en commun, puis les couples
+    (bloc ic, groupe de micro-panneaux jr) sont distribues, chaque thread
+    recopiant ses blocs de A ; les formes larges et basses (M petit) restent
+    ainsi paralleles. */
+
+#define GEMM_BI 64
+#define GEMM_BK 128
+#define GEMM_BJ 256
+
+struct Matrice {
+    int lignes = 0, colonnes = 0;
+    std::vector<double> v;
+
+    Matrice() {}
+    Matrice(int l, int c, double x = 0) : lignes(l), colonnes(c), v((size_t) l * c, x) {}
+
+    double* operator[](int i) { return v.data() + (size_t) i * colonnes; }
+    const double* operator[](int i) const { return v.data() + (size_t) i * colonnes; }
+};
+
+inline Matrice identite(int n) {
+    Matrice I(n, n);
+    for (int i = 0; i < n; i++) I[i][i] = 1;
+    return I;
+}
+
+/* Y <- Y + a X */
+inline void axpy(Matrice& Y, double a, const Matrice& X) {
+    for (size_t i = 0; i < Y.v.size(); i++) Y.v[i] += a * X.v[i];
+}
+
+/* Y <- Y + a I */
+inline void ajouter_identite(Matrice& Y, double a) {
+    for (int i = 0; i < std::min(Y.lignes, Y.colonnes); i++) Y[i][i] += a;
+}
+
+/* max des sommes de colonnes */
+inline double norme_1(const Matrice& A) {
+    std::vector<double> s(A.colonnes, 0);
+    for (int i = 0; i < A.lignes; i++) {
+        for (int j = 0; j < A.colonnes; j++) s[j] += fabs(A[i][j]);
+    }
+    return s.empty() ? 0 : *std::max_element(s.begin(), s.end());
+}
+
+/* C <- beta C, beta = 0 efface (pas de NaN * 0) */
+inline void gemm_echelle(int M, int N, double beta, double* C, size_t ldc) {
+    if (beta == 1) return;
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < M; i++) {
+        double* c = C + i * ldc;
+        if (beta == 0) std::fill(c, c + N, 0.0);
+        else for (int j = 0; j < N; j++) c[j] *= beta;
+    }
+}
+
+/* C <- alpha A B + beta C ; C ne doit recouvrir ni A ni B */
+inline void gemm_bloque(Matrice& C, const Matrice& A, const Matrice& B, double alpha = 1, double beta = 0) {
+    int M = A.lignes, K = A.colonnes, N = B.colonnes;
+    gemm_echelle(M, N, beta, C.v.data(), C.colonnes);
+    for (int jj = 0; jj < N; jj += GEMM_BJ) {
+        int je = std::min(N, jj + GEMM_BJ);
+        for (int kk = 0; kk < K; kk += GEMM_BK) {
+            int ke = std::min(K, kk + GEMM_BK);
+            for (int ii = 0; ii < M; ii += GEMM_BI) {
+                int ie = std::min(M, ii + GEMM_BI);
+                for (int i = ii; i < ie; i++) {
+                    double* c = C[i];
+                    for (int k = kk; k < ke; k++) {
+                        double a = alpha * A[i][k];
+                        const double* b = B[k];
+                        for (int j = jj; j < je; j++) c[j] += a * b[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* tailles de blocs, 0 : valeur de l'isa (MC et NC arrondis a MR et NR) */
+struct BlocsGemm {
+    int mc = 0, kc = 0, nc = 0;
+};
+
+namespace gemm_detail {
+
+#define GEMM_EN_LIGNE SIMD_EN_LIGNE
+
+/* tuile de registres MR x (NV L) et blocs par defaut pour L voies double */
+template <int L> struct Tuile;
+template <> struct Tuile<2> { static const int MR = 4, NV = 2, MC = 128, KC = 256, NC = 4096; };
+template <> struct Tuile<4> { static const int MR = 6, NV = 2, MC = 120, KC = 256, NC = 4096; };
+template <> struct Tuile<8> { static const int MR = 8, NV = 3, MC = 192, KC = 192, NC = 3072; };
+
+/*  C[mr x nr] += alpha a b, a : KC colonnes de MR valeurs, b : KC lignes
+    de NR valeurs ; tuile complete ecrite directement, bords par tampon */
+template <int L, int MR, int NV>
+GEMM_EN_LIGNE void micro_noyau(int kc, const double* a, const double* b, double* c, size_t ldc, double alpha,
+                               int mr, int nr) {
+    typedef typename Simd<double, L>::v V;
+    const int NR = NV * L;
+    V acc[MR][NV];
+    #pragma GCC unroll 8
+    for (int i = 0; i < MR; i++) {
+        #pragma GCC unroll 4
+        for (int v = 0; v < NV; v++) acc[i][v] = V();
+    }
+    for (int p = 0; p < kc; p++) {
+        V bv[NV];
+        #pragma GCC unroll 4
+        for (int v = 0; v < NV; v++) memcpy(&bv[v], b + p * NR + v * L, sizeof(V));
+        #pragma GCC unroll 8
+        for (int i = 0; i < MR; i++) {
+            V ai = a[p * MR + i] - V();     /* x - 0 se simplifie (0 + x non, a cause de -0) */
+            #pragma GCC unroll 4
+            for (int v = 0; v < NV; v++) acc[i][v] += ai * bv[v];
+        }
+    }
+    if (mr == MR && nr == NR) {
+        #pragma GCC unroll 8
+        for (int i = 0; i < MR; i++) {
+            #pragma GCC unroll 4
+            for (int v = 0; v < NV; v++) {
+                V cv;
+                memcpy(&cv, c + i * ldc + v * L, sizeof(V));
+                cv += alpha * acc[i][v];
+                memcpy(c + i * ldc + v * L, &cv, sizeof(V));
+            }
+        }
+    } else {
+        double t[MR][NR];
+        memcpy(t, acc, sizeof(t));
+        for (int i = 0; i < mr; i++) {
+            for (int j = 0; j < nr; j++) c[i * ldc + j] += alpha * t[i][j];
+        }
+    }
+}
+
+/* bloc mc x kc de A -> micro-panneaux MR x kc (colonne par colonne) */
+template <int MR>
+GEMM_EN_LIGNE void recopier_A(int mc, int kc, const double* A, size_t lda, double* Ap) {
+    for (int ir = 0; ir < mc; ir += MR) {
+        double* d = Ap + (size_t) ir * kc;
+        int mr = std::min(MR, mc - ir);
+        for (int i = 0; i < MR; i++) {
+            const double* a = A + (ir + i) * lda;
+            if (i < mr) for (int p = 0; p < kc; p++) d[p * MR + i] = a[p];
+            else for (int p = 0; p < kc; p++) d[p * MR + i] = 0;
+        }
+    }
+}
+
+/* micro-panneau kc x NR de B (ligne par ligne), colonnes jr .. jr + nr */
+template <int NR>
+GEMM_EN_LIGNE void recopier_B(int nr, int kc, const double* B, size_t ldb, double* d) {
+    for (int p = 0; p < kc; p++) {
+        const double* b = B + p * ldb;
+        int j = 0;
+        for (; j < nr; j++) d[p * NR + j] = b[j];
+        for (; j < NR; j++) d[p * NR + j] = 0;
+    }
+}
+
+struct Probleme {
+    int M, N, K;
+    double alpha;
+    const double* A;
+    size_t lda;
+    const double* B;
+    size_t ldb;
+    double* C;
+    size_t ldc;
+    BlocsGemm blocs;
+};
+
+/* part d'un thread, appelee dans la region parallele de gemm_packe */
+struct Part {
+    const Probleme* pb;
+    std::unique_ptr<double[]>* Bp;  /* partage */
+    std::unique_ptr<double[]>* Ap;  /* propre au thread */
+
+    template <int L> GEMM_EN_LIGNE void executer() const {
+        typedef Tuile<L> T;
+        const int MR = T::MR, NR = T::NV * L;
+        const Probleme& q = *pb;
+        int KC = q.blocs.kc > 0 ? q.blocs.kc : T::KC;
+        int MC = (q.blocs.mc > 0 ? q.blocs.mc : T::MC) / MR * MR;
+        int NC = (q.blocs.nc > 0 ? q.blocs.nc : T::NC) / NR * NR;
+        MC = std::max(MC, MR);
+        NC = std::max(NC, NR);
+        /* tampons a la taille du probleme, sans remise a zero (les bords
+           sont completes par les recopies) */
+        int kc_max = std::min(KC, q.K);
+        #pragma omp single
+        Bp->reset(new double[(size_t) kc_max * ((std::min(NC, q.N) + NR - 1) / NR * NR)]);
+        Ap->reset(new double[(size_t) ((std::min(MC, q.M) + MR - 1) / MR * MR) * kc_max]);
+        double* bp = Bp->get();
+        double* ap = Ap->get();
+        int nb_threads = omp_get_num_threads();
+
+        for (int jc = 0; jc < q.N; jc += NC) {
+            int nc = std::min(NC, q.N - jc);
+            int nb_jr = (nc + NR - 1) / NR;
+            for (int pc = 0; pc < q.K; pc += KC) {
+                int kc = std::min(KC, q.K - pc);
+                #pragma omp for schedule(static)
+                for (int r = 0; r < nb_jr; r++) {
+                    recopier_B<NR>(std::min(NR, nc - r * NR), kc, q.B + pc * q.ldb + jc + r * NR, q.ldb,
+                                   bp + (size_t) r * NR * kc);
+                }
+                /* unites (bloc ic, groupe de micro-panneaux) */
+                int nb_ic = (q.M + MC - 1) / MC;
+                int nb_g = std::min(nb_jr, std::max(1, (2 * nb_threads + nb_ic - 1) / nb_ic));
+                int ic_recopie = -1;
+                #pragma omp for schedule(dynamic)
+                for (int u = 0; u < nb_ic * nb_g; u++) {
+                    int ic = u / nb_g * MC, g = u % nb_g;
+                    int mc = std::min(MC, q.M - ic);
+                    if (ic != ic_recopie) {
+                        recopier_A<MR>(mc, kc, q.A + ic * q.lda + pc, q.lda, ap);
+                        ic_recopie = ic;
+                    }
+                    int r0 = (int) ((long) nb_jr * g / nb_g), r1 = (int) ((long) nb_jr * (g + 1) / nb_g);
+                    for (int r = r0; r < r1; r++) {
+                        int jr = r * NR;
+                        for (int ir = 0; ir < mc; ir += MR) {
+                            micro_noyau<L, MR, T::NV>(kc, ap + (size_t) ir * kc, bp + (size_t) r * NR * kc,
+                                                      q.C + (ic + ir) * q.ldc + jc + jr, q.ldc, q.alpha,
+                                                      std::min(MR, mc - ir), std::min(NR, nc - jr));
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+} // namespace gemm_detail
+
+/*  C (M x N, ldc) <- alpha A (M x K, lda) B (K x N, ldb) + beta C, sur les
+    threads OpenMP disponibles */
+inline void gemm_packe(int M, int N, int K, double alpha, const double* A, size_t lda, const double* B,
+                       size_t ldb, double beta, double* C, size_t ldc, Isa isa = ISA_AUTO,
+                       BlocsGemm blocs = BlocsGemm()) {
+    gemm_echelle(M, N, beta, C, ldc);
+    if (M == 0 || N == 0 || K == 0 || alpha == 0) return;
+    gemm_detail::Probleme pb = {M, N, K, alpha, A, lda, B, ldb, C, ldc, blocs};
+    std::unique_ptr<double[]> Bp;
+    #pragma omp parallel
+    {
+        std::unique_ptr<double[]> Ap;
+        gemm_detail::Part part = {&pb, &Bp, &Ap};
+        lancer_simd<double>(part, isa);
+    }
+}
+
+/*  petits produits (moins de GEMM_PETIT^3 fma) ou tres etroits (moins de
+    GEMM_ETROIT lignes ou colonnes) : la recopie et le lancement des threads
+    coutent plus que le calcul, gemm_bloque est plus rapide */
+#define GEMM_PETIT 64
+#define GEMM_ETROIT 4
+
+inline void gemm(Matrice& C, const Matrice& A, const Matrice& B, double alpha = 1, double beta = 0) {
+    int M = A.lignes, K = A.colonnes, N = B.colonnes;
+    if ((double) M * N * K < (double) GEMM_PETIT * GEMM_PETIT * GEMM_PETIT || std::min(M, N) < GEMM_ETROIT) {
+        gemm_bloque(C, A, B, alpha, beta);
+        return;
+    }
+    gemm_packe(A.lignes, B.colonnes, A.colonnes, alpha, A.v.data(), A.colonnes, B.v.data(), B.colonnes, beta,
+               C.v.data(), C.colonnes);
+}
+
+/* operations flottantes d'un produit (pour EvalPerf::cpi) */
+inline double flops_gemm(int M, int N, int K) {
+    return 2.0 * M * N * K;
+}
+
+#endif // GEMM_H
@@ -0,0 +1,444 @@
+#ifndef GRAPHE_H
+#define GRAPHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <random>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <omp.h>
+#include "SommePrefixe.hpp"
+
+/*  Noyau de graphe commun aux modules de graphes (HAI711I, HAI802I, HAI820I).
+
+    Stockage CSR : les voisins sortants de u sont voisins[debut[u] .. debut[u+1]),
+    identifiants de sommets sur 32 bits, decalages sur 64 bits, poids float
+    optionnels. La CSC (voisins entrants) s'obtient avec transposee().
+
+    Le graphe ne fait que pointer vers ses tableaux : ils sont soit possedes
+    (vecteurs stock_*), soit projetes en memoire depuis un fichier binaire
+    (charger_graphe) : le chargement ne lit que debut (verifie en O(n)), les
+    voisins ne sont lus qu'a l'usage. */
+
+typedef uint32_t sommet_t;
+
+struct Arete {
+    sommet_t u, v;
+    float poids;
+};
+
+struct Graphe {
+    uint32_t n = 0;
+    uint64_t m = 0; /* nombre d'arcs stockes */
+    const uint64_t* debut = nullptr;
+    const sommet_t* voisins = nullptr;
+    const float* poids = nullptr; /* nullptr si non pondere */
+
+    std::vector<uint64_t> stock_debut;
+    std::vector<sommet_t> stock_voisins;
+    std::vector<float> stock_poids;
+    void* carte = nullptr;
+    size_t taille_carte = 0;
+
+    Graphe() {}
+    Graphe(const Graphe&) = delete;
+    Graphe& operator=(const Graphe&) = delete;
+    Graphe(Graphe&& g) { echanger(g); }
+    Graphe& operator=(Graphe&& g) { echanger(g); return *this; }
+    ~Graphe() { if (carte) munmap(carte, taille_carte); }
+
+    void echanger(Graphe& g) {
+        std::swap(n, g.n);
+        std::swap(m, g.m);
+        std::swap(debut, g.debut);
+        std::swap(voisins, g.voisins);
+        std::swap(poids, g.poids);
+        stock_debut.swap(g.stock_debut);
+        stock_voisins.swap(g.stock_voisins);
+        stock_poids.swap(g.stock_poids);
+        std::swap(carte, g.carte);
+        std::swap(taille_carte, g.taille_carte);
+    }
+
+    /* fait pointer le graphe vers ses propres tableaux */
+    void adopter_stock() {
+        debut = stock_debut.data();
+        voisins = stock_voisins.data();
+        poids = stock_poids.empty() ? nullptr : stock_poids.data();
+    }
+
+    bool pondere() const { return poids != nullptr; }
+    uint64_t degre(sommet_t u) const { return debut[u + 1] - debut[u]; }
+    const sommet_t* debut_voisins(sommet_t u) const { return voisins + debut[u]; }
+    const sommet_t* fin_voisins(sommet_t u) const { return voisins + debut[u + 1]; }
+};
+
+struct OptionsConstruction {
+    bool symetriser = false;    /* ajoute l'arc v->u pour chaque arete u->v */
+    bool boucles = true;        /* conserve les arcs u->u */
+    bool trier = true;          /* voisins tries par identifiant */
+    bool dedoublonner = false;  /* supprime les arcs multiples (implique trier) */
+};
+
+
+namespace graphe_detail {
+
+/* trie la liste de voisins [deb, fin) (et les poids associes) par identifiant */
+inline void trier_voisins(sommet_t* v, float* w, uint64_t deb, uint64_t fin) {
+    if (w == nullptr) {
+        std::sort(v + deb, v + fin);
+        return;
+    }
+    static thread_local std::vector<std::pair<sommet_t, float>> tmp;
+    tmp.resize(fin - deb);
+    for (uint64_t k = deb; k < fin; k++) tmp[k - deb] = {v[k], w[k]};
+    std::sort(tmp.begin(), tmp.end(),
+              [](const std::pair<sommet_t, float>& a, const std::pair<sommet_t, float>& b) {
+                  return a.first < b.first;
+              });
+    for (uint64_t k = deb; k < fin; k++) {
+        v[k] = tmp[k - deb].first;
+        w[k] = tmp[k - deb].second;
+    }
+}
+
+/*  coeur du constructeur : tri comptage parallele d'une liste de nb arcs
+    donnes par arc(e, u, v, w). Degres comptes par increments atomiques,
+    somme prefixe parallele des degres, dispersion par curseurs atomiques
+    puis tri local de chaque liste (l'ordre de dispersion n'est pas
+    deterministe). */
+template <typename FonctionArc>
+Graphe construire(uint32_t n, uint64_t nb, bool pondere, const OptionsConstruction& opt,
+                  FonctionArc arc) {
+    Graphe g;
+    g.n = n;
+    g.stock_debut.assign((size_t) n + 1, 0);
+    uint64_t* deg = g.stock_debut.data();
+
+    #pragma omp parallel for schedule(static)
+    for (uint64_t e = 0; e < nb; e++) {
+        sommet_t u, v;
+        float w;
+        arc(e, u, v, w);
+        if (u == v && !opt.boucles) continue;
+        #pragma omp atomic
+        deg[u]++;
+        if (opt.symetriser && u != v) {
+            #pragma omp atomic
+            deg[v]++;
+        }
+    }
+    g.m = somme_prefixe_exclusive_parallele(deg, (size_t) n + 1);
+
+    g.stock_voisins.resize(g.m);
+    if (pondere) g.stock_poids.resize(g.m);
+    std::vector<uint64_t> curseur(deg, deg + n);
+    sommet_t* V = g.stock_voisins.data();
+    float* W = pondere ? g.stock_poids.data() : nullptr;
+
+    #pragma omp parallel for schedule(static)
+    for (uint64_t e = 0; e < nb; e++) {
+        sommet_t u, v;
+        float w;
+        arc(e, u, v, w);
+        if (u == v && !opt.boucles) continue;
+        uint64_t p;
+        #pragma omp atomic capture
+        p = curseur[u]++;
+        V[p] = v;
+        if (W) W[p] = w;
+        if (opt.symetriser && u != v) {
+            #pragma omp atomic capture
+            p = curseur[v]++;
+            V[p] = u;
+            if (W) W[p] = w;
+        }
+    }
+
+    if (opt.trier || opt.dedoublonner) {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (uint32_t u = 0; u < n; u++) {
+            trier_voisins(V, W, deg[u], deg[u + 1]);
+        }
+    }
+
+    if (opt.dedoublonner) {
+        /* nouveaux degres, puis compactage dans de nouveaux tableaux */
+        std::vector<uint64_t> nouveau((size_t) n + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (uint32_t u = 0; u < n; u++) {
+            uint64_t c = 0;
+            for (uint64_t k = deg[u]; k < deg[u + 1]; k++) {
+                if (k == deg[u] || V[k] != V[k - 1]) c++;
+            }
+            nouveau[u] = c;
+        }
+        uint64_t m2 = somme_prefixe_exclusive_parallele(nouveau.data(), (size_t) n + 1);
+        std::vector<sommet_t> V2(m2);
+        std::vector<float> W2(W ? m2 : 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (uint32_t u = 0; u < n; u++) {
+            uint64_t p = nouveau[u];
+            for (uint64_t k = deg[u]; k < deg[u + 1]; k++) {
+                if (k == deg[u] || V[k] != V[k - 1]) {
+                    V2[p] = V[k];
+                    if (W) W2[p] = W[k];
+                    p++;
+                }
+            }
+        }
+        g.m = m2;
+        g.stock_debut.swap(nouveau);
+        g.stock_voisins.swap(V2);
+        g.stock_poids.swap(W2);
+    }
+    g.adopter_stock();
+    return g;
+}
+
+} // namespace graphe_detail
+
+
+/* construit la CSR d'une liste d'aretes (poids ignores si !pondere) */
+inline Graphe construire_csr(uint32_t n, const std::vector<Arete>& aretes, bool pondere,
+                             const OptionsConstruction& opt = OptionsConstruction()) {
+    const Arete* A = aretes.data();
+    return graphe_detail::construire(n, aretes.size(), pondere, opt,
+        [A](uint64_t e, sommet_t& u, sommet_t& v, float& w) {
+            u = A[e].u;
+            v = A[e].v;
+            w = A[e].poids;
+        });
+}
+
+/*  generateur R-MAT (a, b, c, d) = (0.57, 0.19, 0.19, 0.05) : degres en loi
+    de puissance comme dans Graph500 ; poids uniformes dans [0, 1). Un flux
+    par bloc de GRAPHE_BLOC_RMAT aretes, graine (graine, numero du bloc) :
+    la liste ne depend pas du nombre de threads. */
+#ifndef GRAPHE_BLOC_RMAT
+#define GRAPHE_BLOC_RMAT (1 << 16)
+#endif
+
+inline std::vector<Arete> aretes_rmat(uint32_t n, uint64_t m, uint64_t graine) {
+    std::vector<Arete> aretes(m);
+    int echelle = 0;
+    while ((1u << echelle) < n) echelle++;
+    const uint64_t nb_blocs = (m + GRAPHE_BLOC_RMAT - 1) / GRAPHE_BLOC_RMAT;
+    #pragma omp parallel for schedule(static)
+    for (uint64_t k = 0; k < nb_blocs; k++) {
+        std::seed_seq germe{graine, k};
+        std::mt19937_64 gen(germe);
+        std::uniform_real_distribution<float> U(0.f, 1.f);
+        uint64_t fin = std::min(m, (k + 1) * GRAPHE_BLOC_RMAT);
+        for (uint64_t e = k * GRAPHE_BLOC_RMAT; e < fin; e++) {
+            sommet_t u = 0, v = 0;
+            for (int b = 0; b < echelle; b++) {
+                float r = U(gen);
+                u <<= 1;
+                v <<= 1;
+                if (r < 0.57f) {
+                } else if (r < 0.76f) {
+                    v |= 1;
+                } else if (r < 0.95f) {
+                    u |= 1;
+                } else {
+                    u |= 1;
+                    v |= 1;
+                }
+            }
+            aretes[e] = {u % n, v % n, U(gen)};
+        }
+    }
+    return aretes;
+}
+
+/* CSC de g, c'est-a-dire la CSR du graphe transpose (voisins entrants) */
+inline Graphe transposee(const Graphe& g) {
+    /* source de chaque arc : on la retrouve par recherche dans debut */
+    std::vector<sommet_t> source(g.m);
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (uint32_t u = 0; u < g.n; u++) {
+        for (uint64_t k = g.debut[u]; k < g.debut[u + 1]; k++) source[k] = u;
+    }
+    const sommet_t* S = source.data();
+    const sommet_t* V = g.voisins;
+    const float* W = g.poids;
+    OptionsConstruction opt;
+    return graphe_detail::construire(g.n, g.m, g.pondere(), opt,
+        [S, V, W](uint64_t e, sommet_t& u, sommet_t& v, float& w) {
+            u = V[e];
+            v = S[e];
+            w = W ? W[e] : 0.f;
+        });
+}
+
+
+/*  Renumerotation : rang[u] est le nouvel identifiant de u. */
+inline Graphe renumeroter(const Graphe& g, const std::vector<sommet_t>& rang) {
+    Graphe h;
+    h.n = g.n;
+    h.m = g.m;
+    h.stock_debut.assign((size_t) g.n + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (uint32_t u = 0; u < g.n; u++) h.stock_debut[rang[u]] = g.degre(u);
+    somme_prefixe_exclusive_parallele(h.stock_debut.data(), (size_t) g.n + 1);
+    h.stock_voisins.resize(g.m);
+    if (g.pondere()) h.stock_poids.resize(g.m);
+    sommet_t* V = h.stock_voisins.data();
+    float* W = g.pondere() ? h.stock_poids.data() : nullptr;
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (uint32_t u = 0; u < g.n; u++) {
+        uint64_t p = h.stock_debut[rang[u]];
+        for (uint64_t k = g.debut[u]; k < g.debut[u + 1]; k++, p++) {
+            V[p] = rang[g.voisins[k]];
+            if (W) W[p] = g.poids[k];
+        }
+        graphe_detail::trier_voisins(V, W, h.stock_debut[rang[u]], p);
+    }
+    h.adopter_stock();
+    return h;
+}
+
+/* ordre par degre decroissant (les sommets de fort degre en tete) */
+inline std::vector<sommet_t> ordre_degre(const Graphe& g) {
+    std::vector<sommet_t> ordre(g.n);
+    for (uint32_t u = 0; u < g.n; u++) ordre[u] = u;
+    std::stable_sort(ordre.begin(), ordre.end(),
+                     [&g](sommet_t a, sommet_t b) { return g.degre(a) > g.degre(b); });
+    std::vector<sommet_t> rang(g.n);
+    for (uint32_t i = 0; i < g.n; i++) rang[ordre[i]] = i;
+    return rang;
+}
+
+/*  ordre de Cuthill-McKee inverse : parcours en largeur depuis un sommet de
+    degre minimal de chaque composante, voisins enfiles par degre croissant,
+    puis inversion. Pertinent pour un graphe symetrique. */
+inline std::vector<sommet_t> ordre_bfs(const Graphe& g) {
+    std::vector<sommet_t> ordre;
+    ordre.reserve(g.n);
+    std::vector<uint8_t> vu(g.n, 0);
+    std::vector<sommet_t> par_degre(g.n), tampon;
+    for (uint32_t u = 0; u < g.n; u++) par_degre[u] = u;
+    std::stable_sort(par_degre.begin(), par_degre.end(),
+                     [&g](sommet_t a, sommet_t b) { return g.degre(a) < g.degre(b); });
+    for (sommet_t s : par_degre) {
+        if (vu[s]) continue;
+        vu[s] = 1;
+        size_t tete = ordre.size();
+        ordre.push_back(s);
+        while (tete < ordre.size()) {
+            sommet_t u = ordre[tete++];
+            tampon.clear();
+            for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+                if (!vu[*p]) {
+                    vu[*p] = 1;
+                    tampon.push_back(*p);
+                }
+            }
+            std::sort(tampon.begin(), tampon.end(),
+                      [&g](sommet_t a, sommet_t b) { return g.degre(a) < g.degre(b); });
+            ordre.insert(ordre.end(), tampon.begin(), tampon.end());
+        }
+    }
+    std::vector<sommet_t> rang(g.n);
+    for (uint32_t i = 0; i < g.n; i++) rang[ordre[i]] = g.n - 1 - i;
+    return rang;
+}
+
+
+/*  Format binaire (petit-boutiste) :
+        en-tete de 64 octets, puis debut[n+1], voisins[m], poids[m] (optionnel),
+        chaque tableau aligne sur 64 octets.
+    Le chargement projette le fichier et pointe dans la projection. */
+struct EnTeteGraphe {
+    char magie[8];
+    uint32_t version;
+    uint32_t drapeaux; /* bit 0 : pondere */
+    uint64_t n, m;
+    uint64_t pos_debut, pos_voisins, pos_poids;
+    uint64_t reserve;
+};
+
+static const char MAGIE_GRAPHE[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+static const uint32_t VERSION_GRAPHE = 1;
+
+inline uint64_t aligner_64(uint64_t x) { return (x + 63) & ~(uint64_t) 63; }
+
+inline bool sauvegarder_graphe(const Graphe& g, const char* chemin) {
+    EnTeteGraphe e;
+    memset(&e, 0, sizeof e);
+    memcpy(e.magie, MAGIE_GRAPHE, 8);
+    e.version = VERSION_GRAPHE;
+    e.drapeaux = g.pondere() ? 1 : 0;
+    e.n = g.n;
+    e.m = g.m;
+    e.pos_debut = aligner_64(sizeof e);
+    e.pos_voisins = aligner_64(e.pos_debut + (g.n + 1) * sizeof(uint64_t));
+    e.pos_poids = g.pondere() ? aligner_64(e.pos_voisins + g.m * sizeof(sommet_t)) : 0;
+
+    FILE* f = fopen(chemin, "wb");
+    if (!f) return false;
+    static const char zeros[64] = {0};
+    bool ok = fwrite(&e, sizeof e, 1, f) == 1;
+    auto ecrire = [&](uint64_t pos, const void* p, uint64_t taille) {
+        long ici = ftell(f);
+        if (ok && (uint64_t) ici < pos) ok = fwrite(zeros, 1, pos - ici, f) == pos - ici;
+        if (ok && taille) ok = fwrite(p, 1, taille, f) == taille;
+    };
+    ecrire(e.pos_debut, g.debut, (g.n + 1) * sizeof(uint64_t));
+    ecrire(e.pos_voisins, g.voisins, g.m * sizeof(sommet_t));
+    if (g.pondere()) ecrire(e.pos_poids, g.poids, g.m * sizeof(float));
+    return fclose(f) == 0 && ok;
+}
+
+/*  projette le fichier en memoire ; renvoie false si le fichier est invalide :
+    tailles hors du fichier, ou debut qui ne va pas de 0 a m en croissant
+    (un arc hors de voisins[0 .. m) sinon). Les identifiants de voisins ne
+    sont pas verifies. */
+inline bool charger_graphe(const char* chemin, Graphe& g) {
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(EnTeteGraphe)) {
+        close(fd);
+        return false;
+    }
+    void* carte = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (carte == MAP_FAILED) return false;
+
+    const EnTeteGraphe* e = (const EnTeteGraphe*) carte;
+    uint64_t taille = st.st_size;
+    bool pondere = e->drapeaux & 1;
+    bool ok = memcmp(e->magie, MAGIE_GRAPHE, 8) == 0 && e->version == VERSION_GRAPHE
+           && e->n < UINT32_MAX
+           && e->pos_debut + (e->n + 1) * sizeof(uint64_t) <= taille
+           && e->m <= taille / sizeof(sommet_t)
+           && e->pos_voisins + e->m * sizeof(sommet_t) <= taille
+           && (!pondere || e->pos_poids + e->m * sizeof(float) <= taille);
+    const uint64_t* debut = ok ? (const uint64_t*) ((const char*) carte + e->pos_debut) : nullptr;
+    if (ok) ok = debut[0] == 0 && debut[e->n] == e->m;
+    for (uint64_t u = 0; ok && u < e->n; u++) ok = debut[u] <= debut[u + 1];
+    if (!ok) {
+        munmap(carte, st.st_size);
+        return false;
+    }
+    Graphe h;
+    h.carte = carte;
+    h.taille_carte = st.st_size;
+    h.n = (uint32_t) e->n;
+    h.m = e->m;
+    h.debut = debut;
+    h.voisins = (const sommet_t*) ((const char*) carte + e->pos_voisins);
+    h.poids = pondere ? (const float*) ((const char*) carte + e->pos_poids) : nullptr;
+    g = std::move(h);
+    return true;
+}
+
+#endif // GRAPHE_H
@@ -0,0 +1,82 @@
+#ifndef HORNER_H
+#define HORNER_H
+
+/*  Evaluation de polynomes c[0] + c[1] x + ... + c[n-1] x^(n-1), la methode
+    de Horner de tp2_exo6.cpp generalisee : x de type T (scalaire ou vecteur
+    GCC vector_size, les operations se font par voie), coefficients de type
+    S (scalaire diffuse sur les voies, ou vecteur).
+
+        horner : n-1 multiplications-additions en chaine, latence
+                 (n-1) * lat(fma), une operation par cycle au mieux
+        estrin : (c0 + c1 x) + x^2 (c2 + c3 x) + x^4 (...) ; arbre de
+                 profondeur ~log2(n), quelques multiplications de plus
+                 (puissances x^2, x^4, ...) mais plusieurs fma en parallele
+
+    Les versions Horner<N> / Estrin<N> a nombre de coefficients connu a la
+    compilation sont entierement deroulees ; horner(r, c, x) et
+    estrin(r, c, x) sur un tableau c[N] les choisissent ; horner(r, c, n, x)
+    prend n a l'execution. Resultat dans r, vecteurs par reference
+    (Simd.hpp) ; horner(c, n, x) rend la valeur, pour les scalaires. Avec
+    -mfma (ou un attribut target "fma"), a * x + b est contracte en fma par
+    le compilateur. */
+
+#define HORNER_EN_LIGNE __attribute__((always_inline)) inline
+
+template <class T, class S>
+HORNER_EN_LIGNE void horner(T& r, const S* c, int n, const T& x) {
+    r = T() + c[n - 1];
+    for (int i = n - 2; i >= 0; i--) r = r * x + c[i];
+}
+
+template <class T, class S>
+inline T horner(const S* c, int n, T x) {
+    T r;
+    horner(r, c, n, x);
+    return r;
+}
+
+template <int N> struct Horner {
+    template <class T, class S> static HORNER_EN_LIGNE void f(T& r, const S* c, const T& x) {
+        Horner<N - 1>::f(r, c + 1, x);
+        r = r * x + c[0];
+    }
+};
+template <> struct Horner<1> {
+    template <class T, class S> static HORNER_EN_LIGNE void f(T& r, const S* c, const T&) { r = T() + c[0]; }
+};
+
+namespace horner_detail {
+
+/* plus grande puissance de 2 strictement inferieure a n (n >= 2), et son log */
+constexpr int moitie(int n) { return n <= 2 ? 1 : 2 * moitie((n + 1) / 2); }
+constexpr int log2_entier(int n) { return n <= 1 ? 0 : 1 + log2_entier(n / 2); }
+
+/* p[k] = x^(2^k) */
+template <int N> struct EstrinRec {
+    static const int H = moitie(N);
+    template <class T, class S> static HORNER_EN_LIGNE void f(T& r, const S* c, const T* p) {
+        T h;
+        EstrinRec<H>::f(r, c, p);
+        EstrinRec<N - H>::f(h, c + H, p);
+        r = r + p[log2_entier(H)] * h;
+    }
+};
+template <> struct EstrinRec<1> {
+    template <class T, class S> static HORNER_EN_LIGNE void f(T& r, const S* c, const T*) { r = T() + c[0]; }
+};
+
+} // namespace horner_detail
+
+template <int N> struct Estrin {
+    template <class T, class S> static HORNER_EN_LIGNE void f(T& r, const S* c, const T& x) {
+        T p[horner_detail::log2_entier(N) + 1];
+        p[0] = x;
+        for (int k = 1; k <= horner_detail::log2_entier(N); k++) p[k] = p[k - 1] * p[k - 1];
+        horner_detail::EstrinRec<N>::f(r, c, p);
+    }
+};
+
+template <class T, class S, int N> HORNER_EN_LIGNE void horner(T& r, const S (&c)[N], const T& x) { Horner<N>::f(r, c, x); }
+template <class T, class S, int N> HORNER_EN_LIGNE void estrin(T& r, const S (&c)[N], const T& x) { Estrin<N>::f(r, c, x); }
+
+#endif // HORNER_H
@@ -0,0 +1,276 @@
+#ifndef MODELE_PORTS_H
+#define MODELE_PORTS_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+/*  Modele analytique de debit (cf. consignes.pdf, exercices 2 et 3) :
+    on decrit le corps de boucle d'un noyau par ses operations et leurs
+    dependances, la machine par ses ports, latences et debits, et on en
+    deduit un minorant du nombre de cycles par element :
+
+        ports    : repartition optimale des micro-operations sur les ports
+                   (max sur les ensembles S de ports de charge(S) / |S|,
+                   ou charge(S) ne compte que les operations confinees a S)
+        emission : micro-operations / largeur d'emission
+        latence  : plus long cycle de dependances entre iterations
+                   (une iteration ne peut pas commencer sa chaine avant la
+                   fin de celle de l'iteration precedente)
+
+    L'ILP est le nombre d'operations divise par la profondeur du graphe de
+    dependances d'une iteration, comme dans les exercices. Les cycles
+    rdtsc d'EvalPerf sont des cycles de reference : a frequence turbo
+    differente, l'ecart mesure/predit en tient compte. */
+
+enum ClasseOp {
+    OP_FADD, OP_FMUL, OP_FMA, OP_FDIV, OP_LOAD, OP_STORE, OP_ALU, OP_IMUL, OP_SHUFFLE,
+    NB_CLASSES
+};
+
+static const char* const NOMS_CLASSES[NB_CLASSES] = {
+    "fadd", "fmul", "fma", "fdiv", "load", "store", "alu", "imul", "shuffle"
+};
+
+struct Machine {
+    std::string nom;
+    int largeur_emission = 4;
+    int nb_ports = 8;
+    int latence[NB_CLASSES];
+    uint32_t ports[NB_CLASSES];      /* masque des ports capables d'executer la classe */
+    double occupation[NB_CLASSES];   /* cycles pendant lesquels le port est occupe */
+};
+
+/*  Haswell, d'apres le tableau de consignes.pdf : fma/mul sur les ports 0 et
+    1 (latence 5), add sur le port 1 (latence 3), div sur le port 0 (latence
+    14-20, une tous les 13 cycles), chargements sur 2 et 3, ecriture sur 4
+    (l'adresse, sur 2, 3 ou 7, n'est pas modelisee), ALU entiere sur 0, 1,
+    5 et 6, shuffle sur 5. */
+inline Machine machine_haswell() {
+    Machine m;
+    m.nom = "Haswell";
+    m.largeur_emission = 4;
+    m.nb_ports = 8;
+    int lat[NB_CLASSES] = {3, 5, 5, 14, 4, 1, 1, 3, 1};
+    uint32_t p[NB_CLASSES] = {0x02, 0x03, 0x03, 0x01, 0x0c, 0x10, 0x63, 0x02, 0x20};
+    double occ[NB_CLASSES] = {1, 1, 1, 13, 1, 1, 1, 1, 1};
+    for (int c = 0; c < NB_CLASSES; c++) {
+        m.latence[c] = lat[c];
+        m.ports[c] = p[c];
+        m.occupation[c] = occ[c];
+    }
+    return m;
+}
+
+/*  Skylake-SP vu en 512 bits : les unites 256 bits des ports 0 et 1 sont
+    fusionnees, le port 5 porte la seconde unite fma ; latence fp 4. Les
+    operations scalaires ou 256 bits se modelisent avec machine_haswell(). */
+inline Machine machine_skylake_avx512() {
+    Machine m = machine_haswell();
+    m.nom = "Skylake-SP 512 bits";
+    int lat[NB_CLASSES] = {4, 4, 4, 16, 5, 1, 1, 3, 1};
+    uint32_t p[NB_CLASSES] = {0x21, 0x21, 0x21, 0x01, 0x0c, 0x10, 0x63, 0x02, 0x20};
+    double occ[NB_CLASSES] = {1, 1, 1, 16, 1, 1, 1, 1, 1};
+    for (int c = 0; c < NB_CLASSES; c++) {
+        m.latence[c] = lat[c];
+        m.ports[c] = p[c];
+        m.occupation[c] = occ[c];
+    }
+    return m;
+}
+
+/*  processeur de l'exercice 2 : deux multiplications par cycle (ports 1 et
+    2), une addition par cycle (port 1) ; avec variante = true, question 3 :
+    deux additions (ports 1 et 2) et une multiplication (port 1). Les
+    latences valent 1 : seul l'ordonnancement compte dans l'exercice. */
+inline Machine machine_exercice2(bool variante = false) {
+    Machine m;
+    m.nom = variante ? "exercice 2, question 3" : "exercice 2";
+    m.largeur_emission = 2;
+    m.nb_ports = 2;
+    for (int c = 0; c < NB_CLASSES; c++) {
+        m.latence[c] = 1;
+        m.ports[c] = 0x3;
+        m.occupation[c] = 1;
+    }
+    m.ports[OP_FADD] = variante ? 0x3 : 0x1;
+    m.ports[OP_FMUL] = variante ? 0x1 : 0x3;
+    m.ports[OP_FDIV] = 0x1;
+    return m;
+}
+
+
+struct Operation {
+    ClasseOp classe;
+    std::vector<int> deps;      /* operations de la meme iteration */
+    std::vector<int> deps_prec; /* operations de l'iteration precedente */
+    int largeur = 1;            /* micro-operations (ex. 2 pour un 512 bits decoupe) */
+};
+
+struct Noyau {
+    std::string nom;
+    std::vector<Operation> ops;
+    double elements_par_iteration = 1;
+
+    explicit Noyau(const std::string& n = "", double elements = 1)
+        : nom(n), elements_par_iteration(elements) {}
+
+    /* ajoute une operation, renvoie son indice pour servir de dependance */
+    int op(ClasseOp c, std::vector<int> deps = {}, std::vector<int> deps_prec = {}) {
+        Operation o;
+        o.classe = c;
+        o.deps = deps;
+        o.deps_prec = deps_prec;
+        ops.push_back(o);
+        return (int) ops.size() - 1;
+    }
+
+    /* gestion de boucle : increment, comparaison + saut (fusionnes) */
+    void gestion_boucle() {
+        int i = op(OP_ALU, {}, {});
+        ops[i].deps_prec.push_back(i);
+        op(OP_ALU, {i});
+    }
+};
+
+/*  noyau de l'exercice 3, z[i] = z[i] + u[i] * u[i] + x[i] * y[i] * z[i] :
+    une op par vecteur de largeur doubles, chaines independantes deroulees,
+    gestion de boucle une fois par tour. Association (z + u*u) + (x*y)*z de
+    l'exercice ; avec fma, u*u + z et (x*y)*z + ... s'ecrivent en deux fma ;
+    factorise : z (1 + x*y) + u*u. */
+inline Noyau modele_exo3(const std::string& nom, int largeur, int chaines, bool fma, bool factorise = false) {
+    Noyau k(nom, (double) largeur * chaines);
+    for (int j = 0; j < chaines; j++) {
+        int lz = k.op(OP_LOAD), lu = k.op(OP_LOAD), lx = k.op(OP_LOAD), ly = k.op(OP_LOAD);
+        int xy = k.op(OP_FMUL, {lx, ly});
+        int r;
+        if (factorise) {
+            int s = k.op(OP_FADD, {xy});
+            int zs = k.op(OP_FMUL, {lz, s});
+            int uu = k.op(OP_FMUL, {lu});
+            r = k.op(OP_FADD, {zs, uu});
+        } else if (fma) {
+            int t = k.op(OP_FMA, {lu, lz});
+            r = k.op(OP_FMA, {xy, lz, t});
+        } else {
+            int uu = k.op(OP_FMUL, {lu});
+            int xyz = k.op(OP_FMUL, {xy, lz});
+            int t = k.op(OP_FADD, {lz, uu});
+            r = k.op(OP_FADD, {t, xyz});
+        }
+        k.op(OP_STORE, {r});
+    }
+    k.gestion_boucle();
+    return k;
+}
+
+struct Prediction {
+    double cycles_ports = 0, cycles_emission = 0, cycles_latence = 0;
+    double cycles_par_iteration = 0, cycles_par_element = 0;
+    double ilp = 0, ipc = 0, profondeur = 0;
+    double duree_isolee = 0;    /* chemin critique d'une iteration seule, en cycles */
+    double uops = 0;
+    uint32_t ports_goulot = 0;
+    const char* limite = "";
+};
+
+namespace modele_detail {
+
+/* fin au plus tot de chaque operation dans une iteration (graphe acyclique,
+   operations ajoutees dans un ordre topologique) */
+inline std::vector<double> fins_au_plus_tot(const Noyau& k, const Machine& m, int source) {
+    std::vector<double> fin(k.ops.size(), -1);
+    for (size_t i = 0; i < k.ops.size(); i++) {
+        double debut = -1;
+        if ((int) i == source) debut = 0;
+        for (int d : k.ops[i].deps) {
+            if (fin[d] >= 0) debut = std::max(debut, fin[d]);
+        }
+        if (source < 0 && debut < 0) debut = 0;
+        if (debut >= 0) fin[i] = debut + m.latence[k.ops[i].classe];
+    }
+    return fin;
+}
+
+} // namespace modele_detail
+
+inline Prediction predire(const Noyau& k, const Machine& m) {
+    Prediction p;
+    /* charge par classe */
+    double charge[NB_CLASSES] = {0};
+    for (const Operation& o : k.ops) {
+        charge[o.classe] += o.largeur * m.occupation[o.classe];
+        p.uops += o.largeur;
+    }
+    /* ports : pire sous-ensemble de ports */
+    for (uint32_t S = 1; S < (1u << m.nb_ports); S++) {
+        double c = 0;
+        for (int cl = 0; cl < NB_CLASSES; cl++) {
+            if (charge[cl] > 0 && (m.ports[cl] & ~S) == 0) c += charge[cl];
+        }
+        double t = c / __builtin_popcount(S);
+        if (t > p.cycles_ports + 1e-12) {
+            p.cycles_ports = t;
+            p.ports_goulot = S;
+        }
+    }
+    p.cycles_emission = p.uops / m.largeur_emission;
+
+    /* profondeur d'une iteration et ILP */
+    std::vector<double> fin = modele_detail::fins_au_plus_tot(k, m, -1);
+    for (double f : fin) p.duree_isolee = std::max(p.duree_isolee, f);
+    std::vector<double> etapes(k.ops.size(), 1);
+    for (size_t i = 0; i < k.ops.size(); i++) {
+        for (int d : k.ops[i].deps) etapes[i] = std::max(etapes[i], etapes[d] + 1);
+        p.profondeur = std::max(p.profondeur, etapes[i]);
+    }
+    p.ilp = p.profondeur > 0 ? k.ops.size() / p.profondeur : 0;
+
+    /*  recurrence : pour chaque dependance b (iteration i+1) -> a (iteration i),
+        le cycle a -> b -> ... -> a coute lat(a) + chemin le plus long de b a a */
+    for (size_t b = 0; b < k.ops.size(); b++) {
+        for (int a : k.ops[b].deps_prec) {
+            std::vector<double> f = modele_detail::fins_au_plus_tot(k, m, (int) b);
+            if (f[a] >= 0) p.cycles_latence = std::max(p.cycles_latence, f[a]);
+        }
+    }
+
+    p.cycles_par_iteration = std::max(p.cycles_ports, std::max(p.cycles_emission, p.cycles_latence));
+    if (p.cycles_par_iteration == p.cycles_latence) p.limite = "latence";
+    else if (p.cycles_par_iteration == p.cycles_ports) p.limite = "ports";
+    else p.limite = "emission";
+    p.cycles_par_element = p.cycles_par_iteration / k.elements_par_iteration;
+    p.ipc = p.cycles_par_iteration > 0 ? p.uops / p.cycles_par_iteration : 0;
+    return p;
+}
+
+inline std::string ports_en_texte(uint32_t S) {
+    std::string s;
+    for (int i = 0; i < 32; i++) {
+        if (S >> i & 1) s += (s.empty() ? "p" : ",p") + std::to_string(i);
+    }
+    return s;
+}
+
+/*  affiche la prediction a cote de la mesure (cycles par element) ; un
+    ecart superieur a seuil_ecart signale un noyau a optimiser */
+inline void afficher_prediction(std::ostream& os, const Noyau& k, const Machine& m,
+                                double mesure_par_element, double seuil_ecart = 2.0) {
+    Prediction p = predire(k, m);
+    os << k.nom << " [" << m.nom << "]\n";
+    os << "    ILP:" << p.ilp << " profondeur:" << p.profondeur << " uops/iter:" << p.uops
+       << " chemin critique:" << p.duree_isolee << " cycles\n";
+    os << "    cycles/iter ports:" << p.cycles_ports << " (" << ports_en_texte(p.ports_goulot) << ")"
+       << " emission:" << p.cycles_emission << " latence:" << p.cycles_latence
+       << " -> limite par " << p.limite << "\n";
+    os << "    predit cycles/elem:" << p.cycles_par_element << " IPC predit:" << p.ipc << "\n";
+    if (mesure_par_element > 0) {
+        double ecart = mesure_par_element / p.cycles_par_element;
+        os << "    mesure cycles/elem:" << mesure_par_element << " mesure/predit:" << ecart
+           << (ecart > seuil_ecart ? "  <-- a optimiser" : "") << "\n";
+    }
+}
+
+#endif // MODELE_PORTS_H
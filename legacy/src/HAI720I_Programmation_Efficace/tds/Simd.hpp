@@ -0,0 +1,86 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstdint>
+
+/*  Outils communs aux noyaux vectorises ecrits avec les vecteurs GCC
+    (vector_size) : une meme fonction modele est compilee pour sse2, avx2 +
+    fma et avx512f par attribut target, et la version est choisie a
+    l'execution selon le processeur.
+
+        Simd<S, L>::v / vi / vu     L voies de S, entiers signes / non signes
+                                    de meme taille (masques de comparaison) ;
+                                    S flottant ou entier 32 / 64 bits
+        isa_disponible()            meilleur jeu d'instructions utilisable
+        isa_effective(isa)          ISA_AUTO ou trop ambitieux -> disponible
+        lancer_simd<S>(e, isa)      e.executer<L>() dans la version de l'isa
+
+    Les fonctions auxiliaires appelees depuis executer<L>() n'ont pas
+    d'attribut target : un vecteur de 32 ou 64 octets passe ou rendu par
+    valeur y change d'ABI (-Wpsabi), meme mises en ligne. Elles prennent
+    donc leurs vecteurs par reference et rendent leur resultat par un
+    argument reference. Les builtins avx2 et avx512 sont isoles dans des
+    surcharges propres a une isa (SIMD_EN_LIGNE_AVX2, SIMD_EN_LIGNE_AVX512),
+    sans always_inline (refuse vers une fonction sans l'attribut) : le
+    compilateur les met en ligne une fois le noyau generique place dans la
+    version de l'isa. */
+
+#define SIMD_EN_LIGNE __attribute__((always_inline)) inline
+#define SIMD_EN_LIGNE_AVX2 __attribute__((target("avx2"))) inline
+#define SIMD_EN_LIGNE_AVX512 __attribute__((target("avx512f"))) inline
+#define SIMD_CIBLE_SSE2 __attribute__((noinline))
+#define SIMD_CIBLE_AVX2 __attribute__((noinline, target("avx2,fma")))
+#define SIMD_CIBLE_AVX512 __attribute__((noinline, target("avx512f")))
+
+enum Isa { ISA_AUTO, ISA_SSE2, ISA_AVX2, ISA_AVX512 };
+
+static const char* const NOMS_ISA[4] = {"auto", "sse2", "avx2", "avx512"};
+
+template <class S> struct EntierDe;
+template <> struct EntierDe<double> { typedef int64_t type; typedef uint64_t non_signe; };
+template <> struct EntierDe<float> { typedef int32_t type; typedef uint32_t non_signe; };
+template <> struct EntierDe<int64_t> { typedef int64_t type; typedef uint64_t non_signe; };
+template <> struct EntierDe<int32_t> { typedef int32_t type; typedef uint32_t non_signe; };
+
+template <class S, int L> struct Simd {
+    typedef S v __attribute__((vector_size(sizeof(S) * L)));
+    typedef typename EntierDe<S>::type vi __attribute__((vector_size(sizeof(S) * L)));
+    typedef typename EntierDe<S>::non_signe vu __attribute__((vector_size(sizeof(S) * L)));
+};
+
+/* nombre de voies de S dans un registre de l'isa */
+template <class S> constexpr int voies(Isa isa) {
+    return (isa == ISA_AVX512 ? 64 : isa == ISA_AVX2 ? 32 : 16) / (int) sizeof(S);
+}
+
+inline Isa isa_disponible() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return ISA_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return ISA_AVX2;
+    return ISA_SSE2;
+}
+
+inline Isa isa_effective(Isa isa) {
+    static const Isa meilleure = isa_disponible();
+    return isa == ISA_AUTO || isa > meilleure ? meilleure : isa;
+}
+
+namespace simd_detail {
+
+template <class S, class E> SIMD_CIBLE_SSE2 void lancer_sse2(const E& e) { e.template executer<voies<S>(ISA_SSE2)>(); }
+template <class S, class E> SIMD_CIBLE_AVX2 void lancer_avx2(const E& e) { e.template executer<voies<S>(ISA_AVX2)>(); }
+template <class S, class E> SIMD_CIBLE_AVX512 void lancer_avx512(const E& e) { e.template executer<voies<S>(ISA_AVX512)>(); }
+
+} // namespace simd_detail
+
+/*  noyau generique : E::executer<L>() (SIMD_EN_LIGNE) est compile dans la
+    fonction cible de l'isa, qui fixe L = voies<S>(isa) */
+template <class S, class E>
+inline void lancer_simd(const E& e, Isa isa) {
+    isa = isa_effective(isa);
+    if (isa == ISA_AVX512) simd_detail::lancer_avx512<S>(e);
+    else if (isa == ISA_AVX2) simd_detail::lancer_avx2<S>(e);
+    else simd_detail::lancer_sse2<S>(e);
+}
+
+#endif // SIMD_H
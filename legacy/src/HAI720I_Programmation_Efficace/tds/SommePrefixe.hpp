@@ -0,0 +1,67 @@
+#ifndef SOMME_PREFIXE_H
+#define SOMME_PREFIXE_H
+
+#include <cstddef>
+#include <vector>
+#include <omp.h>
+
+/*  Sommes prefixes partagees par les modules qui en ont besoin
+    (construction CSR, tri par base, histogrammes, ...).
+    somme_prefixe_inclusive est la boucle de ma_fonction de tp2_exo5.cpp,
+    generalisee a tout type. */
+
+template <typename T>
+void somme_prefixe_inclusive(T* B, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        B[i] = B[i] + B[i-1];
+    }
+}
+
+/* B[i] <- B[0] + ... + B[i-1], renvoie le total */
+template <typename T>
+T somme_prefixe_exclusive(T* B, size_t n) {
+    T acc = 0;
+    for (size_t i = 0; i < n; i++) {
+        T x = B[i];
+        B[i] = acc;
+        acc += x;
+    }
+    return acc;
+}
+
+/*  version exclusive multi-thread en deux passes : chaque thread somme son
+    bloc, on fait la somme prefixe des totaux de blocs, puis chaque thread
+    reprend son bloc avec son decalage. Renvoie le total. */
+template <typename T>
+T somme_prefixe_exclusive_parallele(T* B, size_t n) {
+    int nb_threads = omp_get_max_threads();
+    if (n < (size_t) 1 << 16 || nb_threads == 1) {
+        return somme_prefixe_exclusive(B, n);
+    }
+    std::vector<T> totaux(nb_threads + 1, 0);
+    int nb_effectif = 1;
+    #pragma omp parallel num_threads(nb_threads)
+    {
+        int t = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+        size_t deb = n * t / nt, fin = n * (t + 1) / nt;
+        T s = 0;
+        for (size_t i = deb; i < fin; i++) s += B[i];
+        totaux[t + 1] = s;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            nb_effectif = nt;
+            somme_prefixe_inclusive(totaux.data(), nt + 1);
+        }
+        T acc = totaux[t];
+        for (size_t i = deb; i < fin; i++) {
+            T x = B[i];
+            B[i] = acc;
+            acc += x;
+        }
+    }
+    return totaux[nb_effectif];
+}
+
+#endif // SOMME_PREFIXE_H
@@ -0,0 +1,251 @@
+#ifndef BRANCH_BOUND_H
+#define BRANCH_BOUND_H
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <omp.h>
+
+/*  Cadre generique de separation et evaluation (branch-and-bound) en
+    maximisation, parallelise par vol de travail.
+
+    Un probleme P fournit :
+        typedef ... Noeud;
+        Noeud racine() const;
+        double borne(const Noeud&) const;              majorant de tout descendant
+        bool feuille(const Noeud&, double& v) const;   solution complete de valeur v
+        void brancher(const Noeud&, std::vector<Noeud>&) const;
+    Les enfants sont explores dans l'ordre ou brancher() les produit.
+    Un probleme de minimisation renvoie l'oppose de son cout.
+
+    Deux modes :
+        VOL_DE_TRAVAIL : une deque par thread ; le proprietaire depile en
+            profondeur par la fin, les voleurs prennent la moitie des noeuds
+            les plus anciens (les plus proches de la racine) d'une victime
+            tiree au hasard et elaguent ce qu'ils volent avec la meilleure
+            valeur courante, partagee et mise a jour atomiquement.
+        DETERMINISTE : exploration par lots synchrones ; chaque lot est
+            traite en parallele avec la meilleure valeur figee au debut du
+            lot, puis les resultats sont fusionnes dans l'ordre du lot.
+            Noeuds explores et solution ne dependent pas du nombre de
+            threads : un parcours se rejoue a l'identique. */
+
+enum ModeRecherche { VOL_DE_TRAVAIL = 0, DETERMINISTE = 1 };
+
+struct StatsBranchBound {
+    uint64_t noeuds_explores = 0;   /* noeuds dont on a evalue la borne */
+    uint64_t noeuds_elagues = 0;    /* dont borne <= meilleure valeur */
+    uint64_t feuilles = 0;
+    uint64_t ameliorations = 0;
+    uint64_t vols_tentes = 0, vols_reussis = 0;
+    uint64_t noeuds_voles = 0, voles_elagues = 0;
+
+    void ajouter(const StatsBranchBound& s) {
+        noeuds_explores += s.noeuds_explores;
+        noeuds_elagues += s.noeuds_elagues;
+        feuilles += s.feuilles;
+        ameliorations += s.ameliorations;
+        vols_tentes += s.vols_tentes;
+        vols_reussis += s.vols_reussis;
+        noeuds_voles += s.noeuds_voles;
+        voles_elagues += s.voles_elagues;
+    }
+};
+
+template <typename P>
+class BranchBound {
+public:
+    typedef typename P::Noeud Noeud;
+
+    int nb_threads = omp_get_max_threads();
+    ModeRecherche mode = VOL_DE_TRAVAIL;
+    size_t taille_lot = 256;        /* mode DETERMINISTE */
+    StatsBranchBound stats;
+    std::vector<StatsBranchBound> stats_par_thread;
+
+    explicit BranchBound(const P& p) : probleme(p) {}
+
+    /* renvoie la meilleure valeur (-inf si aucune feuille) et sa solution */
+    double resoudre(Noeud& solution,
+                    double valeur_initiale = -std::numeric_limits<double>::infinity()) {
+        meilleure.store(valeur_initiale);
+        trouvee = false;
+        stats = StatsBranchBound();
+        stats_par_thread.assign(nb_threads, StatsBranchBound());
+        if (mode == DETERMINISTE) resoudre_deterministe();
+        else resoudre_vol_de_travail();
+        for (const StatsBranchBound& s : stats_par_thread) stats.ajouter(s);
+        if (trouvee) solution = meilleure_solution;
+        return meilleure.load();
+    }
+
+private:
+    const P& probleme;
+    std::atomic<double> meilleure;
+    std::mutex verrou_solution;
+    Noeud meilleure_solution;
+    bool trouvee = false;
+
+    struct alignas(64) Travailleur {
+        std::mutex verrou;
+        std::deque<Noeud> deque;
+    };
+    std::vector<Travailleur> travailleurs;
+    std::atomic<int64_t> en_attente;    /* noeuds crees et pas encore traites */
+
+    /* met a jour la meilleure valeur par CAS, puis la solution sous verrou */
+    void proposer(double v, const Noeud& x, StatsBranchBound& st) {
+        double courante = meilleure.load(std::memory_order_relaxed);
+        while (v > courante) {
+            if (meilleure.compare_exchange_weak(courante, v)) {
+                std::lock_guard<std::mutex> l(verrou_solution);
+                if (!trouvee || v >= meilleure.load()) {
+                    meilleure_solution = x;
+                    trouvee = true;
+                }
+                st.ameliorations++;
+                return;
+            }
+        }
+    }
+
+    /*  evalue un noeud : 0 si elague, 1 si feuille, 2 si des enfants ont ete
+        produits dans enfants */
+    int evaluer(const Noeud& x, double seuil, std::vector<Noeud>& enfants,
+                double& valeur, StatsBranchBound& st) {
+        st.noeuds_explores++;
+        if (probleme.borne(x) <= seuil) {
+            st.noeuds_elagues++;
+            return 0;
+        }
+        if (probleme.feuille(x, valeur)) {
+            st.feuilles++;
+            return 1;
+        }
+        enfants.clear();
+        probleme.brancher(x, enfants);
+        return 2;
+    }
+
+    void resoudre_vol_de_travail() {
+        std::vector<Travailleur> t(nb_threads);
+        travailleurs.swap(t);
+        travailleurs[0].deque.push_back(probleme.racine());
+        en_attente.store(1);
+        #pragma omp parallel num_threads(nb_threads)
+        travailler(omp_get_thread_num());
+        travailleurs.clear();
+    }
+
+    bool prendre_local(Travailleur& w, Noeud& x) {
+        std::lock_guard<std::mutex> l(w.verrou);
+        if (w.deque.empty()) return false;
+        x = std::move(w.deque.back());
+        w.deque.pop_back();
+        return true;
+    }
+
+    /* vole la moitie (au moins un) des noeuds les plus anciens d'une victime */
+    bool voler(int t, std::mt19937& gen, StatsBranchBound& st) {
+        int nt = (int) travailleurs.size();
+        if (nt < 2) return false;
+        int victime = (int) (gen() % (nt - 1));
+        if (victime >= t) victime++;
+        st.vols_tentes++;
+        std::vector<Noeud> butin;
+        {
+            Travailleur& v = travailleurs[victime];
+            std::unique_lock<std::mutex> l(v.verrou, std::try_to_lock);
+            if (!l.owns_lock() || v.deque.empty()) return false;
+            size_t k = (v.deque.size() + 1) / 2;
+            for (size_t i = 0; i < k; i++) {
+                butin.push_back(std::move(v.deque.front()));
+                v.deque.pop_front();
+            }
+        }
+        st.vols_reussis++;
+        st.noeuds_voles += butin.size();
+        /* elagage des noeuds voles avant de les garder */
+        double seuil = meilleure.load(std::memory_order_relaxed);
+        int64_t elagues = 0;
+        Travailleur& w = travailleurs[t];
+        std::lock_guard<std::mutex> l(w.verrou);
+        for (Noeud& x : butin) {
+            if (probleme.borne(x) <= seuil) elagues++;
+            else w.deque.push_back(std::move(x));
+        }
+        st.voles_elagues += elagues;
+        if (elagues) en_attente.fetch_sub(elagues);
+        return true;
+    }
+
+    void travailler(int t) {
+        StatsBranchBound& st = stats_par_thread[t];
+        Travailleur& w = travailleurs[t];
+        std::mt19937 gen(1234567 + t);
+        std::vector<Noeud> enfants;
+        Noeud x;
+        while (true) {
+            if (!prendre_local(w, x)) {
+                if (en_attente.load() == 0) break;
+                if (!voler(t, gen, st)) std::this_thread::yield();
+                continue;
+            }
+            double v;
+            int r = evaluer(x, meilleure.load(std::memory_order_relaxed), enfants, v, st);
+            if (r == 1) {
+                proposer(v, x, st);
+            } else if (r == 2 && !enfants.empty()) {
+                en_attente.fetch_add((int64_t) enfants.size());
+                std::lock_guard<std::mutex> l(w.verrou);
+                /* le premier enfant doit etre depile en premier */
+                for (size_t i = enfants.size(); i-- > 0;) w.deque.push_back(std::move(enfants[i]));
+            }
+            en_attente.fetch_sub(1);
+        }
+    }
+
+    void resoudre_deterministe() {
+        std::vector<Noeud> pile(1, probleme.racine()), lot;
+        std::vector<std::vector<Noeud>> enfants(taille_lot);
+        std::vector<int> resultat(taille_lot);
+        std::vector<double> valeurs(taille_lot);
+        while (!pile.empty()) {
+            /* le lot est le sommet de la pile, dans l'ordre de depilement */
+            size_t k = std::min(taille_lot, pile.size());
+            lot.clear();
+            for (size_t i = 0; i < k; i++) {
+                lot.push_back(std::move(pile.back()));
+                pile.pop_back();
+            }
+            double seuil = meilleure.load();
+            #pragma omp parallel for num_threads(nb_threads) schedule(dynamic, 1)
+            for (size_t i = 0; i < k; i++) {
+                resultat[i] = evaluer(lot[i], seuil, enfants[i], valeurs[i],
+                                      stats_par_thread[omp_get_thread_num()]);
+            }
+            /* fusion dans l'ordre du lot : le dernier empile est le premier du lot */
+            for (size_t i = k; i-- > 0;) {
+                if (resultat[i] == 2) {
+                    for (size_t j = enfants[i].size(); j-- > 0;) pile.push_back(std::move(enfants[i][j]));
+                }
+            }
+            for (size_t i = 0; i < k; i++) {
+                if (resultat[i] == 1 && valeurs[i] > meilleure.load()) {
+                    meilleure.store(valeurs[i]);
+                    meilleure_solution = lot[i];
+                    trouvee = true;
+                    stats_par_thread[0].ameliorations++;
+                }
+            }
+        }
+    }
+};
+
+#endif // BRANCH_BOUND_H
@@ -0,0 +1,229 @@
+/* separation et evaluation parallele : sac a dos et couverture par sommets
+   (HAI802I), nombre de noeuds et statistiques de vol */
+#include "../EvalPerf.hpp"
+#include "BranchBound.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+
+/*  sac a dos 0/1 : objets tries par rapport valeur/poids decroissant,
+    borne de Dantzig (relaxation fractionnaire), au plus 128 objets */
+struct SacADos {
+    std::vector<double> poids, valeur;
+    double capacite;
+
+    struct Noeud {
+        int niveau = 0;
+        double poids = 0, valeur = 0;
+        uint64_t pris[2] = {0, 0};
+    };
+
+    Noeud racine() const { return Noeud(); }
+
+    double borne(const Noeud& x) const {
+        if (x.poids > capacite) return -1;
+        double b = x.valeur, reste = capacite - x.poids;
+        for (size_t i = x.niveau; i < poids.size(); i++) {
+            if (poids[i] <= reste) {
+                reste -= poids[i];
+                b += valeur[i];
+            } else {
+                return b + valeur[i] * reste / poids[i];
+            }
+        }
+        return b;
+    }
+
+    bool feuille(const Noeud& x, double& v) const {
+        v = x.valeur;
+        return x.niveau == (int) poids.size();
+    }
+
+    void brancher(const Noeud& x, std::vector<Noeud>& enfants) const {
+        Noeud avec = x, sans = x;
+        avec.niveau = sans.niveau = x.niveau + 1;
+        avec.poids += poids[x.niveau];
+        avec.valeur += valeur[x.niveau];
+        avec.pris[x.niveau / 64] |= (uint64_t) 1 << (x.niveau % 64);
+        if (avec.poids <= capacite) enfants.push_back(avec);
+        enfants.push_back(sans);
+    }
+};
+
+/*  couverture par sommets minimum (arbre de recherche borne de HAI802I) sur
+    au plus 64 sommets : on branche sur le sommet v de plus fort degre restant,
+    soit v est dans la couverture, soit tous ses voisins le sont. Minorant :
+    taille courante + taille d'un couplage maximal glouton du reste. */
+struct CouvertureSommets {
+    int n;
+    std::vector<uint64_t> adj;
+
+    struct Noeud {
+        uint64_t restant = 0, couverture = 0;
+    };
+
+    Noeud racine() const {
+        Noeud x;
+        x.restant = n == 64 ? ~(uint64_t) 0 : (((uint64_t) 1 << n) - 1);
+        return x;
+    }
+
+    double borne(const Noeud& x) const {
+        uint64_t libres = x.restant;
+        int couplage = 0;
+        while (libres) {
+            int u = __builtin_ctzll(libres);
+            libres &= libres - 1;
+            uint64_t v = adj[u] & libres;
+            if (v) {
+                libres &= ~(v & (0 - v));
+                couplage++;
+            }
+        }
+        return -(double) (__builtin_popcountll(x.couverture) + couplage);
+    }
+
+    bool feuille(const Noeud& x, double& v) const {
+        v = -(double) __builtin_popcountll(x.couverture);
+        for (uint64_t r = x.restant; r; r &= r - 1) {
+            if (adj[__builtin_ctzll(r)] & x.restant) return false;
+        }
+        return true;
+    }
+
+    void brancher(const Noeud& x, std::vector<Noeud>& enfants) const {
+        int meilleur = -1, deg_max = 0;
+        for (uint64_t r = x.restant; r; r &= r - 1) {
+            int u = __builtin_ctzll(r);
+            int d = __builtin_popcountll(adj[u] & x.restant);
+            if (d > deg_max) {
+                deg_max = d;
+                meilleur = u;
+            }
+        }
+        uint64_t bit = (uint64_t) 1 << meilleur;
+        uint64_t voisins = adj[meilleur] & x.restant;
+        Noeud avec = x, sans = x;
+        avec.restant &= ~bit;
+        avec.couverture |= bit;
+        sans.restant &= ~(bit | voisins);
+        sans.couverture |= voisins;
+        enfants.push_back(avec);
+        enfants.push_back(sans);
+    }
+};
+
+double sac_a_dos_dynamique(const SacADos&);
+template <typename P> void mesurer(const char*, const P&, int, int, std::ofstream&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 6) {
+        printf("You must enter the following details:\nnb_items nb_vertices edge_percent number_of_loops output_file\n");
+        return -1;
+    }
+    int nb_objets = std::min(atoi(argv[1]), 128);
+    int nb_sommets = std::min(atoi(argv[2]), 64);
+    int densite = atoi(argv[3]);
+    int number_of_loops = atoi(argv[4]);
+    std::ofstream fichier {argv[5]};
+    srand(42);
+
+    /* objets fortement correles (difficiles pour la borne de Dantzig) */
+    SacADos sac;
+    std::vector<std::pair<double, double>> objets;
+    double total = 0;
+    for (int i = 0; i < nb_objets; i++) {
+        double p = 1 + rand() % 1000;
+        objets.push_back({p, p + 100});
+        total += p;
+    }
+    std::sort(objets.begin(), objets.end(), [](const std::pair<double, double>& a, const std::pair<double, double>& b) {
+        return a.second / a.first > b.second / b.first;
+    });
+    for (auto& o : objets) {
+        sac.poids.push_back(o.first);
+        sac.valeur.push_back(o.second);
+    }
+    sac.capacite = total / 2;
+    fichier << "sac a dos: " << nb_objets << " objets, optimum (programmation dynamique) "
+            << sac_a_dos_dynamique(sac) << "\n";
+    mesurer("sac a dos", sac, number_of_loops, 1, fichier);
+
+    CouvertureSommets cs;
+    cs.n = nb_sommets;
+    cs.adj.assign(nb_sommets, 0);
+    for (int u = 0; u < nb_sommets; u++) {
+        for (int v = u + 1; v < nb_sommets; v++) {
+            if (rand() % 100 < densite) {
+                cs.adj[u] |= (uint64_t) 1 << v;
+                cs.adj[v] |= (uint64_t) 1 << u;
+            }
+        }
+    }
+    fichier << "couverture par sommets: " << nb_sommets << " sommets, densite " << densite << "%\n";
+    mesurer("couverture", cs, number_of_loops, -1, fichier);
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* programmation dynamique sur les poids entiers, pour verification */
+double sac_a_dos_dynamique(const SacADos& s) {
+    int C = (int) s.capacite;
+    std::vector<double> best(C + 1, 0);
+    for (size_t i = 0; i < s.poids.size(); i++) {
+        int p = (int) s.poids[i];
+        for (int c = C; c >= p; c--) best[c] = std::max(best[c], best[c - p] + s.valeur[i]);
+    }
+    return best[C];
+}
+
+/*  chaque mode avec 1 thread puis tous les threads ; signe = -1 pour
+    afficher un cout de minimisation. Pour la couverture, l'ensemble
+    independant maximum est le complementaire. */
+template <typename P>
+void mesurer(const char* nom, const P& p, int number_of_loops, int signe, std::ofstream& fichier) {
+    EvalPerf PE;
+    const char* modes[2] = {"vol de travail", "deterministe"};
+    int threads[2] = {1, omp_get_max_threads()};
+    for (int m = 0; m < 2; m++) {
+        for (int t = 0; t < 2; t++) {
+            BranchBound<P> bb(p);
+            bb.mode = (ModeRecherche) m;
+            bb.nb_threads = threads[t];
+            typename P::Noeud sol;
+            double v = 0, nbc = 0, nbs = 0;
+            for (int k = 0; k < number_of_loops; k++) {
+                PE.start();
+                v = bb.resoudre(sol);
+                PE.stop();
+                PE.nb_c();
+                nbc += PE.nb_tot;
+                nbs += PE.nb_s();
+            }
+            const StatsBranchBound& s = bb.stats;
+            fichier << nom << " | " << modes[m] << " | " << threads[t] << " thread(s): valeur "
+                    << signe * v << "\n";
+            fichier << "    nbc:" << nbc / number_of_loops << "\n";
+            fichier << "    nbs:" << nbs / number_of_loops << "\n";
+            fichier << "    noeuds:" << s.noeuds_explores << " elagues:" << s.noeuds_elagues
+                    << " feuilles:" << s.feuilles << " ameliorations:" << s.ameliorations << "\n";
+            fichier << "    cycles/noeud:" << nbc / number_of_loops / s.noeuds_explores << "\n";
+            fichier << "    vols tentes:" << s.vols_tentes << " reussis:" << s.vols_reussis
+                    << " noeuds voles:" << s.noeuds_voles << " voles elagues:" << s.voles_elagues << "\n";
+        }
+    }
+}
+
+/*  commandes d'execution:
+    ./execs/tp_branch_bound 100 64 15 3 branch_bound_out.txt
+    OMP_NUM_THREADS=8 ./execs/tp_branch_bound 100 64 15 3 branch_bound_out_8t.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_branch_bound.cpp -o execs/tp_branch_bound
+*/
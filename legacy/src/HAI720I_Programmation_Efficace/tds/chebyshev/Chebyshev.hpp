@@ -0,0 +1,252 @@
+#ifndef CHEBYSHEV_H
+#define CHEBYSHEV_H
+
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <complex>
+#include "../Simd.hpp"
+
+/*  Series de Chebyshev sur un intervalle [a, b] :
+
+        f(x) ~ c0 T0(t) + c1 T1(t) + ... + c(n-1) T(n-1)(t),
+        t = (x - centre) * echelle dans [-1, 1]
+
+    evaluees par la recurrence de Clenshaw (l'equivalent de Horner pour la
+    base de Chebyshev) :
+
+        b(n) = b(n+1) = 0,  b(k) = 2t b(k+1) - b(k+2) + c(k),
+        f = t b(1) - b(2) + c(0)
+
+    ecrite b(k) = 2t b(k+1) + (c(k) - b(k+2)) : la soustraction ne depend
+    que de b(k+2), la chaine critique est une seule fma par coefficient,
+    comme Horner. Contrairement aux coefficients monomiaux, les c(k)
+    decroissent avec la regularite de f et |T(k)| <= 1 : l'erreur d'arrondi
+    reste de l'ordre de quelques ulp quel que soit le degre.
+
+        clenshaw(c, n, t)         n connu a l'execution, t scalaire ou vecteur
+        Clenshaw<N>::f(c, t)      n connu a la compilation, deroule
+        chebyshev_lot(serie, x, y, m)
+                                  y[i] = serie(x[i]) par vecteurs, plusieurs
+                                  recurrences entrelacees pour couvrir la
+                                  latence de la fma, version choisie a
+                                  l'execution (Simd.hpp)
+        ajuster_chebyshev(f, n, a, b)
+                                  coefficients d'interpolation aux n points
+                                  de Chebyshev par DCT-II, en O(n log n) si n
+                                  est une puissance de 2 (FFT), O(n^2) sinon ;
+                                  n <= 0 donne la serie vide, nulle partout */
+
+#define CHEB_EN_LIGNE SIMD_EN_LIGNE
+
+template <class T, class S>
+inline T clenshaw(const S* c, int n, T t) {
+    if (n <= 0) return T();
+    if (n == 1) return T() + c[0];
+    T t2 = t + t, b1 = T(), b2 = T();
+    for (int k = n - 1; k >= 1; k--) {
+        T b = t2 * b1 + (c[k] - b2);
+        b2 = b1;
+        b1 = b;
+    }
+    return t * b1 + (c[0] - b2);
+}
+
+namespace cheb_detail {
+
+template <int K> struct ClenshawRec {
+    template <class T, class S> static CHEB_EN_LIGNE T f(const S* c, T t, T t2, T b1, T b2) {
+        return ClenshawRec<K - 1>::f(c, t, t2, t2 * b1 + (c[K] - b2), b1);
+    }
+};
+template <> struct ClenshawRec<0> {
+    template <class T, class S> static CHEB_EN_LIGNE T f(const S* c, T t, T, T b1, T b2) {
+        return t * b1 + (c[0] - b2);
+    }
+};
+
+} // namespace cheb_detail
+
+template <int N> struct Clenshaw {
+    template <class T, class S> static CHEB_EN_LIGNE T f(const S* c, T t) {
+        return cheb_detail::ClenshawRec<N - 1>::f(c, t, t + t, T(), T());
+    }
+};
+template <> struct Clenshaw<1> {
+    template <class T, class S> static CHEB_EN_LIGNE T f(const S* c, T) { return T() + c[0]; }
+};
+
+template <class T, class S, int N> CHEB_EN_LIGNE T clenshaw(const S (&c)[N], T t) { return Clenshaw<N>::f(c, t); }
+
+
+template <class S>
+struct SerieChebyshev {
+    S a = -1, b = 1;
+    S centre = 0, echelle = 1;
+    std::vector<S> c;
+
+    SerieChebyshev() {}
+    SerieChebyshev(S a_, S b_, std::vector<S> c_)
+        : a(a_), b(b_), centre((a_ + b_) / 2), echelle(2 / (b_ - a_)), c(std::move(c_)) {}
+
+    template <class T> T vers_t(T x) const { return (x - centre) * echelle; }
+    S operator()(S x) const { return clenshaw(c.data(), (int) c.size(), vers_t(x)); }
+    int degre() const { return (int) c.size() - 1; }
+
+    /*  coefficients du meme polynome dans la base monomiale de t, calcules en
+        long double (T(k+1) = 2t T(k) - T(k-1)) ; ils croissent comme
+        (1 + sqrt(2))^k, d'ou la perte de precision de Horner en degre eleve */
+    std::vector<S> monomes_en_t() const {
+        int n = (int) c.size();
+        if (n == 0) return {};
+        std::vector<long double> p(n, 0), prec(n, 0), cour(n, 0), suiv(n, 0);
+        prec[0] = 1;
+        for (int i = 0; i < n; i++) p[i] += c[0] * prec[i];
+        if (n > 1) cour[1] = 1;
+        for (int k = 1; k < n; k++) {
+            if (k >= 2) {
+                for (int i = 0; i < n; i++) suiv[i] = (i ? 2 * cour[i - 1] : 0) - prec[i];
+                prec.swap(cour);
+                cour.swap(suiv);
+            }
+            for (int i = 0; i < n; i++) p[i] += c[k] * cour[i];
+        }
+        return std::vector<S>(p.begin(), p.end());
+    }
+};
+
+namespace cheb_detail {
+
+/* FFT complexe iterative en place, n puissance de 2 */
+inline void fft(std::vector<std::complex<double>>& v) {
+    size_t n = v.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(v[i], v[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        std::complex<double> w(std::cos(-2 * M_PI / len), std::sin(-2 * M_PI / len));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> wk(1, 0);
+            for (size_t k = 0; k < len / 2; k++) {
+                std::complex<double> u = v[i + k], t = wk * v[i + k + len / 2];
+                v[i + k] = u + t;
+                v[i + k + len / 2] = u - t;
+                wk *= w;
+            }
+        }
+    }
+}
+
+} // namespace cheb_detail
+
+/*  DCT-II non normalisee : X(j) = sum_k x(k) cos(pi j (2k + 1) / 2n).
+    Puissance de 2 : algorithme de Makhoul, les pairs dans l'ordre puis
+    les impairs a rebours, une FFT de taille n et une rotation de phase. */
+inline std::vector<double> dct2(const std::vector<double>& x, bool rapide = true) {
+    size_t n = x.size();
+    std::vector<double> X(n, 0);
+    if (rapide && n >= 2 && (n & (n - 1)) == 0) {
+        std::vector<std::complex<double>> v(n);
+        for (size_t k = 0; k < n / 2; k++) {
+            v[k] = x[2 * k];
+            v[n - 1 - k] = x[2 * k + 1];
+        }
+        cheb_detail::fft(v);
+        for (size_t j = 0; j < n; j++) {
+            double phi = -M_PI * j / (2.0 * n);
+            X[j] = (v[j] * std::complex<double>(std::cos(phi), std::sin(phi))).real();
+        }
+        return X;
+    }
+    for (size_t j = 0; j < n; j++) {
+        double s = 0;
+        for (size_t k = 0; k < n; k++) s += x[k] * std::cos(M_PI * j * (2 * k + 1) / (2.0 * n));
+        X[j] = s;
+    }
+    return X;
+}
+
+/*  interpolant de f aux n points de Chebyshev de premiere espece
+    x(k) = centre + cos(pi (k + 1/2) / n) / echelle :
+    c(j) = (2 / n) DCT-II(f)(j), c(0) divise par 2 */
+template <class S, class F>
+SerieChebyshev<S> ajuster_chebyshev(F f, int n, S a, S b, bool rapide = true) {
+    if (n <= 0) return SerieChebyshev<S>(a, b, {});
+    std::vector<double> fx(n);
+    double centre = ((double) a + b) / 2, demi = ((double) b - a) / 2;
+    for (int k = 0; k < n; k++) fx[k] = (double) f((S) (centre + demi * std::cos(M_PI * (k + 0.5) / n)));
+    std::vector<double> X = dct2(fx, rapide);
+    std::vector<S> c(n);
+    for (int j = 0; j < n; j++) c[j] = (S) (X[j] * 2 / n);
+    c[0] /= 2;
+    return SerieChebyshev<S>(a, b, c);
+}
+
+namespace cheb_detail {
+
+/*  P vecteurs a la fois : P recurrences independantes, P fma en vol par
+    coefficient (latence 4 cycles, 2 fma par cycle : 8 pour saturer). Chaque
+    recurrence garde t2, b1, b2 en registres : P = 4 avec les 16 registres
+    de sse2/avx2, P = 8 avec les 32 d'avx512. */
+template <class S, int L, int P>
+CHEB_EN_LIGNE void clenshaw_voies(const S* c, int n, S centre, S echelle, const S* x, S* y, size_t m) {
+    typedef typename Simd<S, L>::v V;
+    if (n <= 0) {
+        for (size_t i = 0; i < m; i++) y[i] = S();
+        return;
+    }
+    size_t i = 0;
+    for (; i + P * L <= m; i += P * L) {
+        V t[P], t2[P], b1[P], b2[P];
+        #pragma GCC unroll 8
+        for (int p = 0; p < P; p++) {
+            memcpy(&t[p], x + i + p * L, sizeof(V));
+            t[p] = (t[p] - centre) * echelle;
+            t2[p] = t[p] + t[p];
+            b1[p] = V();
+            b2[p] = V();
+        }
+        for (int k = n - 1; k >= 1; k--) {
+            #pragma GCC unroll 8
+            for (int p = 0; p < P; p++) {
+                V b = t2[p] * b1[p] + (c[k] - b2[p]);
+                b2[p] = b1[p];
+                b1[p] = b;
+            }
+        }
+        #pragma GCC unroll 8
+        for (int p = 0; p < P; p++) {
+            V r = t[p] * b1[p] + (c[0] - b2[p]);
+            memcpy(y + i + p * L, &r, sizeof(V));
+        }
+    }
+    for (; i < m; i++) y[i] = clenshaw(c, n, (x[i] - centre) * echelle);
+}
+
+template <class S> SIMD_CIBLE_SSE2 void chebyshev_sse2(const S* c, int n, S ce, S ec, const S* x, S* y, size_t m) {
+    clenshaw_voies<S, voies<S>(ISA_SSE2), 4>(c, n, ce, ec, x, y, m);
+}
+template <class S> SIMD_CIBLE_AVX2 void chebyshev_avx2(const S* c, int n, S ce, S ec, const S* x, S* y, size_t m) {
+    clenshaw_voies<S, voies<S>(ISA_AVX2), 4>(c, n, ce, ec, x, y, m);
+}
+template <class S> SIMD_CIBLE_AVX512 void chebyshev_avx512(const S* c, int n, S ce, S ec, const S* x, S* y, size_t m) {
+    clenshaw_voies<S, voies<S>(ISA_AVX512), 8>(c, n, ce, ec, x, y, m);
+}
+
+} // namespace cheb_detail
+
+template <class S>
+inline void chebyshev_lot(const SerieChebyshev<S>& s, const S* x, S* y, size_t m, Isa isa = ISA_AUTO) {
+    isa = isa_effective(isa);
+    const S* c = s.c.data();
+    int n = (int) s.c.size();
+    if (isa == ISA_AVX512) cheb_detail::chebyshev_avx512(c, n, s.centre, s.echelle, x, y, m);
+    else if (isa == ISA_AVX2) cheb_detail::chebyshev_avx2(c, n, s.centre, s.echelle, x, y, m);
+    else cheb_detail::chebyshev_sse2(c, n, s.centre, s.echelle, x, y, m);
+}
+
+#endif // CHEBYSHEV_H
@@ -0,0 +1,217 @@
+/* series de Chebyshev evaluees par Clenshaw contre le meme polynome en base
+   monomiale evalue par Horner : precision selon le degre, cycles par point */
+#include "../EvalPerf.hpp"
+#include "../Horner.hpp"
+#include "Chebyshev.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+
+#define CHEB_SCALAIRE __attribute__((noinline, optimize("no-tree-vectorize")))
+
+struct Fonction {
+    const char* nom;
+    double a, b;
+    long double (*f)(long double);
+};
+
+long double f_exp(long double x) { return expl(x); }
+long double f_runge(long double x) { return 1 / (1 + 25 * x * x); }
+long double f_oscillante(long double x) { return sinl(20 * x) * expl(-x); }
+
+void clenshaw_scalaire(const SerieChebyshev<double>&, const double*, double*, size_t);
+void horner_scalaire(const SerieChebyshev<double>&, const std::vector<double>&, const double*, double*, size_t);
+void clenshaw_16(const SerieChebyshev<double>&, const double*, double*, size_t);
+void horner_16(const SerieChebyshev<double>&, const std::vector<double>&, const double*, double*, size_t);
+void horner_lot(const SerieChebyshev<double>&, const std::vector<double>&, const double*, double*, size_t, Isa);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\ndegree nb_points number_of_loops output_file\n");
+        return -1;
+    }
+    int degre = atoi(argv[1]);
+    size_t m = atol(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    EvalPerf PE;
+
+    Fonction fonctions[3] = {
+        {"exp(x) sur [0, 2]", 0, 2, f_exp},
+        {"1 / (1 + 25 x^2) sur [-1, 1]", -1, 1, f_runge},
+        {"sin(20 x) exp(-x) sur [0, 3]", 0, 3, f_oscillante},
+    };
+
+    /* precision : erreur absolue max sur 10^4 points, rapportee a max |f| */
+    fichier << "erreur relative max (Clenshaw | Horner monomial en t)\n";
+    int degres[6] = {8, 16, 32, 64, 128, 256};
+    for (const Fonction& F : fonctions) {
+        fichier << F.nom << "\n";
+        for (int d : degres) {
+            SerieChebyshev<double> s = ajuster_chebyshev<double>([&](double x) { return (double) F.f(x); },
+                                                                  d + 1, F.a, F.b);
+            std::vector<double> p = s.monomes_en_t();
+            long double pire_c = 0, pire_h = 0, pire_approx = 0, norme = 0;
+            double coef_max = 0;
+            for (double a : p) coef_max = std::max(coef_max, fabs(a));
+            for (int i = 0; i <= 10000; i++) {
+                double x = F.a + (F.b - F.a) * i / 10000;
+                long double exact = F.f(x);
+                /* polynome exact : Clenshaw en long double sur les memes c */
+                long double pl = clenshaw(s.c.data(), (int) s.c.size(), (long double) s.vers_t(x));
+                norme = std::max(norme, fabsl(exact));
+                pire_approx = std::max(pire_approx, fabsl(pl - exact));
+                pire_c = std::max(pire_c, fabsl(s(x) - pl));
+                pire_h = std::max(pire_h, fabsl(horner(p.data(), (int) p.size(), s.vers_t(x)) - pl));
+            }
+            fichier << "    degre " << d << ": approximation " << (double) (pire_approx / norme)
+                    << " | evaluation " << (double) (pire_c / norme) << " | " << (double) (pire_h / norme)
+                    << "  (max |coef monomial| " << coef_max << ")\n";
+        }
+    }
+
+    /* serie vide (n = 0) : nulle partout, y compris par lots */
+    {
+        SerieChebyshev<double> v = ajuster_chebyshev<double>([](double x) { return x; }, 0, -1.0, 1.0);
+        std::vector<double> xv(37, 0.5), yv(37, 1);
+        bool nulle = v.c.empty() && v.monomes_en_t().empty() && v(0.5) == 0;
+        for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+            chebyshev_lot(v, xv.data(), yv.data(), xv.size(), (Isa) isa);
+            for (double w : yv) nulle = nulle && w == 0;
+        }
+        fichier << "serie vide: " << (nulle ? "nulle, correct" : "FAUX") << "\n";
+    }
+
+    /* debit sur le degre demande */
+    SerieChebyshev<double> s = ajuster_chebyshev<double>([](double x) { return (double) f_runge(x); },
+                                                          degre + 1, -1.0, 1.0);
+    SerieChebyshev<double> s16 = ajuster_chebyshev<double>([](double x) { return (double) f_exp(x); }, 16, 0.0, 2.0);
+    std::vector<double> p = s.monomes_en_t(), p16 = s16.monomes_en_t();
+    std::vector<double> x(m), y(m), z(m);
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> u(-1, 1);
+    for (size_t i = 0; i < m; i++) x[i] = u(gen);
+
+    fichier << "\ndebit, degre " << degre << ", " << m << " points (cycles/point)\n";
+    struct Mesure {
+        std::string nom;
+        std::function<void()> f;
+    };
+    std::vector<Mesure> mesures = {
+        {"clenshaw scalaire", [&] { clenshaw_scalaire(s, x.data(), y.data(), m); }},
+        {"horner scalaire", [&] { horner_scalaire(s, p, x.data(), z.data(), m); }},
+        {"clenshaw<16> scalaire (exp)", [&] { clenshaw_16(s16, x.data(), y.data(), m); }},
+        {"horner<16> scalaire (exp)", [&] { horner_16(s16, p16, x.data(), z.data(), m); }},
+    };
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        mesures.push_back({std::string("clenshaw lot ") + NOMS_ISA[isa],
+                           [&, isa] { chebyshev_lot(s, x.data(), y.data(), m, (Isa) isa); }});
+        mesures.push_back({std::string("horner lot ") + NOMS_ISA[isa],
+                           [&, isa] { horner_lot(s, p, x.data(), z.data(), m, (Isa) isa); }});
+    }
+    for (const Mesure& me : mesures) {
+        double nbc = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            me.f();
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+        }
+        fichier << "    " << me.nom << ": " << nbc / number_of_loops / m << "\n";
+    }
+
+    /* ajustement : DCT par FFT contre la somme directe */
+    int n_fit = 1;
+    while (n_fit < std::max(degre + 1, 1024)) n_fit *= 2;
+    for (int rapide = 1; rapide >= 0; rapide--) {
+        double nbs = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            SerieChebyshev<double> t = ajuster_chebyshev<double>([](double v) { return cos(50 * v); }, n_fit,
+                                                                  -1.0, 1.0, rapide);
+            PE.stop();
+            nbs += PE.nb_s();
+        }
+        fichier << "ajustement " << n_fit << " points " << (rapide ? "DCT (FFT)" : "DCT directe") << " nbs:"
+                << nbs / number_of_loops << "\n";
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+CHEB_SCALAIRE void clenshaw_scalaire(const SerieChebyshev<double>& s, const double* x, double* y, size_t m) {
+    for (size_t i = 0; i < m; i++) y[i] = s(x[i]);
+}
+
+CHEB_SCALAIRE void horner_scalaire(const SerieChebyshev<double>& s, const std::vector<double>& p,
+                                   const double* x, double* y, size_t m) {
+    for (size_t i = 0; i < m; i++) y[i] = horner(p.data(), (int) p.size(), s.vers_t(x[i]));
+}
+
+CHEB_SCALAIRE void clenshaw_16(const SerieChebyshev<double>& s, const double* x, double* y, size_t m) {
+    const double* c = s.c.data();
+    for (size_t i = 0; i < m; i++) y[i] = Clenshaw<16>::f(c, s.vers_t(x[i]));
+}
+
+CHEB_SCALAIRE void horner_16(const SerieChebyshev<double>& s, const std::vector<double>& p,
+                             const double* x, double* y, size_t m) {
+    const double* c = p.data();
+    for (size_t i = 0; i < m; i++) Horner<16>::f(y[i], c, s.vers_t(x[i]));
+}
+
+/* Horner monomial par lots, meme structure que cheb_detail::clenshaw_voies */
+template <int L, int P>
+CHEB_EN_LIGNE void horner_voies(const double* c, int n, double ce, double ec, const double* x, double* y, size_t m) {
+    typedef typename Simd<double, L>::v V;
+    size_t i = 0;
+    for (; i + P * L <= m; i += P * L) {
+        V t[P], r[P];
+        #pragma GCC unroll 8
+        for (int p = 0; p < P; p++) {
+            memcpy(&t[p], x + i + p * L, sizeof(V));
+            t[p] = (t[p] - ce) * ec;
+            r[p] = V() + c[n - 1];
+        }
+        for (int k = n - 2; k >= 0; k--) {
+            #pragma GCC unroll 8
+            for (int p = 0; p < P; p++) r[p] = r[p] * t[p] + c[k];
+        }
+        memcpy(y + i, r, sizeof(r));
+    }
+    for (; i < m; i++) y[i] = horner(c, n, (x[i] - ce) * ec);
+}
+
+SIMD_CIBLE_SSE2 void horner_sse2(const double* c, int n, double ce, double ec, const double* x, double* y, size_t m) {
+    horner_voies<2, 8>(c, n, ce, ec, x, y, m);
+}
+SIMD_CIBLE_AVX2 void horner_avx2(const double* c, int n, double ce, double ec, const double* x, double* y, size_t m) {
+    horner_voies<4, 8>(c, n, ce, ec, x, y, m);
+}
+SIMD_CIBLE_AVX512 void horner_avx512(const double* c, int n, double ce, double ec, const double* x, double* y, size_t m) {
+    horner_voies<8, 8>(c, n, ce, ec, x, y, m);
+}
+
+void horner_lot(const SerieChebyshev<double>& s, const std::vector<double>& p, const double* x, double* y,
+                size_t m, Isa isa) {
+    if (isa == ISA_AVX512) horner_avx512(p.data(), (int) p.size(), s.centre, s.echelle, x, y, m);
+    else if (isa == ISA_AVX2) horner_avx2(p.data(), (int) p.size(), s.centre, s.echelle, x, y, m);
+    else horner_sse2(p.data(), (int) p.size(), s.centre, s.echelle, x, y, m);
+}
+
+/*  commandes d'execution:
+    ./execs/tp_chebyshev 32 1000000 10 chebyshev_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_chebyshev.cpp -o execs/tp_chebyshev
+*/
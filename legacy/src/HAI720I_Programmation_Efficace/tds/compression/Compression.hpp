@@ -0,0 +1,300 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <utility>
+#include "../Simd.hpp"
+#include "../SommePrefixe.hpp"
+
+/*  Compression de listes d'entiers 32 bits triees (identifiants) : on
+    code les ecarts d[i] = x[i] - x[i - 1] (modulo 2^32 : une liste non
+    triee reste decodable, mal compressee) ; decoder est une somme prefixe
+    des ecarts (ma_fonction de tp2_exo5, SommePrefixe.hpp).
+
+        BlocsCompresses, empaquetage par blocs (SIMD-BP128, Lemire et
+            Boytsov) : blocs de 32 V entiers (V = 4, 8 ou 16 voies : 128,
+            256 ou 512), b bits par ecart dans un bloc, b = bits du plus
+            grand ecart du bloc. Disposition verticale : l'entier r V + j
+            est dans la voie j ; les 32 ecarts de b bits d'une voie
+            occupent b mots, le mot k des V voies est contigu. Un vecteur
+            de b mots charges donne, par decalages et masques (b constant :
+            une instance par largeur), V ecarts consecutifs : la somme
+            prefixe se fait dans le registre (log2 V decalages de voies et
+            additions) plus la derniere valeur du vecteur precedent,
+            sans repasser en memoire.
+
+        FluxVByte (Stream VByte, Lemire et al.) : chaque ecart sur 1 a 4
+            octets, longueurs sur 2 bits groupees par 4 dans un octet de
+            controle, separees des donnees. Un octet de controle indexe une
+            table de 256 masques pshufb qui place les 4 ecarts dans un
+            vecteur en une instruction (avx2 et avx512 ; boucle scalaire en
+            sse2, pshufb etant ssse3), puis meme somme prefixe. */
+
+struct BlocsCompresses {
+    size_t n = 0;
+    int voies = 4;                      /* bloc de 32 voies entiers */
+    std::vector<uint8_t> largeurs;      /* bits par ecart, un par bloc */
+    std::vector<uint32_t> mots;         /* b voies mots par bloc */
+
+    size_t octets() const { return largeurs.size() + mots.size() * sizeof(uint32_t); }
+};
+
+struct FluxVByte {
+    size_t n = 0;
+    std::vector<uint8_t> controle;      /* 2 bits par entier, groupes de 4 */
+    std::vector<uint8_t> donnees;       /* + 16 octets : lectures de 16 */
+
+    size_t octets() const { return controle.size() + donnees.size() - 16; }
+};
+
+namespace compression_detail {
+
+inline int bits(uint32_t d) {
+    return d == 0 ? 0 : 32 - __builtin_clz(d);
+}
+
+/* resultat en premier argument, vecteurs par reference (Simd.hpp) */
+template <class V>
+SIMD_EN_LIGNE void charger(V& v, const void* p) {
+    memcpy(&v, p, sizeof(V));
+}
+
+/* voies decalees de S vers le haut, zeros en bas */
+template <class V, int S, size_t... I>
+SIMD_EN_LIGNE void decaler(V& r, const V& v, std::index_sequence<I...>) {
+    r = __builtin_shufflevector(v, V(), (I >= S ? I - S : sizeof...(I) + I)...);
+}
+
+/* somme prefixe inclusive des L voies : log2 L decalages et additions */
+template <int L, class V, int S = 1>
+SIMD_EN_LIGNE void prefixe(V& r, const V& v) {
+    if constexpr (S < L) {
+        V d;
+        decaler<V, S>(d, v, std::make_index_sequence<L>());
+        prefixe<L, V, 2 * S>(r, v + d);
+    } else {
+        r = v;
+    }
+}
+
+/* derniere voie diffusee */
+template <class V, size_t... I>
+SIMD_EN_LIGNE void dernier(V& r, const V& v, std::index_sequence<I...>) {
+    r = __builtin_shufflevector(v, v, (I * 0 + sizeof...(I) - 1)...);
+}
+
+/*  32 vecteurs de L ecarts de B bits (B mots de L voies en entree), en
+    valeurs si PREFIXE (somme prefixe depuis base, mise a jour) */
+template <int L, int B, bool PREFIXE>
+SIMD_EN_LIGNE void deballer(const uint32_t* in, uint32_t* out, typename Simd<float, L>::vu& base) {
+    typedef typename Simd<float, L>::vu V;
+    const uint32_t m = B == 32 ? ~0u : (1u << B) - 1;
+    #pragma GCC unroll 32
+    for (int r = 0; r < 32; r++) {
+        V v = V();
+        if constexpr (B > 0) {
+            const int p = r * B, w = p / 32, o = p % 32;
+            V a;
+            charger(a, in + w * L);
+            v = a >> o;
+            if (o + B > 32) {
+                charger(a, in + (w + 1) * L);
+                v |= a << (32 - o);
+            }
+            if constexpr (B < 32) v &= m;
+        }
+        if constexpr (PREFIXE) {
+            prefixe<L>(v, v);
+            v += base;
+            dernier(base, v, std::make_index_sequence<L>());
+        }
+        memcpy(out + r * L, &v, sizeof(V));
+    }
+}
+
+/* b lu a l'execution -> instance de largeur b */
+template <int L, bool PREFIXE, int B = 0>
+SIMD_EN_LIGNE void deballer(int b, const uint32_t* in, uint32_t* out, typename Simd<float, L>::vu& base) {
+    if constexpr (B <= 32) {
+        if (b == B) deballer<L, B, PREFIXE>(in, out, base);
+        else deballer<L, PREFIXE, B + 1>(b, in, out, base);
+    }
+}
+
+struct DecodageBlocs {
+    const BlocsCompresses* c;
+    uint32_t* x;
+    bool fusionne;
+
+    template <int L> SIMD_EN_LIGNE void decoder() const {
+        typedef typename Simd<float, L>::vu V;
+        const size_t T = 32 * L, n = c->n;
+        const uint32_t* in = c->mots.data();
+        uint32_t dernier_bloc[T];
+        V base = V();
+        for (size_t k = 0; k < c->largeurs.size(); k++) {
+            bool complet = (k + 1) * T <= n;
+            uint32_t* out = complet ? x + k * T : dernier_bloc;
+            int b = c->largeurs[k];
+            if (fusionne) deballer<L, true>(b, in, out, base);
+            else deballer<L, false>(b, in, out, base);
+            if (!complet) memcpy(x + k * T, dernier_bloc, (n - k * T) * sizeof(uint32_t));
+            in += (size_t) b * L;
+        }
+    }
+
+    /* le format fixe la largeur des vecteurs, l'isa le code genere */
+    template <int LI> SIMD_EN_LIGNE void executer() const {
+        if (c->voies == 4) decoder<4>();
+        else if (c->voies == 8) decoder<8>();
+        else decoder<16>();
+    }
+};
+
+struct TableVByte {
+    uint8_t masque[256][16];
+    uint8_t longueur[256];
+
+    TableVByte() {
+        for (int c = 0; c < 256; c++) {
+            int o = 0;
+            for (int k = 0; k < 4; k++) {
+                int l = ((c >> (2 * k)) & 3) + 1;
+                for (int m = 0; m < 4; m++) masque[c][4 * k + m] = m < l ? o + m : 0x80;
+                o += l;
+            }
+            longueur[c] = o;
+        }
+    }
+};
+
+inline const TableVByte& table_vbyte() {
+    static const TableVByte t;
+    return t;
+}
+
+struct DecodageVByte {
+    const FluxVByte* f;
+    uint32_t* x;
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        typedef typename Simd<float, 4>::vu V;
+        typedef char v16qi __attribute__((vector_size(16)));
+        const TableVByte& t = table_vbyte();
+        const uint8_t* ctrl = f->controle.data();
+        const uint8_t* d = f->donnees.data();
+        const size_t n = f->n;
+        size_t g = 0;
+        uint32_t prec = 0;
+        if constexpr (L >= 8) {
+            V base = V();
+            for (; 4 * g + 4 <= n; g++) {
+                v16qi o, m;
+                charger(o, d);
+                charger(m, t.masque[ctrl[g]]);
+                V v = (V) __builtin_ia32_pshufb128(o, m);
+                d += t.longueur[ctrl[g]];
+                prefixe<4>(v, v);
+                v += base;
+                dernier(base, v, std::make_index_sequence<4>());
+                memcpy(x + 4 * g, &v, sizeof(V));
+            }
+            prec = base[0];
+        }
+        /* sse2, et le dernier groupe incomplet */
+        for (size_t i = 4 * g; i < n; i++) {
+            int l = ((ctrl[i / 4] >> (2 * (i % 4))) & 3) + 1;
+            uint32_t e = 0;
+            memcpy(&e, d, l);
+            d += l;
+            x[i] = prec += e;
+        }
+    }
+};
+
+} // namespace compression_detail
+
+/* voies : 4, 8 ou 16 (blocs de 128, 256 ou 512 entiers) */
+inline BlocsCompresses compresser_blocs(const uint32_t* x, size_t n, int voies = 4) {
+    BlocsCompresses c;
+    c.n = n;
+    c.voies = voies;
+    const size_t T = 32 * (size_t) voies;
+    std::vector<uint32_t> d(T);
+    uint32_t prec = 0;
+    for (size_t k = 0; k * T < n; k++) {
+        uint32_t ou = 0;
+        for (size_t i = 0; i < T; i++) {
+            size_t q = k * T + i;
+            d[i] = q < n ? x[q] - prec : 0;
+            if (q < n) prec = x[q];
+            ou |= d[i];
+        }
+        int b = compression_detail::bits(ou);
+        c.largeurs.push_back(b);
+        size_t base = c.mots.size();
+        c.mots.resize(base + (size_t) b * voies, 0);
+        if (b == 0) continue;
+        for (size_t i = 0; i < T; i++) {
+            size_t r = i / voies, j = i % voies, p = r * b, w = p / 32, o = p % 32;
+            c.mots[base + w * voies + j] |= d[i] << o;
+            if (o + b > 32) c.mots[base + (w + 1) * voies + j] |= d[i] >> (32 - o);
+        }
+    }
+    return c;
+}
+
+/*  fusionne = false : ecarts deballes puis somme prefixe separee sur tout
+    x (deux passages en memoire), pour comparaison */
+inline void decompresser_blocs(const BlocsCompresses& c, uint32_t* x, Isa isa = ISA_AUTO, bool fusionne = true) {
+    compression_detail::DecodageBlocs e = {&c, x, fusionne};
+    lancer_simd<float>(e, isa);
+    if (!fusionne) somme_prefixe_inclusive(x, c.n);
+}
+
+/* reference : entier par entier, sans vecteurs */
+inline void decompresser_blocs_naif(const BlocsCompresses& c, uint32_t* x) {
+    const size_t L = c.voies, T = 32 * L;
+    const uint32_t* in = c.mots.data();
+    uint32_t prec = 0;
+    for (size_t k = 0; k < c.largeurs.size(); k++) {
+        int b = c.largeurs[k];
+        uint32_t m = b == 32 ? ~0u : (1u << b) - 1;
+        for (size_t i = 0; i < T && k * T + i < c.n; i++) {
+            size_t r = i / L, j = i % L, p = r * b, w = p / 32, o = p % 32;
+            uint32_t v = 0;
+            if (b > 0) {
+                v = in[w * L + j] >> o;
+                if (o + b > 32) v |= in[(w + 1) * L + j] << (32 - o);
+            }
+            x[k * T + i] = prec += v & m;
+        }
+        in += b * L;
+    }
+}
+
+inline FluxVByte compresser_vbyte(const uint32_t* x, size_t n) {
+    FluxVByte f;
+    f.n = n;
+    f.controle.assign((n + 3) / 4, 0);
+    f.donnees.reserve(n + 16);
+    uint32_t prec = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t e = x[i] - prec;
+        prec = x[i];
+        int l = e < (1u << 8) ? 1 : e < (1u << 16) ? 2 : e < (1u << 24) ? 3 : 4;
+        f.controle[i / 4] |= (l - 1) << (2 * (i % 4));
+        for (int m = 0; m < l; m++) f.donnees.push_back(e >> (8 * m));
+    }
+    f.donnees.resize(f.donnees.size() + 16, 0);
+    return f;
+}
+
+inline void decompresser_vbyte(const FluxVByte& f, uint32_t* x, Isa isa = ISA_AUTO) {
+    compression_detail::DecodageVByte e = {&f, x};
+    lancer_simd<float>(e, isa);
+}
+
+#endif // COMPRESSION_H
@@ -0,0 +1,112 @@
+/* compression de listes d'identifiants tries : ecarts empaquetes par blocs
+   de 128 / 256 / 512 (deballage et somme prefixe fusionnes ou non) et
+   Stream VByte, en milliards d'entiers decodes par seconde */
+#include "../EvalPerf.hpp"
+#include "Compression.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+std::vector<uint32_t> identifiants(size_t, int, bool, std::mt19937_64&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nsize mean_gap number_of_loops output_file\n");
+        return -1;
+    }
+    size_t n = atoll(argv[1]);
+    int ecart = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+
+    for (bool groupes : {false, true}) {
+        std::vector<uint32_t> x = identifiants(n, ecart, groupes, gen), y(n);
+        fichier << n << " identifiants, ecart moyen " << ecart
+                << (groupes ? ", par paquets (ecarts de 1 et sauts rares)" : ", ecarts uniformes") << "\n";
+
+        auto mesurer = [&](const std::string& nom, size_t octets, const std::function<void()>& f, bool verifier) {
+            double nbs = 0;
+            std::fill(y.begin(), y.end(), 0);
+            f();
+            bool correct = y == x;
+            for (int k = 0; k < number_of_loops; k++) {
+                PE.start();
+                f();
+                PE.stop();
+                nbs += PE.nb_s();
+            }
+            double s = nbs / number_of_loops;
+            fichier << "    " << nom << ": " << n / s * 1e-9 << " Gentiers/s, " << octets * 8.0 / n << " bits/entier";
+            if (verifier) fichier << ", " << (correct ? "correct" : "FAUX");
+            fichier << "\n";
+        };
+
+        /* references : copie, et somme prefixe des ecarts non compresses (tp2_exo5) */
+        std::vector<uint32_t> d(n);
+        for (size_t i = 0; i < n; i++) d[i] = x[i] - (i ? x[i - 1] : 0);
+        mesurer("memcpy", n * 4, [&] { memcpy(y.data(), x.data(), n * 4); }, true);
+        mesurer("ecarts bruts + somme prefixe", n * 4, [&] {
+            memcpy(y.data(), d.data(), n * 4);
+            somme_prefixe_inclusive(y.data(), n);
+        }, true);
+
+        for (int voies : {4, 8, 16}) {
+            PE.start();
+            BlocsCompresses c = compresser_blocs(x.data(), n, voies);
+            PE.stop();
+            fichier << "  blocs de " << 32 * voies << " : codage " << n / PE.nb_s() * 1e-9 << " Gentiers/s\n";
+            mesurer("    naif", c.octets(), [&] { decompresser_blocs_naif(c, y.data()); }, true);
+            for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+                for (bool fusion : {false, true}) {
+                    mesurer(std::string("    ") + NOMS_ISA[isa] + (fusion ? ", fusionne" : ", puis somme prefixe"),
+                            c.octets(), [&, isa, fusion] { decompresser_blocs(c, y.data(), (Isa) isa, fusion); },
+                            true);
+                }
+            }
+        }
+
+        PE.start();
+        FluxVByte f = compresser_vbyte(x.data(), n);
+        PE.stop();
+        fichier << "  Stream VByte : codage " << n / PE.nb_s() * 1e-9 << " Gentiers/s\n";
+        for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+            mesurer(std::string("    ") + NOMS_ISA[isa] + (isa == ISA_SSE2 ? " (scalaire)" : " (pshufb)"),
+                    f.octets(), [&, isa] { decompresser_vbyte(f, y.data(), (Isa) isa); }, true);
+        }
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/*  ecarts uniformes dans [1, 2 ecart - 1], ou par paquets : ecart 1 sauf
+    avec probabilite 1 / ecart, alors un saut uniforme dans [1, ecart^2] */
+std::vector<uint32_t> identifiants(size_t n, int ecart, bool groupes, std::mt19937_64& gen) {
+    std::uniform_int_distribution<uint32_t> u(1, 2 * ecart - 1), saut(1, (uint32_t) ecart * ecart);
+    std::bernoulli_distribution rare(1.0 / ecart);
+    std::vector<uint32_t> x(n);
+    uint32_t v = 0;
+    for (size_t i = 0; i < n; i++) {
+        v += groupes ? (rare(gen) ? saut(gen) : 1) : u(gen);
+        x[i] = v;
+    }
+    return x;
+}
+
+/*  commandes d'execution:
+    ./execs/tp_compression 10000000 16 20 compression_out.txt
+    ./execs/tp_compression 10000000 1000 20 compression_1000_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_compression.cpp -o execs/tp_compression
+*/
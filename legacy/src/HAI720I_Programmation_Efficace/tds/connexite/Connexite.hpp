@@ -0,0 +1,394 @@
+#ifndef CONNEXITE_H
+#define CONNEXITE_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <random>
+#include <omp.h>
+#include "../Graphe.hpp"
+#include "../SommePrefixe.hpp"
+
+/*  Accessibilite et connexite sur le noyau CSR (cf. HAI711I, connexite et
+    2-connexite) :
+        - parcours en largeur a direction optimisee (Beamer) : etapes
+          haut-bas sur une file, etapes bas-haut sur une frontiere en bitmap
+        - composantes connexes par union-find parallele (Shiloach-Vishkin
+          et Afforest)
+        - composantes biconnexes et points d'articulation (Tarjan) */
+
+static const sommet_t PAS_DE_PERE = UINT32_MAX;
+
+struct Bitmap {
+    std::vector<uint64_t> mots;
+
+    explicit Bitmap(uint32_t n = 0) : mots((n + 63) / 64, 0) {}
+    void vider() { std::fill(mots.begin(), mots.end(), 0); }
+    bool teste(uint32_t i) const { return (mots[i >> 6] >> (i & 63)) & 1; }
+    void pose(uint32_t i) { mots[i >> 6] |= (uint64_t) 1 << (i & 63); }
+    void pose_atomique(uint32_t i) {
+        __atomic_fetch_or(&mots[i >> 6], (uint64_t) 1 << (i & 63), __ATOMIC_RELAXED);
+    }
+    void echanger(Bitmap& b) { mots.swap(b.mots); }
+};
+
+struct StatsBfs {
+    uint32_t etapes_haut_bas = 0, etapes_bas_haut = 0;
+    uint64_t arcs_examines = 0;
+    uint64_t sommets_atteints = 0;
+};
+
+
+namespace connexite_detail {
+
+inline bool cas(sommet_t* p, sommet_t attendu, sommet_t nouveau) {
+    return __atomic_compare_exchange_n(p, &attendu, nouveau, false,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+/*  etape haut-bas : chaque thread explore une part de la file et remplit sa
+    file locale ; les files locales sont concatenees a l'aide d'une somme
+    prefixe de leurs tailles. Renvoie les arcs examines. */
+inline uint64_t etape_haut_bas(const Graphe& g, std::vector<sommet_t>& pere,
+                               const std::vector<sommet_t>& file,
+                               std::vector<sommet_t>& suivante,
+                               std::vector<std::vector<sommet_t>>& locales,
+                               uint64_t& arcs_frontiere) {
+    uint64_t examines = 0, arcs_suivante = 0;
+    int nt = (int) locales.size();
+    std::vector<size_t> decalage(nt + 1, 0);
+    #pragma omp parallel num_threads(nt) reduction(+ : examines, arcs_suivante)
+    {
+        int t = omp_get_thread_num();
+        std::vector<sommet_t>& loc = locales[t];
+        loc.clear();
+        #pragma omp for schedule(dynamic, 64) nowait
+        for (size_t i = 0; i < file.size(); i++) {
+            sommet_t u = file[i];
+            examines += g.degre(u);
+            for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+                sommet_t v = *p;
+                if (pere[v] == PAS_DE_PERE && cas(&pere[v], PAS_DE_PERE, u)) {
+                    loc.push_back(v);
+                    arcs_suivante += g.degre(v);
+                }
+            }
+        }
+        decalage[t + 1] = loc.size();
+        #pragma omp barrier
+        #pragma omp single
+        {
+            somme_prefixe_inclusive(decalage.data(), nt + 1);
+            suivante.resize(decalage[nt]);
+        }
+        std::copy(loc.begin(), loc.end(), suivante.begin() + decalage[t]);
+    }
+    arcs_frontiere = arcs_suivante;
+    return examines;
+}
+
+/*  etape bas-haut : chaque sommet non visite cherche un pere dans la
+    frontiere parmi ses voisins entrants (gt) et s'arrete au premier trouve.
+    Aucune ecriture concurrente sur pere : seul v ecrit pere[v]. */
+inline uint64_t etape_bas_haut(const Graphe& gt, std::vector<sommet_t>& pere,
+                               const Bitmap& frontiere, Bitmap& suivante,
+                               uint64_t& nb_reveilles) {
+    uint64_t examines = 0, reveilles = 0;
+    suivante.vider();
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(+ : examines, reveilles)
+    for (uint32_t v = 0; v < gt.n; v++) {
+        if (pere[v] != PAS_DE_PERE) continue;
+        for (const sommet_t* p = gt.debut_voisins(v); p != gt.fin_voisins(v); p++) {
+            examines++;
+            if (frontiere.teste(*p)) {
+                pere[v] = *p;
+                suivante.pose_atomique(v);
+                reveilles++;
+                break;
+            }
+        }
+    }
+    nb_reveilles = reveilles;
+    return examines;
+}
+
+inline void file_vers_bitmap(const std::vector<sommet_t>& file, Bitmap& b) {
+    b.vider();
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < file.size(); i++) b.pose_atomique(file[i]);
+}
+
+inline void bitmap_vers_file(const Bitmap& b, std::vector<sommet_t>& file,
+                             std::vector<std::vector<sommet_t>>& locales) {
+    int nt = (int) locales.size();
+    std::vector<size_t> decalage(nt + 1, 0);
+    #pragma omp parallel num_threads(nt)
+    {
+        int t = omp_get_thread_num();
+        std::vector<sommet_t>& loc = locales[t];
+        loc.clear();
+        #pragma omp for schedule(static) nowait
+        for (size_t w = 0; w < b.mots.size(); w++) {
+            uint64_t mot = b.mots[w];
+            while (mot) {
+                loc.push_back((sommet_t) (w * 64 + __builtin_ctzll(mot)));
+                mot &= mot - 1;
+            }
+        }
+        decalage[t + 1] = loc.size();
+        #pragma omp barrier
+        #pragma omp single
+        {
+            somme_prefixe_inclusive(decalage.data(), nt + 1);
+            file.resize(decalage[nt]);
+        }
+        std::copy(loc.begin(), loc.end(), file.begin() + decalage[t]);
+    }
+}
+
+} // namespace connexite_detail
+
+
+/*  Parcours en largeur a direction optimisee depuis s. gt est le graphe
+    transpose (g lui-meme si g est symetrique). pere[s] = s, PAS_DE_PERE pour
+    les sommets non atteints. alpha et beta sont les seuils de Beamer :
+    passage en bas-haut quand les arcs de la frontiere depassent 1/alpha des
+    arcs non explores, retour en haut-bas quand la frontiere repasse sous
+    n/beta sommets. alpha = 0 force le haut-bas seul. */
+inline void bfs_direction_optimisee(const Graphe& g, const Graphe& gt, sommet_t s,
+                                    std::vector<sommet_t>& pere, StatsBfs* stats = nullptr,
+                                    double alpha = 15, double beta = 18) {
+    using namespace connexite_detail;
+    pere.assign(g.n, PAS_DE_PERE);
+    pere[s] = s;
+    std::vector<std::vector<sommet_t>> locales(omp_get_max_threads());
+    std::vector<sommet_t> file(1, s), suivante;
+    Bitmap frontiere(g.n), bitmap_suivante(g.n);
+    uint64_t arcs_frontiere = g.degre(s);
+    uint64_t arcs_restants = g.m;
+    StatsBfs st;
+    st.sommets_atteints = 1;
+
+    while (!file.empty()) {
+        if (alpha > 0 && arcs_frontiere > arcs_restants / alpha) {
+            /* bas-haut tant que la frontiere est grande ou croissante */
+            file_vers_bitmap(file, frontiere);
+            uint64_t taille = file.size(), precedente;
+            do {
+                precedente = taille;
+                st.arcs_examines += etape_bas_haut(gt, pere, frontiere, bitmap_suivante, taille);
+                st.etapes_bas_haut++;
+                st.sommets_atteints += taille;
+                frontiere.echanger(bitmap_suivante);
+            } while (taille >= precedente || taille > g.n / beta);
+            bitmap_vers_file(frontiere, file, locales);
+            arcs_frontiere = 1;
+        } else {
+            arcs_restants -= std::min(arcs_restants, arcs_frontiere);
+            st.arcs_examines += etape_haut_bas(g, pere, file, suivante, locales, arcs_frontiere);
+            st.etapes_haut_bas++;
+            st.sommets_atteints += suivante.size();
+            file.swap(suivante);
+        }
+    }
+    if (stats) *stats = st;
+}
+
+/* niveau de chaque sommet a partir de l'arbre des peres (pour verification) */
+inline std::vector<uint32_t> niveaux_depuis_peres(const std::vector<sommet_t>& pere) {
+    std::vector<uint32_t> niveau(pere.size(), UINT32_MAX);
+    for (uint32_t v = 0; v < pere.size(); v++) {
+        if (pere[v] == PAS_DE_PERE || niveau[v] != UINT32_MAX) continue;
+        /* on remonte jusqu'a un sommet de niveau connu, puis on redescend */
+        std::vector<uint32_t> chemin;
+        uint32_t u = v;
+        while (niveau[u] == UINT32_MAX && pere[u] != u) {
+            chemin.push_back(u);
+            u = pere[u];
+        }
+        if (pere[u] == u) niveau[u] = 0;
+        uint32_t l = niveau[u];
+        for (size_t i = chemin.size(); i-- > 0;) niveau[chemin[i]] = ++l;
+    }
+    return niveau;
+}
+
+
+/*  Composantes connexes (graphe symetrique). comp[v] est le plus petit
+    identifiant de la composante apres compression. */
+namespace connexite_detail {
+
+/* accroche la racine de plus grand indice sous celle de plus petit indice */
+inline void lier(std::vector<sommet_t>& comp, sommet_t u, sommet_t v) {
+    sommet_t p1 = __atomic_load_n(&comp[u], __ATOMIC_RELAXED);
+    sommet_t p2 = __atomic_load_n(&comp[v], __ATOMIC_RELAXED);
+    while (p1 != p2) {
+        sommet_t haut = std::max(p1, p2), bas = std::min(p1, p2);
+        sommet_t p_haut = __atomic_load_n(&comp[haut], __ATOMIC_RELAXED);
+        if (p_haut == bas) break;
+        if (p_haut == haut && cas(&comp[haut], haut, bas)) break;
+        p1 = __atomic_load_n(&comp[__atomic_load_n(&comp[haut], __ATOMIC_RELAXED)], __ATOMIC_RELAXED);
+        p2 = __atomic_load_n(&comp[bas], __ATOMIC_RELAXED);
+    }
+}
+
+/* compression de chemin : chaque sommet pointe directement vers sa racine */
+inline void compresser(std::vector<sommet_t>& comp) {
+    #pragma omp parallel for schedule(static)
+    for (uint32_t v = 0; v < comp.size(); v++) {
+        while (comp[v] != comp[comp[v]]) comp[v] = comp[comp[v]];
+    }
+}
+
+} // namespace connexite_detail
+
+/*  Shiloach-Vishkin : accrochage de chaque arete puis raccourcissement,
+    jusqu'a stabilisation. */
+inline void composantes_connexes_sv(const Graphe& g, std::vector<sommet_t>& comp) {
+    comp.resize(g.n);
+    for (uint32_t v = 0; v < g.n; v++) comp[v] = v;
+    bool change = true;
+    while (change) {
+        change = false;
+        #pragma omp parallel for schedule(dynamic, 1024) reduction(|| : change)
+        for (uint32_t u = 0; u < g.n; u++) {
+            for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+                sommet_t cu = comp[u], cv = comp[*p];
+                /* on n'accroche que des racines, a la plus petite etiquette */
+                if (cu < cv && cv == comp[cv]) {
+                    __atomic_store_n(&comp[cv], cu, __ATOMIC_RELAXED);
+                    change = true;
+                }
+            }
+        }
+        connexite_detail::compresser(comp);
+    }
+}
+
+/*  Afforest (Sutton et al.) : on lie d'abord quelques voisins par sommet,
+    on estime la plus grande composante par echantillonnage, puis on ne
+    traite les arcs restants que pour les sommets hors de cette composante. */
+inline void composantes_connexes_afforest(const Graphe& g, std::vector<sommet_t>& comp,
+                                          uint32_t tours_voisins = 2) {
+    using namespace connexite_detail;
+    comp.resize(g.n);
+    #pragma omp parallel for schedule(static)
+    for (uint32_t v = 0; v < g.n; v++) comp[v] = v;
+
+    for (uint32_t r = 0; r < tours_voisins; r++) {
+        #pragma omp parallel for schedule(dynamic, 16384)
+        for (uint32_t u = 0; u < g.n; u++) {
+            if (r < g.degre(u)) lier(comp, u, g.voisins[g.debut[u] + r]);
+        }
+        compresser(comp);
+    }
+
+    /* composante la plus frequente sur un echantillon de 1024 sommets */
+    sommet_t grande = 0;
+    if (g.n > 0) {
+        std::unordered_map<sommet_t, uint32_t> effectifs;
+        std::mt19937 gen(27491095);
+        std::uniform_int_distribution<uint32_t> U(0, g.n - 1);
+        uint32_t meilleur = 0;
+        for (int i = 0; i < 1024; i++) {
+            sommet_t c = comp[U(gen)];
+            if (++effectifs[c] > meilleur) {
+                meilleur = effectifs[c];
+                grande = c;
+            }
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic, 16384)
+    for (uint32_t u = 0; u < g.n; u++) {
+        if (comp[u] == grande) continue;
+        for (uint64_t k = g.debut[u] + std::min<uint64_t>(tours_voisins, g.degre(u));
+             k < g.debut[u + 1]; k++) {
+            lier(comp, u, g.voisins[k]);
+        }
+    }
+    compresser(comp);
+}
+
+inline uint32_t nombre_composantes(const std::vector<sommet_t>& comp) {
+    uint32_t c = 0;
+    for (uint32_t v = 0; v < comp.size(); v++) c += comp[v] == v;
+    return c;
+}
+
+
+/*  Composantes biconnexes (Hopcroft-Tarjan, parcours en profondeur
+    iteratif) pour un graphe symetrique, sans arcs multiples, aux listes de
+    voisins triees. comp_arc[k] est le numero de la composante biconnexe de
+    l'arc k (meme numero pour ses deux sens), articulation[v] vaut 1 pour
+    les points d'articulation. Renvoie le nombre de composantes. */
+inline uint32_t composantes_biconnexes(const Graphe& g, std::vector<uint32_t>& comp_arc,
+                                       std::vector<uint8_t>& articulation) {
+    const uint32_t NON_VU = UINT32_MAX;
+    comp_arc.assign(g.m, UINT32_MAX);
+    articulation.assign(g.n, 0);
+    std::vector<uint32_t> ordre(g.n, NON_VU), bas(g.n), pere(g.n);
+    std::vector<std::pair<sommet_t, uint64_t>> pile; /* (sommet, prochain arc) */
+    std::vector<uint64_t> pile_arcs;
+    std::vector<uint64_t> arc_pere(g.n);
+    uint32_t temps = 0, nb = 0;
+
+    for (uint32_t r = 0; r < g.n; r++) {
+        if (ordre[r] != NON_VU) continue;
+        uint32_t enfants_racine = 0;
+        ordre[r] = bas[r] = temps++;
+        pere[r] = r;
+        pile.push_back({r, g.debut[r]});
+        while (!pile.empty()) {
+            sommet_t u = pile.back().first;
+            uint64_t k = pile.back().second;
+            if (k < g.debut[u + 1]) {
+                pile.back().second++;
+                sommet_t v = g.voisins[k];
+                if (ordre[v] == NON_VU) {
+                    pere[v] = u;
+                    arc_pere[v] = k;
+                    ordre[v] = bas[v] = temps++;
+                    pile_arcs.push_back(k);
+                    pile.push_back({v, g.debut[v]});
+                    if (u == r) enfants_racine++;
+                } else if (v != pere[u] && ordre[v] < ordre[u]) {
+                    /* arc arriere vers un ancetre */
+                    bas[u] = std::min(bas[u], ordre[v]);
+                    pile_arcs.push_back(k);
+                }
+            } else {
+                pile.pop_back();
+                if (u == r) continue;
+                sommet_t p = pere[u];
+                bas[p] = std::min(bas[p], bas[u]);
+                if (bas[u] >= ordre[p]) {
+                    if (p != r) articulation[p] = 1;
+                    uint64_t a;
+                    do {
+                        a = pile_arcs.back();
+                        pile_arcs.pop_back();
+                        comp_arc[a] = nb;
+                    } while (a != arc_pere[u]);
+                    nb++;
+                }
+            }
+        }
+        if (enfants_racine > 1) articulation[r] = 1;
+    }
+
+    /* les arcs dans l'autre sens recoivent la composante de leur oppose */
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (uint32_t u = 0; u < g.n; u++) {
+        for (uint64_t k = g.debut[u]; k < g.debut[u + 1]; k++) {
+            if (comp_arc[k] != UINT32_MAX) continue;
+            sommet_t v = g.voisins[k];
+            const sommet_t* q = std::lower_bound(g.debut_voisins(v), g.fin_voisins(v), u);
+            if (q != g.fin_voisins(v) && *q == u) comp_arc[k] = comp_arc[q - g.voisins];
+        }
+    }
+    return nb;
+}
+
+#endif // CONNEXITE_H
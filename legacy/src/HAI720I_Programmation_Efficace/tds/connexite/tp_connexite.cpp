@@ -0,0 +1,151 @@
+/* parcours en largeur a direction optimisee et composantes connexes /
+   biconnexes : arcs parcourus par seconde */
+#include "../EvalPerf.hpp"
+#include "Connexite.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+
+void bfs_sequentiel(const Graphe&, sommet_t, std::vector<sommet_t>&);
+uint64_t arcs_atteints(const Graphe&, const std::vector<sommet_t>&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nlog2_nb_vertices edge_factor number_of_loops output_file\n");
+        return -1;
+    }
+    int echelle = atoi(argv[1]);
+    int facteur = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    uint32_t n = 1u << echelle;
+    EvalPerf PE;
+
+    /* verification sur deux triangles partageant le sommet 2 */
+    {
+        std::vector<Arete> a = {{0, 1, 0}, {1, 2, 0}, {2, 0, 0}, {2, 3, 0}, {3, 4, 0}, {4, 2, 0}, {5, 6, 0}};
+        OptionsConstruction opt;
+        opt.symetriser = true;
+        Graphe petit = construire_csr(7, a, false, opt);
+        std::vector<uint32_t> comp_arc;
+        std::vector<uint8_t> articulation;
+        uint32_t nb = composantes_biconnexes(petit, comp_arc, articulation);
+        std::vector<sommet_t> comp;
+        composantes_connexes_afforest(petit, comp);
+        printf("petit graphe: %u composantes biconnexes (attendu 3), articulation 2: %d, "
+               "%u composantes connexes (attendu 2)\n", nb, articulation[2], nombre_composantes(comp));
+    }
+
+    std::vector<Arete> aretes = aretes_rmat(n, (uint64_t) facteur * n, 42);
+    OptionsConstruction opt;
+    opt.symetriser = true;
+    opt.boucles = false;
+    opt.dedoublonner = true;
+    Graphe g = construire_csr(n, aretes, false, opt);
+    fichier << "graphe: n=" << g.n << " m=" << g.m << " threads=" << omp_get_max_threads() << "\n";
+
+    /* source : sommet de plus fort degre */
+    sommet_t s = 0;
+    for (uint32_t u = 1; u < n; u++) {
+        if (g.degre(u) > g.degre(s)) s = u;
+    }
+    std::vector<sommet_t> pere_ref, pere;
+    bfs_sequentiel(g, s, pere_ref);
+    std::vector<uint32_t> niveaux_ref = niveaux_depuis_peres(pere_ref);
+    uint64_t arcs_composante = arcs_atteints(g, pere_ref);
+
+    /* sequentiel, haut-bas parallele seul, direction optimisee */
+    const char* noms[3] = {"bfs sequentiel", "bfs haut-bas", "bfs direction optimisee"};
+    for (int version = 0; version < 3; version++) {
+        double nbs = 0;
+        StatsBfs st;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            if (version == 0) bfs_sequentiel(g, s, pere);
+            else bfs_direction_optimisee(g, g, s, pere, &st, version == 1 ? 0 : 15);
+            PE.stop();
+            nbs += PE.nb_s();
+        }
+        bool ok = niveaux_depuis_peres(pere) == niveaux_ref;
+        fichier << noms[version] << (ok ? "" : " (ERREUR de niveaux)") << "\n";
+        fichier << "    nbs:" << nbs / number_of_loops << "\n";
+        fichier << "    TEPS:" << arcs_composante * number_of_loops / nbs << "\n";
+        if (version > 0) {
+            fichier << "    etapes haut-bas/bas-haut:" << st.etapes_haut_bas << "/" << st.etapes_bas_haut
+                    << " arcs examines/arcs composante:" << (double) st.arcs_examines / arcs_composante << "\n";
+        }
+    }
+
+    /* composantes connexes */
+    std::vector<sommet_t> comp_sv, comp_af;
+    double nbs_sv = 0, nbs_af = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        composantes_connexes_sv(g, comp_sv);
+        PE.stop();
+        nbs_sv += PE.nb_s();
+        PE.start();
+        composantes_connexes_afforest(g, comp_af);
+        PE.stop();
+        nbs_af += PE.nb_s();
+    }
+    fichier << "composantes: sv=" << nombre_composantes(comp_sv)
+            << " afforest=" << nombre_composantes(comp_af)
+            << (comp_sv == comp_af ? "" : " (ERREUR etiquettes differentes)") << "\n";
+    fichier << "shiloach-vishkin arcs/s:" << g.m * number_of_loops / nbs_sv << "\n";
+    fichier << "afforest arcs/s:" << g.m * number_of_loops / nbs_af << "\n";
+
+    /* composantes biconnexes */
+    std::vector<uint32_t> comp_arc;
+    std::vector<uint8_t> articulation;
+    PE.start();
+    uint32_t nb_bicomp = composantes_biconnexes(g, comp_arc, articulation);
+    PE.stop();
+    uint32_t nb_art = 0;
+    for (uint8_t a : articulation) nb_art += a;
+    fichier << "biconnexes: " << nb_bicomp << " composantes, " << nb_art << " points d'articulation\n";
+    fichier << "biconnexes arcs/s:" << g.m / PE.nb_s() << "\n";
+    fichier.close();
+
+    return 0;
+}
+
+
+
+void bfs_sequentiel(const Graphe& g, sommet_t s, std::vector<sommet_t>& pere) {
+    pere.assign(g.n, PAS_DE_PERE);
+    std::vector<sommet_t> file;
+    file.reserve(g.n);
+    file.push_back(s);
+    pere[s] = s;
+    for (size_t tete = 0; tete < file.size(); tete++) {
+        sommet_t u = file[tete];
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+            if (pere[*p] == PAS_DE_PERE) {
+                pere[*p] = u;
+                file.push_back(*p);
+            }
+        }
+    }
+}
+
+/* nombre d'aretes de la composante atteinte (convention Graph500) */
+uint64_t arcs_atteints(const Graphe& g, const std::vector<sommet_t>& pere) {
+    uint64_t a = 0;
+    for (uint32_t u = 0; u < g.n; u++) {
+        if (pere[u] != PAS_DE_PERE) a += g.degre(u);
+    }
+    return a / 2;
+}
+
+/*  commandes d'execution:
+    ./execs/tp_connexite 20 16 5 connexite_out.txt
+    OMP_NUM_THREADS=1 ./execs/tp_connexite 20 16 5 connexite_out_1t.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_connexite.cpp -o execs/tp_connexite
+    g++ -O3 -march=native -fopenmp tp_connexite.cpp -o execs/tp_connexite_O3
+*/
@@ -0,0 +1,437 @@
+#ifndef DECOUPAGE_H
+#define DECOUPAGE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <omp.h>
+#include "../Simd.hpp"
+#include "../rabin_karp/RabinKarp.hpp"
+
+/*  Decoupage d'un flux en morceaux definis par le contenu (deduplication) :
+    une coupure est placee apres l'octet i quand une empreinte roulante de
+    la fenetre finissant en i a ses bits de masque nuls. Inserer ou retirer
+    des octets ne deplace que les coupures voisines : les autres morceaux
+    se retrouvent a l'identique d'un fichier a l'autre.
+
+        DECOUPAGE_RABIN     empreinte de Rabin (LBFS) : les 48 derniers
+                            octets vus comme un polynome sur GF(2), reduit
+                            modulo un polynome irreductible de degre 53 ;
+                            un octet = deux tables de 256 (sortant,
+                            reduction), xor et decalages
+        DECOUPAGE_GEAR      Gear (FastCDC) : h = 2 h + G[octet] ; le bit k
+                            ne depend que des k + 1 derniers octets, les
+                            masques prennent donc les bits de poids fort
+        DECOUPAGE_GEAR_SIMD meme Gear sur des blocs du texte coupes en L
+                            segments, G lu par gather : les positions dont
+                            l'empreinte passe le masque large sont notees
+                            dans un champ de bits, parcouru ensuite. Tout
+                            octet est hache, alors que Gear saute min - 64
+                            octets par morceau, et un gather coute ~1 cycle
+                            par voie : mesure (tp_decoupage), aucune isa ne
+                            rattrape la boucle scalaire (avx512 1.05 Go/s
+                            contre 1.42 pour Gear), d'ou Gear par defaut
+
+    Decoupage normalise (FastCDC) : pas de coupure avant min octets (les
+    min - fenetre premiers ne sont pas hashes), masque de b + normalisation
+    bits jusqu'a la taille moyenne 2^b, de b - normalisation bits ensuite,
+    coupure forcee a max. Le masque large est inclus dans l'etroit : les
+    candidats du premier sont un sur-ensemble, et la coupure ne depend que
+    des octets depuis le debut du morceau, ce qui rend les trois methodes
+    (Gear et Gear SIMD a l'identique) utilisables sur un flux par tampons.
+
+    Chaque morceau recoit une empreinte de 64 bits : hachage polynomial
+    modulo 2^61 - 1 (RabinKarp.hpp) de ses mots de 32 bits et de sa
+    longueur ; non cryptographique, une deduplication reelle confirme par
+    comparaison. */
+
+#ifndef DECOUPAGE_FENETRE_RABIN
+#define DECOUPAGE_FENETRE_RABIN 48
+#endif
+/* positions par bloc de candidats Gear (champ de bits de 32 Ko) */
+#ifndef DECOUPAGE_BLOC
+#define DECOUPAGE_BLOC (1 << 18)
+#endif
+/* taille minimale du tampon d'un Decoupeur avant de couper */
+#ifndef DECOUPAGE_TAMPON
+#define DECOUPAGE_TAMPON (1 << 22)
+#endif
+
+enum MethodeDecoupage { DECOUPAGE_RABIN, DECOUPAGE_GEAR, DECOUPAGE_GEAR_SIMD };
+
+static const char* const NOMS_DECOUPAGE[3] = {"rabin", "gear", "gear simd"};
+
+struct OptionsDecoupage {
+    MethodeDecoupage methode = DECOUPAGE_GEAR;
+    size_t min = 2048, moyenne = 8192, max = 65536;     /* moyenne : puissance de 2 */
+    int normalisation = 2;
+    Isa isa = ISA_AUTO;
+    bool empreintes = true;
+    uint64_t base = 0x9E3779B1;                         /* des empreintes, < 2^32 */
+};
+
+struct Morceau {
+    uint64_t debut;
+    uint32_t taille;
+    uint64_t empreinte;
+};
+
+namespace decoupage_detail {
+
+struct Masques {
+    size_t min, norm, max;
+    uint64_t etroit, large;
+};
+
+/* min >= 64 (fenetres Gear et Rabin), min <= moyenne <= max */
+inline Masques masques(const OptionsDecoupage& o) {
+    Masques k;
+    k.min = std::max(o.min, (size_t) 64);
+    k.max = std::max(o.max, k.min);
+    k.norm = std::min(std::max(o.moyenne, k.min), k.max);
+    int b = 63 - __builtin_clzll(std::max(o.moyenne, (size_t) 2));
+    int be = std::min(b + o.normalisation, 63), bl = std::max(b - o.normalisation, 1);
+    if (o.methode == DECOUPAGE_RABIN) {
+        k.etroit = (1ull << be) - 1;
+        k.large = (1ull << bl) - 1;
+    } else {
+        k.etroit = ~0ull << (64 - be);
+        k.large = ~0ull << (64 - bl);
+    }
+    return k;
+}
+
+/* G : 256 valeurs aleatoires fixes */
+inline const uint64_t* table_gear() {
+    static const std::vector<uint64_t> g = [] {
+        std::mt19937_64 gen(0x6765617200ull);
+        std::vector<uint64_t> t(256);
+        for (uint64_t& x : t) x = gen();
+        return t;
+    }();
+    return g.data();
+}
+
+/* h de la fenetre de 64 octets s[0 .. 64) */
+inline uint64_t gear_fenetre(const uint8_t* s, const uint64_t* G) {
+    uint64_t h = 0;
+    for (int i = 0; i < 64; i++) h = (h << 1) + G[s[i]];
+    return h;
+}
+
+/* Gear scalaire (FastCDC) : longueur du morceau en debut de s[0 .. n), n <= max */
+inline size_t coupure_gear(const uint8_t* s, size_t n, const Masques& k, const uint64_t* G) {
+    if (n <= k.min) return n;
+    size_t i = k.min - 64, f = std::min(n, k.norm);
+    uint64_t h = 0;
+    for (; i < k.min - 1; i++) h = (h << 1) + G[s[i]];
+    for (; i < f; i++) {
+        h = (h << 1) + G[s[i]];
+        if (!(h & k.etroit)) return i + 1;
+    }
+    for (; i < n; i++) {
+        h = (h << 1) + G[s[i]];
+        if (!(h & k.large)) return i + 1;
+    }
+    return n;
+}
+
+/*  arithmetique des polynomes sur GF(2) (bit k : coefficient de x^k),
+    POLYNOME irreductible de degre 53 */
+const uint64_t POLYNOME = 0x3DA3358B4DC173ull;
+const int DEGRE = 53;
+
+inline uint64_t modulo(uint64_t x) {
+    while (x >> DEGRE) x ^= POLYNOME << (63 - __builtin_clzll(x) - DEGRE);
+    return x;
+}
+
+/*  ajouter l'octet c : d x^8 + c mod POLYNOME ; les 8 bits qui depassent
+    le degre, d >> (DEGRE - 8), indexent leur reste (et s'annulent) */
+struct TablesRabin {
+    uint64_t reduction[256], sortant[256];
+
+    uint64_t ajouter(uint64_t d, uint8_t c) const {
+        return ((d << 8) | c) ^ reduction[d >> (DEGRE - 8)];
+    }
+
+    TablesRabin() {
+        for (uint64_t b = 0; b < 256; b++) reduction[b] = modulo(b << DEGRE) | (b << DEGRE);
+        /* octet sortant : b x^(8 (fenetre - 1)) */
+        for (int b = 0; b < 256; b++) {
+            uint64_t h = b;
+            for (int i = 0; i < DECOUPAGE_FENETRE_RABIN - 1; i++) h = ajouter(h, 0);
+            sortant[b] = h;
+        }
+    }
+};
+
+inline const TablesRabin& tables_rabin() {
+    static const TablesRabin t;
+    return t;
+}
+
+inline size_t coupure_rabin(const uint8_t* s, size_t n, const Masques& k, const TablesRabin& t) {
+    if (n <= k.min) return n;
+    const int W = DECOUPAGE_FENETRE_RABIN;
+    size_t i = k.min - W - 1, f = std::min(n, k.norm);
+    uint64_t d = 0;
+    /* W octets, le premier sortira au pas suivant */
+    for (; i < k.min - 1; i++) d = t.ajouter(d, s[i]);
+    for (; i < f; i++) {
+        d = t.ajouter(d ^ t.sortant[s[i - W]], s[i]);
+        if (!(d & k.etroit)) return i + 1;
+    }
+    for (; i < n; i++) {
+        d = t.ajouter(d ^ t.sortant[s[i - W]], s[i]);
+        if (!(d & k.large)) return i + 1;
+    }
+    return n;
+}
+
+/* r <- G[i] par voie, indices < 256 dans des voies de 64 bits, par
+   gather en avx2 et avx512 */
+template <class V>
+SIMD_EN_LIGNE void lire_gear(V& r, const uint64_t* G, const V& i) {
+    for (int j = 0; j < (int) (sizeof(V) / sizeof(uint64_t)); j++) r[j] = G[i[j]];
+}
+
+SIMD_EN_LIGNE_AVX2 void lire_gear(Simd<double, 4>::vu& r, const uint64_t* G, const Simd<double, 4>::vu& i) {
+    typedef long long v4di __attribute__((vector_size(32)));
+    r = (Simd<double, 4>::vu) __builtin_ia32_gatherdiv4di(v4di(), (const long long*) G, (v4di) i, v4di() - 1, 8);
+}
+
+SIMD_EN_LIGNE_AVX512 void lire_gear(Simd<double, 8>::vu& r, const uint64_t* G, const Simd<double, 8>::vu& i) {
+    typedef long long v8di __attribute__((vector_size(64)));
+    r = (Simd<double, 8>::vu) __builtin_ia32_gatherdiv8di(v8di(), G, (v8di) i, 0xFF, 8);
+}
+
+/*  bit p - 63 de bits pour chaque position p de [63, n) dont l'empreinte
+    Gear (fenetre s[p - 63 .. p]) passe le masque large, les 64 - d bits de
+    poids fort : h >> d nul, teste sans comparaison de vecteurs (avx512f
+    n'a pas de masque 64 bits -> vecteur) par le bit de signe de
+    (h >> d) - 1. La voie j parcourt le segment [63 + j seg, 63 +
+    (j + 1) seg) ; un test par 8 pas. */
+struct CandidatsGear {
+    const uint8_t* s;
+    size_t n;
+    int d;
+    const uint64_t* G;
+    uint64_t* bits;
+
+    void noter(size_t i, uint64_t h) const {
+        if (!(h >> d)) bits[i / 64] |= 1ull << (i % 64);
+    }
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        typedef typename Simd<double, L>::vu V;
+        const size_t nb = n > 63 ? n - 63 : 0, seg = nb / L;
+        if (seg > 0) {
+            uint64_t t[8][L];
+            for (int j = 0; j < L; j++) {
+                uint64_t h = 0;
+                for (size_t i = j * seg; i < j * seg + 63; i++) h = (h << 1) + G[s[i]];
+                t[0][j] = h;
+            }
+            V h;
+            memcpy(&h, t[0], sizeof(V));
+            size_t k = 0;
+            for (; k + 8 <= seg; k += 8) {
+                uint64_t e[L];
+                for (int j = 0; j < L; j++) memcpy(&e[j], s + j * seg + 63 + k, 8);
+                V ve, passe = V();
+                memcpy(&ve, e, sizeof(V));
+                #pragma GCC unroll 8
+                for (int r = 0; r < 8; r++) {
+                    V g, o = (ve >> (8 * r)) & 0xFF;
+                    lire_gear(g, G, o);
+                    h = (h << 1) + g;
+                    memcpy(t[r], &h, sizeof(V));
+                    passe |= (h >> d) - 1;
+                }
+                uint64_t p[L], ou = 0;
+                memcpy(p, &passe, sizeof(V));
+                for (int j = 0; j < L; j++) ou |= p[j];
+                if (ou >> 63) {
+                    for (int j = 0; j < L; j++) {
+                        for (int r = 0; r < 8; r++) noter(j * seg + k + r, t[r][j]);
+                    }
+                }
+            }
+            for (; k < seg; k++) {
+                memcpy(t[0], &h, sizeof(V));
+                for (int j = 0; j < L; j++) {
+                    t[0][j] = (t[0][j] << 1) + G[s[j * seg + 63 + k]];
+                    noter(j * seg + k, t[0][j]);
+                }
+                memcpy(&h, t[0], sizeof(V));
+            }
+        }
+        /* reste : nb - L seg < L positions */
+        for (size_t i = L * seg; i < nb; i++) noter(i, gear_fenetre(s + i, G));
+    }
+};
+
+/*  candidats Gear de s[0 .. n) par blocs de DECOUPAGE_BLOC positions,
+    calcules a la demande ; les requetes avancent (positions >= 63) */
+struct BlocCandidats {
+    const uint8_t* s;
+    size_t n;
+    uint64_t large;
+    Isa isa;
+    size_t deb = 0, fin = 0;
+    std::vector<uint64_t> bits;
+
+    BlocCandidats(const uint8_t* s, size_t n, uint64_t large, Isa isa)
+        : s(s), n(n), large(large), isa(isa), bits(DECOUPAGE_BLOC / 64 + 1) {}
+
+    void calculer(size_t i) {
+        deb = i;
+        fin = std::min(n, i + DECOUPAGE_BLOC);
+        std::fill(bits.begin(), bits.end(), 0);
+        CandidatsGear e = {s + deb - 63, fin - deb + 63, 64 - __builtin_popcountll(large), table_gear(), bits.data()};
+        lancer_simd<double>(e, isa);
+    }
+
+    /* premier candidat de [i, lim), lim sinon */
+    size_t suivant(size_t i, size_t lim) {
+        while (i < lim) {
+            if (i >= fin) calculer(i);
+            size_t f = std::min(lim, fin), r = i - deb, w = r / 64, nw = (f - deb + 63) / 64;
+            uint64_t x = bits[w] & (~0ull << (r % 64));
+            while (!x && ++w < nw) x = bits[w];
+            if (x) {
+                size_t j = deb + w * 64 + __builtin_ctzll(x);
+                if (j < f) return j;
+            }
+            i = f;
+        }
+        return lim;
+    }
+};
+
+/* meme coupure que coupure_gear, morceau en s[p ..], n = p + octets disponibles */
+inline size_t coupure_candidats(BlocCandidats& c, size_t p, size_t n, const Masques& k) {
+    if (n - p <= k.min) return n - p;
+    const uint64_t* G = table_gear();
+    size_t i = p + k.min - 1, f = p + std::min(n - p, k.norm);
+    for (; (i = c.suivant(i, f)) < f; i++) {
+        if (!(gear_fenetre(c.s + i - 63, G) & k.etroit)) return i + 1 - p;
+    }
+    i = c.suivant(f, n);
+    return (i < n ? i + 1 : n) - p;
+}
+
+} // namespace decoupage_detail
+
+/*  mots de 32 bits (le dernier complete par des zeros) modulo 2^61 - 1 :
+    sur 4 chaines de Horner en base Q (sans reduction, fois() accepte tout
+    h < 2^64), le mot 4 u + r d'un des U groupes de 16 octets compte pour
+    Q^(U - 1 - u + U (3 - r)) ; les chaines sont recombinees en base Q^U,
+    puis les mots restants et la longueur par Horner. Exposants distincts :
+    deux morceaux differents ont la meme empreinte avec probabilite
+    <= n / P pour Q aleatoire */
+inline uint64_t empreinte_morceau(const uint8_t* s, size_t n, uint64_t base) {
+    using namespace rk_detail;
+    uint64_t a[4] = {0, 0, 0, 0}, h = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint32_t w[4];
+        memcpy(w, s + i, 16);
+        for (int r = 0; r < 4; r++) a[r] = fois(a[r], base) + w[r];
+    }
+    const uint64_t qu = puissance_mod(base, i / 16);
+    for (int r = 0; r < 4; r++) h = reduire(mul_mod(h, qu) + reduire(a[r]));
+    for (; i < n; i += 4) {
+        uint32_t w = 0;
+        memcpy(&w, s + i, std::min((size_t) 4, n - i));
+        h = reduire(fois(h, base) + w);
+    }
+    return reduire(fois(h, base) + n);
+}
+
+/*  morceaux de s[0 .. n) (debuts decales de decalage) ajoutes a m, tant
+    qu'il reste au moins max octets ou que fin (dernier tampon du flux) ;
+    renvoie le nombre d'octets decoupes */
+inline size_t decouper_tampon(const uint8_t* s, size_t n, bool fin, uint64_t decalage, const OptionsDecoupage& o,
+                              std::vector<Morceau>& m) {
+    using namespace decoupage_detail;
+    const Masques k = masques(o);
+    BlocCandidats c(s, n, k.large, o.isa);
+    size_t p = 0;
+    while (p < n && (fin || n - p >= k.max)) {
+        size_t d = std::min(k.max, n - p), l;
+        if (o.methode == DECOUPAGE_RABIN) l = coupure_rabin(s + p, d, k, tables_rabin());
+        else if (o.methode == DECOUPAGE_GEAR) l = coupure_gear(s + p, d, k, table_gear());
+        else l = coupure_candidats(c, p, p + d, k);
+        m.push_back({decalage + p, (uint32_t) l, o.empreintes ? empreinte_morceau(s + p, l, o.base) : 0});
+        p += l;
+    }
+    return p;
+}
+
+/* s entier (fichier projete, ...) */
+inline std::vector<Morceau> decouper(const uint8_t* s, size_t n, const OptionsDecoupage& o = OptionsDecoupage()) {
+    std::vector<Morceau> m;
+    decouper_tampon(s, n, true, 0, o, m);
+    return m;
+}
+
+/*  flux par morceaux de taille quelconque : les octets sont accumules et
+    decoupes quand le tampon depasse DECOUPAGE_TAMPON (et 4 max) ; moins de
+    max octets restent en attente jusqu'a terminer() */
+struct Decoupeur {
+    OptionsDecoupage o;
+    std::vector<uint8_t> tampon;
+    uint64_t position = 0;      /* du premier octet du tampon dans le flux */
+
+    Decoupeur(const OptionsDecoupage& o = OptionsDecoupage()) : o(o) {}
+
+    void ajouter(const uint8_t* d, size_t n, std::vector<Morceau>& m) {
+        tampon.insert(tampon.end(), d, d + n);
+        if (tampon.size() >= std::max((size_t) DECOUPAGE_TAMPON, 4 * o.max)) consommer(false, m);
+    }
+
+    void terminer(std::vector<Morceau>& m) { consommer(true, m); }
+
+    void consommer(bool fin, std::vector<Morceau>& m) {
+        size_t c = decouper_tampon(tampon.data(), tampon.size(), fin, position, o, m);
+        tampon.erase(tampon.begin(), tampon.begin() + c);
+        position += c;
+    }
+};
+
+/* lecture par fread de taille octets (stdin, tube, ...) */
+inline std::vector<Morceau> decouper_flux(FILE* f, const OptionsDecoupage& o = OptionsDecoupage(),
+                                          size_t taille = 1 << 20) {
+    Decoupeur d(o);
+    std::vector<Morceau> m;
+    std::vector<uint8_t> b(taille);
+    size_t k;
+    while ((k = fread(b.data(), 1, taille, f)) > 0) d.ajouter(b.data(), k, m);
+    d.terminer(m);
+    return m;
+}
+
+/*  lot de fichiers projetes, un fichier par thread a la fois (dynamique :
+    tailles inegales) ; renvoie le nombre total d'octets, m[f] vide si le
+    fichier f ne peut etre projete */
+inline size_t decouper_fichiers(const std::vector<std::string>& chemins, std::vector<std::vector<Morceau>>& m,
+                                const OptionsDecoupage& o = OptionsDecoupage()) {
+    m.assign(chemins.size(), std::vector<Morceau>());
+    size_t total = 0;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+ : total)
+    for (size_t f = 0; f < chemins.size(); f++) {
+        FichierProjete p;
+        if (!projeter_fichier(chemins[f].c_str(), p)) continue;
+        m[f] = decouper(p.donnees, p.taille, o);
+        total += p.taille;
+    }
+    return total;
+}
+
+#endif // DECOUPAGE_H
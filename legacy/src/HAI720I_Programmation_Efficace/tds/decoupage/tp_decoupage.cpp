@@ -0,0 +1,185 @@
+/* decoupage defini par le contenu pour la deduplication : Rabin sur GF(2),
+   Gear / FastCDC normalise scalaire et vectoriel, fichiers projetes ou
+   flux, lots de fichiers sur les threads ; Go/s et taux de deduplication */
+#include "../EvalPerf.hpp"
+#include "Decoupage.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+#include <unordered_set>
+#include <cmath>
+
+bool ecrire_versions(const std::vector<std::string>&, size_t, std::mt19937_64&);
+bool memes_morceaux(const std::vector<Morceau>&, const std::vector<Morceau>&);
+void statistiques(const std::vector<Morceau>&, std::ofstream&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nsize_MB number_of_files number_of_loops output_file\n");
+        return -1;
+    }
+    size_t taille = (size_t) atoll(argv[1]) << 20;
+    int nb_fichiers = std::max(1, atoi(argv[2]));
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    int nb_threads = omp_get_max_threads();
+
+    /* versions successives d'un meme fichier : quelques insertions, suppressions et remplacements */
+    std::vector<std::string> chemins;
+    for (int f = 0; f < nb_fichiers; f++) chemins.push_back("decoupage_" + std::to_string(f) + ".bin");
+    if (!ecrire_versions(chemins, taille, gen)) {
+        printf("cannot write the files\n");
+        return -1;
+    }
+    FichierProjete p;
+    if (!projeter_fichier(chemins[0].c_str(), p)) {
+        printf("cannot map %s\n", chemins[0].c_str());
+        return -1;
+    }
+    fichier << nb_fichiers << " fichiers d'environ " << p.taille << " octets, " << nb_threads << " threads\n";
+
+    auto mesurer = [&](const std::string& nom, size_t octets, const std::function<void()>& g) {
+        double nbs = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            g();
+            PE.stop();
+            nbs += PE.nb_s();
+        }
+        fichier << "    " << nom << ": " << octets * number_of_loops / nbs * 1e-9 << " Go/s";
+    };
+    auto seul = [&](const std::function<void()>& g) {
+        return [&, g] {
+            omp_set_num_threads(1);
+            g();
+            omp_set_num_threads(nb_threads);
+        };
+    };
+
+    /* coupures seules, fichier projete, 1 thread */
+    OptionsDecoupage o;
+    o.empreintes = false;
+    std::vector<Morceau> ref;
+    fichier << "coupures (min " << o.min << ", moyenne " << o.moyenne << ", max " << o.max << ", normalisation "
+            << o.normalisation << ")\n";
+    for (int methode : {DECOUPAGE_RABIN, DECOUPAGE_GEAR}) {
+        o.methode = (MethodeDecoupage) methode;
+        std::vector<Morceau> m;
+        mesurer(NOMS_DECOUPAGE[methode], p.taille, [&] { m = decouper(p.donnees, p.taille, o); });
+        statistiques(m, fichier);
+        if (methode == DECOUPAGE_GEAR) ref = m;
+    }
+    o.methode = DECOUPAGE_GEAR_SIMD;
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        o.isa = (Isa) isa;
+        std::vector<Morceau> m;
+        mesurer(std::string(NOMS_DECOUPAGE[DECOUPAGE_GEAR_SIMD]) + ", " + NOMS_ISA[isa], p.taille,
+                [&] { m = decouper(p.donnees, p.taille, o); });
+        statistiques(m, fichier);
+        fichier << "        " << (memes_morceaux(m, ref) ? "memes coupures que gear" : "FAUX") << "\n";
+    }
+
+    /* avec empreintes ; flux lu par fread en tampons de 64 Ko */
+    o = OptionsDecoupage();
+    std::vector<Morceau> m;
+    mesurer("gear + empreintes", p.taille, [&] { m = decouper(p.donnees, p.taille, o); });
+    fichier << "\n";
+    std::vector<Morceau> flux;
+    mesurer("flux (fread), gear + empreintes", p.taille, [&] {
+        FILE* f = fopen(chemins[0].c_str(), "rb");
+        flux = decouper_flux(f, o, 1 << 16);
+        fclose(f);
+    });
+    fichier << ", " << (memes_morceaux(flux, m) ? "identique au fichier projete" : "FAUX") << "\n";
+
+    /* lot de fichiers */
+    size_t total = 0;
+    std::vector<std::vector<Morceau>> lot;
+    for (size_t f = 0; f < chemins.size(); f++) {
+        FichierProjete q;
+        if (projeter_fichier(chemins[f].c_str(), q)) total += q.taille;
+    }
+    fichier << "lot de " << nb_fichiers << " fichiers, " << total << " octets\n";
+    mesurer("1 thread", total, seul([&] { decouper_fichiers(chemins, lot, o); }));
+    fichier << "\n";
+    if (nb_threads > 1) {
+        mesurer(std::to_string(nb_threads) + " threads", total, [&] { decouper_fichiers(chemins, lot, o); });
+        fichier << "\n";
+    }
+    /* deduplication : octets des morceaux d'empreintes distinctes */
+    std::unordered_set<uint64_t> vues;
+    size_t uniques = 0, nb = 0;
+    for (const std::vector<Morceau>& l : lot) {
+        for (const Morceau& x : l) {
+            nb++;
+            if (vues.insert(x.empreinte).second) uniques += x.taille;
+        }
+    }
+    fichier << "    " << nb << " morceaux, " << vues.size() << " distincts, " << uniques << " octets uniques ("
+            << 100.0 * uniques / total << " %)\n";
+    fichier.close();
+    for (const std::string& c : chemins) remove(c.c_str());
+
+    return 0;
+}
+
+
+
+/* version 0 aleatoire, version f + 1 = version f avec 64 modifications de 1 a 100 octets */
+bool ecrire_versions(const std::vector<std::string>& chemins, size_t n, std::mt19937_64& gen) {
+    std::vector<uint8_t> v(n);
+    for (uint8_t& c : v) c = gen();
+    for (size_t f = 0; f < chemins.size(); f++) {
+        if (f > 0) {
+            for (int k = 0; k < 64; k++) {
+                size_t i = gen() % (v.size() + 1), l = 1 + gen() % 100;
+                std::vector<uint8_t> x(l);
+                for (uint8_t& c : x) c = gen();
+                int type = gen() % 3;
+                if (type == 0) v.insert(v.begin() + i, x.begin(), x.end());
+                else if (type == 1) v.erase(v.begin() + i, v.begin() + std::min(v.size(), i + l));
+                else std::copy(x.begin(), x.begin() + std::min(l, v.size() - i), v.begin() + i);
+            }
+        }
+        FILE* g = fopen(chemins[f].c_str(), "wb");
+        if (!g) return false;
+        bool ok = fwrite(v.data(), 1, v.size(), g) == v.size();
+        if (fclose(g) != 0 || !ok) return false;
+    }
+    return true;
+}
+
+bool memes_morceaux(const std::vector<Morceau>& a, const std::vector<Morceau>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].debut != b[i].debut || a[i].taille != b[i].taille || a[i].empreinte != b[i].empreinte) return false;
+    }
+    return true;
+}
+
+void statistiques(const std::vector<Morceau>& m, std::ofstream& fichier) {
+    double s = 0, s2 = 0;
+    for (const Morceau& x : m) {
+        s += x.taille;
+        s2 += (double) x.taille * x.taille;
+    }
+    double moy = s / m.size();
+    fichier << ", " << m.size() << " morceaux, taille moyenne " << moy << ", ecart type "
+            << sqrt(std::max(0.0, s2 / m.size() - moy * moy)) << "\n";
+}
+
+/*  commandes d'execution:
+    ./execs/tp_decoupage 256 4 3 decoupage_out.txt
+    OMP_NUM_THREADS=8 ./execs/tp_decoupage 128 16 3 decoupage_lot_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_decoupage.cpp -o execs/tp_decoupage
+*/
@@ -0,0 +1,412 @@
+#ifndef ELEMENTAIRES_H
+#define ELEMENTAIRES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+/*  Fonctions elementaires vectorisees (exp, log, sin, cos, tanh, erf) en
+    float et double, sur tableaux :
+
+        exp_simd(x, y, n)      y[i] = exp(x[i]), idem log_simd, sin_simd, ...
+
+    Chaque fonction = reduction d'argument + polynome minimax (Remez, erreur
+    relative, coefficients arrondis au type) evalue par Horner.hpp, sur des
+    vecteurs GCC de 16, 32 ou 64 octets. Les versions avx2 + fma et avx512f
+    sont compilees par attribut target et choisies a l'execution.
+
+    Reductions :
+        exp  x = k ln2 + r, |r| <= ln2/2 (Cody-Waite), exp(r) = 1 + r + r^2 Q(r),
+             2^k construit dans l'exposant en deux facteurs (sous-normaux)
+        log  x = 2^e m, m dans [sqrt(2)/2, sqrt(2)), f = m - 1, s = f / (2 + f),
+             log(1 + f) = f - (f^2/2 - s (f^2/2 + s^2 T(s^2))) (fdlibm)
+        sin, cos  x = k pi/2 + r, |r| <= pi/4, pi/2 en trois morceaux (en
+             double pour float) ;
+             sin r = r + r^3 S(r^2), cos r = 1 - r^2/2 + r^4 C(r^2)
+        tanh tanh |x| = e / (e + 2), e = expm1(2|x|) par la reduction de exp
+        erf  |x| < 0.84375 : x + x E(x^2) ; au-dela, par intervalles, erf
+             directement puis 1 - exp(-x^2) G(x), G = erfc(x) exp(x^2)
+
+    Erreur maximale mesuree (tp_elementaires, 10^6 points par domaine,
+    reference long double pour double et double pour float, en ulp) :
+                                      double    float
+        exp                           1.1       1.1     (1.6 / 1.5 si le
+                                                         resultat est sous-normal)
+        log                           0.75      0.75
+        sin, cos   |x| <= pi          1.5       1.4
+                   |x| <= SINCOS_MAX  2.4       1.5
+        tanh                          2.5       2.4     (libm : 2.2)
+        erf                           2.5       1.5
+    Au-dela de SINCOS_MAX, sin et cos passent voie par voie par la libm. Cas
+    speciaux (nan, +-inf, +-0, negatifs pour log) comme la libm. */
+
+#include "../Simd.hpp"
+#include "../Horner.hpp"
+
+#define ELEM_EN_LIGNE SIMD_EN_LIGNE
+
+enum Schema { SCHEMA_HORNER, SCHEMA_ESTRIN };
+enum FonctionElementaire { F_EXP, F_LOG, F_SIN, F_COS, F_TANH, F_ERF };
+
+/* coefficients obtenus par l'algorithme de Remez en precision etendue */
+template <class S> struct Constantes;
+
+template <> struct Constantes<double> {
+    static constexpr int MANTISSE = 52, BIAIS = 1023;
+    static constexpr double MAGIQUE = 0x1.8p52;     /* x + MAGIQUE arrondit x a l'entier */
+    static constexpr double LOG2E = 1.44269504088896338700e+00;
+    static constexpr double LN2_HI = 6.93147180369123816490e-01, LN2_LO = 1.90821492927058770002e-10;
+    static constexpr double EXP_MAX = 709.782712893383973096, EXP_MIN = -745.13321910194110842;
+    static constexpr double EXP_Q[10] = {
+        5.00000000000000111e-01, 1.66666666666666435e-01, 4.16666666666243440e-02, 8.33333333335617606e-03,
+        1.38888889171210326e-03, 1.98412697847134649e-04, 2.48015214231704712e-05, 2.75573554783120320e-06,
+        2.76200339299300743e-07, 2.50681711327757908e-08};
+    static constexpr double MIN_NORMAL = 2.2250738585072014e-308, ECHELLE_SOUS_NORMAL = 0x1p54;
+    static constexpr int EXPOSANT_SOUS_NORMAL = 54;
+    static constexpr double SQRT2 = 1.41421356237309504880;
+    static constexpr double LOG_T[7] = {
+        6.66666666666666963e-01, 3.99999999998991773e-01, 2.85714286261062933e-01, 2.22222111158305397e-01,
+        1.81828903676461651e-01, 1.53316840907653629e-01, 1.46168743666110101e-01};
+    static constexpr double DEUX_SUR_PI = 6.36619772367581382433e-01;
+    static constexpr double PIO2_1 = 1.57079632673412561417e+00, PIO2_2 = 6.07710050630396597660e-11,
+                            PIO2_3 = 2.02226624879595063154e-21;
+    static constexpr double SINCOS_MAX = 1e5;
+    static constexpr double SIN_S[6] = {
+        -1.66666666666666657e-01, 8.33333333333092542e-03, -1.98412698367278094e-04, 2.75573160886041398e-06,
+        -2.50511292631341718e-08, 1.59179619945334942e-10};
+    static constexpr double COS_C[6] = {
+        4.16666666666666644e-02, -1.38888888888873867e-03, 2.48015872987532276e-05, -2.75573172660803480e-07,
+        2.08761452226439397e-09, -1.13825646592640361e-11};
+    static constexpr double TANH_MAX = 22;
+    static constexpr double ERF_PETIT = 0.84375, ERF_MAX = 6;
+    static constexpr double ERF_E[11] = {
+        1.28379167095512559e-01, -3.76126389031830821e-01, 1.12837916709230601e-01, -2.68661706389218373e-02,
+        5.22397756201538940e-03, -8.54832315271528967e-04, 1.20551826826928571e-04, -1.49218338334835392e-05,
+        1.63987484870768374e-06, -1.56986385621153977e-07, 1.06901489041240475e-08};
+    /* intervalle 0 : erf(centre + t) ; suivants : erfc(centre + t) exp((centre + t)^2) */
+    static constexpr int ERF_NB = 4;
+    static constexpr double ERF_BORNES[ERF_NB] = {0.84375, 1.25, 2.25, 3.5};
+    static constexpr double ERF_CENTRES[ERF_NB] = {1.046875, 1.75, 2.875, 4.75};
+    static constexpr double ERF_TABLE[ERF_NB][15] = {
+        {8.61261425462075514e-01, 3.77130111403288004e-01, -3.94808085375317142e-01, 1.49833105783761883e-01,
+         5.31744288164179291e-02, -6.72167238022972208e-02, 9.27598822574495809e-03, 1.32294675561584526e-02,
+         -5.45011146635285357e-03, -1.30449059668410702e-03, 1.24203585956963905e-03, -2.28846296592712220e-05,
+         -1.84174886859248178e-04, 3.18646762973325196e-05, 1.91885419854690203e-05},
+        {2.84972234737436381e-01, -1.30976345514485032e-01, 5.57636300871021257e-02, -2.22599952413860824e-02,
+         8.40431920620497361e-03, -3.02097465276129776e-03, 1.03920455327127510e-03, -3.43533306265640106e-04,
+         1.09504893013374918e-04, -3.37560094083863693e-05, 1.00892788406608911e-05, -2.92361377772070534e-06,
+         8.18504681956811081e-07, -2.41361397906021457e-07, 7.37621432205530708e-08},
+        {1.86054934684471124e-01, -5.85632926598033954e-02, 1.76854682875347766e-02, -5.14504755546297057e-03,
+         1.44672828278343706e-03, -3.94281495941436588e-04, 1.04389662237536123e-04, -2.69032164029425115e-05,
+         6.76070373449390969e-06, -1.65909826666409012e-06, 3.98314050203716981e-07, -9.35540538433218301e-08,
+         2.11191888504938270e-08, -5.02299290341614585e-09, 1.48792731006378334e-09},
+        {1.16302707210248421e-01, -2.35034485981841131e-02, 4.66132636863443497e-03, -9.08098898182947267e-04,
+         1.73928305487996586e-04, -3.27757642425770431e-05, 6.08114972147390937e-06, -1.11156264910504374e-06,
+         2.00201066329920321e-07, -3.57450246449345533e-08, 6.17223607673507686e-09, -1.01590318707366797e-09,
+         2.94631170807282199e-10, 3.24971659878337725e-11, 2.13232213808169599e-11}};
+};
+
+template <> struct Constantes<float> {
+    static constexpr int MANTISSE = 23, BIAIS = 127;
+    static constexpr float MAGIQUE = 0x1.8p23f;
+    static constexpr float LOG2E = 1.44269504088896341f;
+    static constexpr float LN2_HI = 0.693359375f, LN2_LO = -2.12194440e-4f;
+    static constexpr float EXP_MAX = 88.7228394f, EXP_MIN = -103.972084f;
+    static constexpr float EXP_Q[5] = {5.000000000e-01f, 1.666657776e-01f, 4.166685417e-02f, 8.363140747e-03f,
+                                       1.390128513e-03f};
+    static constexpr float MIN_NORMAL = 1.17549435e-38f, ECHELLE_SOUS_NORMAL = 0x1p25f;
+    static constexpr int EXPOSANT_SOUS_NORMAL = 25;
+    static constexpr float SQRT2 = 1.41421356f;
+    static constexpr float LOG_T[3] = {6.666668653e-01f, 3.998876512e-01f, 2.958051264e-01f};
+    static constexpr float SINCOS_MAX = 1e5f;  /* reduction en double, cf. reduire_pi2 */
+    static constexpr float SIN_S[3] = {-1.666666418e-01f, 8.332745172e-03f, -1.958736102e-04f};
+    static constexpr float COS_C[3] = {4.166666418e-02f, -1.388830133e-03f, 2.454760761e-05f};
+    static constexpr float TANH_MAX = 9.01f;
+    static constexpr float ERF_PETIT = 0.84375f, ERF_MAX = 3.92f;
+    static constexpr float ERF_E[6] = {1.283791512e-01f, -3.761254251e-01f, 1.128252149e-01f, -2.679826319e-02f,
+                                       5.048347637e-03f, -6.317962543e-04f};
+    static constexpr int ERF_NB = 3;
+    static constexpr float ERF_BORNES[ERF_NB] = {0.84375f, 1.25f, 2.5f};
+    static constexpr float ERF_CENTRES[ERF_NB] = {1.046875f, 1.875f, 3.21f};
+    static constexpr float ERF_TABLE[ERF_NB][8] = {
+        {8.612614274e-01f, 3.771301210e-01f, -3.948081732e-01f, 1.498331130e-01f, 5.318584666e-02f,
+         -6.721554697e-02f, 8.831785992e-03f, 1.314390171e-02f},
+        {2.694300115e-01f, -1.180165485e-01f, 4.814799502e-02f, -1.849843189e-02f, 6.737938616e-03f,
+         -2.296433086e-03f, 8.150417125e-04f, -3.443777969e-04f},
+        {1.682442427e-01f, -4.825112969e-02f, 1.335805375e-02f, -3.580744844e-03f, 9.337866795e-04f,
+         -2.331012365e-04f, 5.532931391e-05f, -2.196089554e-05f}};
+};
+
+namespace elem_detail {
+
+template <Schema H, class V, class S, int N>
+ELEM_EN_LIGNE void polynome(V& r, const S (&c)[N], const V& x) {
+    if (H == SCHEMA_ESTRIN) Estrin<N>::f(r, c, x);
+    else Horner<N>::f(r, c, x);
+}
+
+/* au moins une voie vraie */
+template <class M> ELEM_EN_LIGNE bool une_voie(const M& m) {
+    uint64_t b[sizeof(M) / 8];
+    memcpy(b, &m, sizeof(M));
+    uint64_t r = 0;
+    for (size_t i = 0; i < sizeof(M) / 8; i++) r |= b[i];
+    return r != 0;
+}
+
+/*  resultat en premier argument, vecteurs par reference (Simd.hpp) ; le
+    resultat peut etre l'argument lui-meme, qui est lu avant d'etre ecrit */
+template <class S, int L> struct Noyaux {
+    typedef typename Simd<S, L>::v V;
+    typedef typename Simd<S, L>::vi VI;
+    typedef typename Simd<S, L>::vu VU;
+    typedef Constantes<S> K;
+    static const int BITS = 8 * sizeof(S);
+
+    /* y <- y avec le signe de x (y positif ou nul) */
+    static ELEM_EN_LIGNE void signer(V& y, const V& x) {
+        y = (V) ((VU) y | ((VU) x & ((VU() + 1) << (BITS - 1))));
+    }
+    static ELEM_EN_LIGNE void absolu(V& r, const V& x) { r = (V) ((VU) x & ~((VU() + 1) << (BITS - 1))); }
+
+    /* m ? a : b par masque binaire (m vaut 0 ou -1 par voie) */
+    static ELEM_EN_LIGNE void choisir(V& r, const VI& m, const V& a, const V& b) {
+        r = (V) (((VU) a & (VU) m) | ((VU) b & ~(VU) m));
+    }
+
+    /*  voie l : t[j[l] * pas], j < ERF_NB etant l'intervalle de erf contenant
+        a[l] ; une permutation de registre si les ERF_NB valeurs tiennent dans
+        un vecteur, des selections sinon (sse2 ne compare pas les entiers 64
+        bits : les masques viennent des comparaisons flottantes) */
+    static ELEM_EN_LIGNE void permuter(V& r, const S* t, int pas, const V& a, const VI& j) {
+        if (K::ERF_NB <= L) {
+            V v = V();
+            for (int l = 0; l < K::ERF_NB; l++) v[l] = t[l * pas];
+            r = __builtin_shuffle(v, j);
+            return;
+        }
+        r = V() + t[0];
+        for (int k = 1; k < K::ERF_NB; k++) choisir(r, (VI) (a >= K::ERF_BORNES[k]), V() + t[k * pas], r);
+    }
+
+    /* 2^k pour k dans l'intervalle des exposants normaux */
+    static ELEM_EN_LIGNE void puissance2(V& r, const VI& k) { r = (V) ((k + K::BIAIS) << K::MANTISSE); }
+
+    /* x arrondi a l'entier le plus proche, en flottant (r) et en entier (k) */
+    static ELEM_EN_LIGNE void arrondi(V& r, VI& k, const V& x) {
+        V t = x + K::MAGIQUE;
+        k = (VI) t - (VI) (V() + K::MAGIQUE);
+        r = t - K::MAGIQUE;
+    }
+
+    template <Schema H> static ELEM_EN_LIGNE void exp(V& y, const V& x) {
+        V hi = V() + K::EXP_MAX, lo = V() + K::EXP_MIN;
+        V xc = x > hi ? hi : x;
+        xc = xc < lo ? lo : xc;
+        VI k;
+        V kd, q;
+        arrondi(kd, k, xc * K::LOG2E);
+        V r = (xc - kd * K::LN2_HI) - kd * K::LN2_LO;
+        polynome<H>(q, K::EXP_Q, r);
+        V e = 1 + (r + r * r * q);
+        /* 2^k = 2^k1 2^k2 : chaque facteur reste normal jusqu'aux sous-normaux */
+        VI k1;
+        V inutile, p1, p2;
+        arrondi(inutile, k1, kd * (S) 0.5);
+        puissance2(p1, k1);
+        puissance2(p2, k - k1);
+        e = e * p1 * p2;
+        e = x > hi ? V() + (S) HUGE_VAL : e;
+        y = x < lo ? V() : e;
+    }
+
+    /* expm1(x) pour 0 <= x <= 2 TANH_MAX */
+    template <Schema H> static ELEM_EN_LIGNE void expm1_positif(V& y, const V& x) {
+        VI k;
+        V kd, q, d;
+        arrondi(kd, k, x * K::LOG2E);
+        V r = (x - kd * K::LN2_HI) - kd * K::LN2_LO;
+        polynome<H>(q, K::EXP_Q, r);
+        V p = r + r * r * q;
+        puissance2(d, k);
+        y = p * d + (d - 1);
+    }
+
+    template <Schema H> static ELEM_EN_LIGNE void log(V& y, const V& x) {
+        VI sous_normal = x < K::MIN_NORMAL;
+        V m0 = sous_normal ? x * K::ECHELLE_SOUS_NORMAL : x;
+        VU b = (VU) m0;
+        VI e = (VI) (b >> K::MANTISSE) - K::BIAIS - (sous_normal & K::EXPOSANT_SOUS_NORMAL);
+        VU masque = ((VU() + 1) << K::MANTISSE) - 1;
+        V m = (V) ((b & masque) | (VU) (V() + 1));
+        VI grand = m > K::SQRT2;
+        m = grand ? m * (S) 0.5 : m;
+        e = e - grand;
+        V f = m - 1;
+        V hfsq = (S) 0.5 * f * f;
+        V s = f / (2 + f);
+        V z = s * s;
+        V R;
+        polynome<H>(R, K::LOG_T, z);
+        R = z * R;
+        V ed = (V) ((VI) (V() + K::MAGIQUE) + e) - K::MAGIQUE;
+        V l = ed * K::LN2_HI + (f - (hfsq - (s * (hfsq + R) + ed * K::LN2_LO)));
+        l = x == (S) HUGE_VAL ? x : l;
+        l = x == 0 ? V() - (S) HUGE_VAL : l;
+        y = x >= 0 ? l : V() + (S) NAN;    /* negatifs et nan */
+    }
+
+    /* x = k pi/2 + r, pi/2 en trois morceaux (Cody-Waite) */
+    static ELEM_EN_LIGNE void reduire_pi2(V& r, VI& k, const V& x, double*) {
+        V kd;
+        arrondi(kd, k, x * K::DEUX_SUR_PI);
+        r = ((x - kd * K::PIO2_1) - kd * K::PIO2_2) - kd * K::PIO2_3;
+    }
+
+    /*  en float, les trois morceaux ne representent pi/2 qu'a 2^-47 pres : pres
+        d'un multiple de pi/2 l'erreur absolue k 2^-47 depasse l'ulp de r des
+        |x| ~ 1000. La reduction se fait donc en double. */
+    static ELEM_EN_LIGNE void reduire_pi2(V& r, VI& k, const V& x, float*) {
+        typedef Noyaux<double, L> D;
+        typedef Constantes<double> KD;
+        typename D::V xd = __builtin_convertvector(x, typename D::V);
+        typename D::VI kl;
+        typename D::V kd;
+        D::arrondi(kd, kl, xd * KD::DEUX_SUR_PI);
+        typename D::V rd = ((xd - kd * KD::PIO2_1) - kd * KD::PIO2_2) - kd * KD::PIO2_3;
+        k = __builtin_convertvector(kl, VI);
+        r = __builtin_convertvector(rd, V);
+    }
+
+    /* sinus (cosinus = faux) ou cosinus ; voies hors de SINCOS_MAX par la libm */
+    template <Schema H> static ELEM_EN_LIGNE void sincos(V& y, const V& x, bool cosinus) {
+        VI k;
+        V r, ps, pc, a;
+        reduire_pi2(r, k, x, (S*) 0);
+        V z = r * r;
+        polynome<H>(ps, K::SIN_S, z);
+        polynome<H>(pc, K::COS_C, z);
+        V s = r + r * z * ps;
+        V hz = (S) 0.5 * z;
+        V w = 1 - hz;
+        V c = w + (((1 - w) - hz) + z * z * pc);
+        VI q = k + (cosinus ? 1 : 0);
+        V t = (q & 1) != 0 ? c : s;
+        t = (V) ((VU) t ^ ((VU) (q & 2) << (BITS - 2)));
+        if (!cosinus) t = x == 0 ? x : t;    /* sin(-0) = -0 */
+        absolu(a, x);
+        VI loin = a > K::SINCOS_MAX;
+        if (une_voie(loin)) {
+            for (int i = 0; i < L; i++) {
+                if (loin[i]) t[i] = (S) (cosinus ? std::cos((double) x[i]) : std::sin((double) x[i]));
+            }
+        }
+        y = t;
+    }
+
+    template <Schema H> static ELEM_EN_LIGNE void tanh(V& y, const V& x) {
+        V a, e;
+        absolu(a, x);
+        a = a > K::TANH_MAX ? V() + K::TANH_MAX : a;
+        expm1_positif<H>(e, a + a);
+        V t = e / (e + 2);
+        signer(t, x);
+        y = t;
+    }
+
+    template <Schema H> static ELEM_EN_LIGNE void erf(V& y, const V& x) {
+        V a;
+        absolu(a, x);
+        VI petit = a < K::ERF_PETIT;
+        V t = V();
+        if (une_voie(petit)) {
+            V q;
+            polynome<H>(q, K::ERF_E, a * a);
+            t = a + a * q;
+        }
+        if (une_voie(~petit)) {
+            /* indice de l'intervalle de chaque voie, puis coefficients
+               choisis par permutation de registre (une par coefficient) */
+            const int N = sizeof(K::ERF_TABLE[0]) / sizeof(S);
+            VI j = VI();
+            for (int k = 1; k < K::ERF_NB; k++) j -= (VI) (a >= K::ERF_BORNES[k]);
+            V c[N];
+            #pragma GCC unroll 16
+            for (int i = 0; i < N; i++) permuter(c[i], &K::ERF_TABLE[0][i], N, a, j);
+            V centre, p, e, g;
+            permuter(centre, K::ERF_CENTRES, 1, a, j);
+            polynome<H>(p, c, a - centre);
+            exp<H>(e, -(a * a));
+            choisir(g, (VI) (a >= K::ERF_BORNES[1]), 1 - e * p, p);
+            g = a >= K::ERF_MAX ? V() + 1 : g;
+            t = petit ? t : g;
+        }
+        signer(t, x);
+        y = t;
+    }
+
+    template <int F, Schema H> static ELEM_EN_LIGNE void evaluer(V& y, const V& x) {
+        switch (F) {
+        case F_EXP: exp<H>(y, x); break;
+        case F_LOG: log<H>(y, x); break;
+        case F_SIN: sincos<H>(y, x, false); break;
+        case F_COS: sincos<H>(y, x, true); break;
+        case F_TANH: tanh<H>(y, x); break;
+        default: erf<H>(y, x);
+        }
+    }
+
+    /* y[i] = F(x[i]) ; la queue passe par un vecteur partiellement rempli */
+    template <int F, Schema H> static ELEM_EN_LIGNE void appliquer(const S* x, S* y, size_t n) {
+        size_t i = 0;
+        for (; i + L <= n; i += L) {
+            V v;
+            memcpy(&v, x + i, sizeof(V));
+            evaluer<F, H>(v, v);
+            memcpy(y + i, &v, sizeof(V));
+        }
+        if (i < n) {
+            V v = V() + 1;
+            memcpy(&v, x + i, (n - i) * sizeof(S));
+            evaluer<F, H>(v, v);
+            memcpy(y + i, &v, (n - i) * sizeof(S));
+        }
+    }
+};
+
+template <int F, Schema H, class S>
+SIMD_CIBLE_SSE2 void appliquer_sse2(const S* x, S* y, size_t n) {
+    Noyaux<S, 16 / sizeof(S)>::template appliquer<F, H>(x, y, n);
+}
+
+template <int F, Schema H, class S>
+SIMD_CIBLE_AVX2 void appliquer_avx2(const S* x, S* y, size_t n) {
+    Noyaux<S, 32 / sizeof(S)>::template appliquer<F, H>(x, y, n);
+}
+
+template <int F, Schema H, class S>
+SIMD_CIBLE_AVX512 void appliquer_avx512(const S* x, S* y, size_t n) {
+    Noyaux<S, 64 / sizeof(S)>::template appliquer<F, H>(x, y, n);
+}
+
+} // namespace elem_detail
+
+/*  y[i] = F(x[i]) sur le jeu d'instructions demande (le meilleur par
+    defaut) ; Estrin par defaut, Horner au choix pour comparer */
+template <int F, Schema H = SCHEMA_ESTRIN, class S>
+inline void appliquer_elementaire(const S* x, S* y, size_t n, Isa isa = ISA_AUTO) {
+    isa = isa_effective(isa);
+    if (isa == ISA_AVX512) elem_detail::appliquer_avx512<F, H>(x, y, n);
+    else if (isa == ISA_AVX2) elem_detail::appliquer_avx2<F, H>(x, y, n);
+    else elem_detail::appliquer_sse2<F, H>(x, y, n);
+}
+
+template <class S> inline void exp_simd(const S* x, S* y, size_t n, Isa isa = ISA_AUTO) { appliquer_elementaire<F_EXP>(x, y, n, isa); }
+template <class S> inline void log_simd(const S* x, S* y, size_t n, Isa isa = ISA_AUTO) { appliquer_elementaire<F_LOG>(x, y, n, isa); }
+template <class S> inline void sin_simd(const S* x, S* y, size_t n, Isa isa = ISA_AUTO) { appliquer_elementaire<F_SIN>(x, y, n, isa); }
+template <class S> inline void cos_simd(const S* x, S* y, size_t n, Isa isa = ISA_AUTO) { appliquer_elementaire<F_COS>(x, y, n, isa); }
+template <class S> inline void tanh_simd(const S* x, S* y, size_t n, Isa isa = ISA_AUTO) { appliquer_elementaire<F_TANH>(x, y, n, isa); }
+template <class S> inline void erf_simd(const S* x, S* y, size_t n, Isa isa = ISA_AUTO) { appliquer_elementaire<F_ERF>(x, y, n, isa); }
+
+#endif // ELEMENTAIRES_H
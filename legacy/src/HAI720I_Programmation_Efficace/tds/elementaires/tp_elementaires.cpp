@@ -0,0 +1,194 @@
+/* fonctions elementaires vectorisees : erreur en ulp contre la libm et
+   debit (cycles par element) compare a la libm, par jeu d'instructions */
+#include "../EvalPerf.hpp"
+#include "Elementaires.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+
+struct Domaine {
+    const char* nom;
+    double min, max;
+    bool logarithmique;     /* tirage uniforme sur log|x| (x > 0) */
+};
+
+template <class S> void mesurer_type(const char*, size_t, int, std::ofstream&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\narray_size number_of_loops output_file\n");
+        return -1;
+    }
+    size_t n = atol(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+
+    fichier << "jeu d'instructions disponible: " << NOMS_ISA[isa_disponible()] << "\n";
+    mesurer_type<double>("double", n, number_of_loops, fichier);
+    mesurer_type<float>("float", n, number_of_loops, fichier);
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* references : long double pour double, double pour float */
+template <class S> struct Reference;
+template <> struct Reference<double> {
+    typedef long double R;
+    static R f(int F, R x) {
+        switch (F) {
+        case F_EXP: return expl(x);
+        case F_LOG: return logl(x);
+        case F_SIN: return sinl(x);
+        case F_COS: return cosl(x);
+        case F_TANH: return tanhl(x);
+        default: return erfl(x);
+        }
+    }
+};
+template <> struct Reference<float> {
+    typedef double R;
+    static R f(int F, R x) {
+        switch (F) {
+        case F_EXP: return exp(x);
+        case F_LOG: return log(x);
+        case F_SIN: return sin(x);
+        case F_COS: return cos(x);
+        case F_TANH: return tanh(x);
+        default: return erf(x);
+        }
+    }
+};
+
+/* la libm dans le type S, sans vectorisation automatique */
+template <class S>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+void libm(int F, const S* x, S* y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        switch (F) {
+        case F_EXP: y[i] = std::exp(x[i]); break;
+        case F_LOG: y[i] = std::log(x[i]); break;
+        case F_SIN: y[i] = std::sin(x[i]); break;
+        case F_COS: y[i] = std::cos(x[i]); break;
+        case F_TANH: y[i] = std::tanh(x[i]); break;
+        default: y[i] = std::erf(x[i]); break;
+        }
+    }
+}
+
+/* erreur en ulp du type S, l'ulp etant pris au resultat exact */
+template <class S>
+double erreur_ulp(S y, typename Reference<S>::R r) {
+    typedef typename Reference<S>::R R;
+    if (std::isnan((R) y) && std::isnan(r)) return 0;
+    if ((R) y == r) return 0;
+    if (std::isinf(r) || std::isinf(y) || std::isnan(y)) return 1e30;
+    int e = std::max(std::ilogb((S) r), std::numeric_limits<S>::min_exponent - 1);
+    R ulp = std::ldexp((R) 1, e - (std::numeric_limits<S>::digits - 1));
+    return (double) (std::fabs((R) y - r) / ulp);
+}
+
+template <class S>
+void tirer(std::vector<S>& x, const Domaine& d, std::mt19937_64& gen) {
+    std::uniform_real_distribution<double> u(0, 1);
+    for (S& v : x) {
+        double t = u(gen);
+        if (d.logarithmique) v = (S) std::exp(std::log(d.min) + t * (std::log(d.max) - std::log(d.min)));
+        else v = (S) (d.min + t * (d.max - d.min));
+    }
+}
+
+typedef void (*Appel)(const void*, void*, size_t, Isa);
+template <int F, Schema H, class S> void appel(const void* x, void* y, size_t n, Isa isa) {
+    appliquer_elementaire<F, H>((const S*) x, (S*) y, n, isa);
+}
+
+template <class S>
+void mesurer_type(const char* type, size_t n, int number_of_loops, std::ofstream& fichier) {
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    const char* noms[6] = {"exp", "log", "sin", "cos", "tanh", "erf"};
+    Appel estrin[6] = {appel<F_EXP, SCHEMA_ESTRIN, S>, appel<F_LOG, SCHEMA_ESTRIN, S>,
+                       appel<F_SIN, SCHEMA_ESTRIN, S>, appel<F_COS, SCHEMA_ESTRIN, S>,
+                       appel<F_TANH, SCHEMA_ESTRIN, S>, appel<F_ERF, SCHEMA_ESTRIN, S>};
+    Appel horner[6] = {appel<F_EXP, SCHEMA_HORNER, S>, appel<F_LOG, SCHEMA_HORNER, S>,
+                       appel<F_SIN, SCHEMA_HORNER, S>, appel<F_COS, SCHEMA_HORNER, S>,
+                       appel<F_TANH, SCHEMA_HORNER, S>, appel<F_ERF, SCHEMA_HORNER, S>};
+    double exp_max = Constantes<S>::EXP_MAX, sc_max = Constantes<S>::SINCOS_MAX;
+    /* premier domaine : erreur ; dernier : debit */
+    std::vector<Domaine> domaines[6] = {
+        {{"[-1, 1]", -1, 1, false}, {"complet", -exp_max, exp_max, false}},
+        {{"[0.5, 2]", 0.5, 2, false}, {"complet", 1e-37, 1e37, true}},
+        {{"[-pi, pi]", -M_PI, M_PI, false}, {"[-SINCOS_MAX, SINCOS_MAX]", -sc_max, sc_max, false}},
+        {{"[-pi, pi]", -M_PI, M_PI, false}, {"[-SINCOS_MAX, SINCOS_MAX]", -sc_max, sc_max, false}},
+        {{"[-1, 1]", -1, 1, false}, {"[-10, 10]", -10, 10, false}},
+        {{"[-1, 1]", -1, 1, false}, {"[-6, 6]", -6, 6, false}},
+    };
+    std::vector<S> x(n), y(n), z(n);
+    Isa meilleure = isa_disponible();
+
+    for (int F = 0; F < 6; F++) {
+        fichier << type << " " << noms[F] << "\n";
+        for (const Domaine& d : domaines[F]) {
+            tirer(x, d, gen);
+            estrin[F](x.data(), y.data(), n, ISA_AUTO);
+            double pire = 0;
+            S pire_x = 0;
+            for (size_t i = 0; i < n; i++) {
+                double e = erreur_ulp(y[i], Reference<S>::f(F, x[i]));
+                if (e > pire) {
+                    pire = e;
+                    pire_x = x[i];
+                }
+            }
+            libm(F, x.data(), z.data(), n);
+            double pire_libm = 0;
+            for (size_t i = 0; i < n; i++) pire_libm = std::max(pire_libm, erreur_ulp(z[i], Reference<S>::f(F, x[i])));
+            fichier << "    " << d.nom << ": erreur max " << pire << " ulp (x=" << pire_x << "), libm "
+                    << pire_libm << " ulp\n";
+        }
+
+        /* debit sur le dernier domaine */
+        double nbc = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            libm(F, x.data(), z.data(), n);
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+        }
+        double libm_cpe = nbc / number_of_loops / n;
+        fichier << "    libm cycles/elem:" << libm_cpe << "\n";
+        for (int isa = ISA_SSE2; isa <= meilleure; isa++) {
+            for (int h = 0; h < 2; h++) {
+                Appel a = h ? horner[F] : estrin[F];
+                nbc = 0;
+                for (int k = 0; k < number_of_loops; k++) {
+                    PE.start();
+                    a(x.data(), y.data(), n, (Isa) isa);
+                    PE.stop();
+                    PE.nb_c();
+                    nbc += PE.nb_tot;
+                }
+                double cpe = nbc / number_of_loops / n;
+                fichier << "    " << (h ? "horner " : "estrin ")
+                        << NOMS_ISA[isa] << (isa == ISA_AVX512 ? "" : "  ")
+                        << " cycles/elem:" << cpe << " acceleration:" << libm_cpe / cpe << "\n";
+            }
+        }
+    }
+}
+
+/*  commandes d'execution:
+    ./execs/tp_elementaires 1000000 10 elementaires_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_elementaires.cpp -o execs/tp_elementaires
+*/
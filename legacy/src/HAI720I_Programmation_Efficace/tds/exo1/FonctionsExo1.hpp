@@ -0,0 +1,49 @@
+#ifndef FONCTIONS_EXO1_H
+#define FONCTIONS_EXO1_H
+
+#include <cstdint>
+
+/*  Fonctions de l'exercice 1 (consignes.pdf). Le mode de compilation decide
+    ce que le compilateur en voit :
+
+        -DEXO1_NOINLINE   definitions ici, jamais mises en ligne
+        -DEXO1_EN_LIGNE   definitions ici, mises en ligne a sa guise
+        (aucun)           declarations seules, definitions dans
+                          fonctions_exo1.cpp : appel hors unite de
+                          compilation, ou en ligne avec -flto
+
+    Avec -DEXO1_COMPTEURS, chaque execution du corps incremente exo1_appels :
+    hors ligne, c'est le nombre d'appels reellement faits. Le compteur est
+    un effet de bord : il empeche le compilateur de deduire que min, max et
+    square sont pures, donc de les sortir de la boucle. Les cycles se lisent
+    sur la version sans compteurs, les appels sur la version avec. */
+
+enum { APPEL_MIN, APPEL_MAX, APPEL_INCR, APPEL_SQUARE, NB_APPELS };
+
+inline uint64_t exo1_appels[NB_APPELS];
+
+#ifdef EXO1_COMPTEURS
+#define EXO1_COMPTER(k) (exo1_appels[k]++)
+#else
+#define EXO1_COMPTER(k) ((void) 0)
+#endif
+
+#if defined(EXO1_NOINLINE)
+#define EXO1_DEF __attribute__((noinline)) inline
+#elif defined(EXO1_EN_LIGNE)
+#define EXO1_DEF inline
+#endif
+
+#ifdef EXO1_DEF
+EXO1_DEF long min(long x, long y) { EXO1_COMPTER(APPEL_MIN); return x < y ? x : y; }
+EXO1_DEF long max(long x, long y) { EXO1_COMPTER(APPEL_MAX); return x > y ? x : y; }
+EXO1_DEF void incr(long* xp, long v) { EXO1_COMPTER(APPEL_INCR); *xp += v; }
+EXO1_DEF long square(long x) { EXO1_COMPTER(APPEL_SQUARE); return x * x; }
+#else
+long min(long x, long y);
+long max(long x, long y);
+void incr(long* xp, long v);
+long square(long x);
+#endif
+
+#endif // FONCTIONS_EXO1_H
@@ -0,0 +1,27 @@
+/* definitions hors unite de compilation de l'exercice 1 (mode par defaut
+   de FonctionsExo1.hpp, avec ou sans -flto) */
+#include "FonctionsExo1.hpp"
+
+#ifdef EXO1_DEF
+#error "fonctions_exo1.cpp ne se compile qu'en mode separe"
+#endif
+
+long min(long x, long y) {
+    EXO1_COMPTER(APPEL_MIN);
+    return x < y ? x : y;
+}
+
+long max(long x, long y) {
+    EXO1_COMPTER(APPEL_MAX);
+    return x > y ? x : y;
+}
+
+void incr(long* xp, long v) {
+    EXO1_COMPTER(APPEL_INCR);
+    *xp += v;
+}
+
+long square(long x) {
+    EXO1_COMPTER(APPEL_SQUARE);
+    return x * x;
+}
@@ -0,0 +1,168 @@
+/* exercice 1 : formes A, B et C de la boucle sur min/max/incr/square,
+   appels reellement faits et cycles par appel selon le mode de compilation
+   (noinline, en ligne, unite separee, LTO ; cf. FonctionsExo1.hpp) */
+#include "../EvalPerf.hpp"
+#include "FonctionsExo1.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+
+#if defined(EXO1_NOINLINE)
+#define MODE "noinline"
+#elif defined(EXO1_EN_LIGNE)
+#define MODE "en ligne"
+#elif defined(__OPTIMIZE__) && defined(EXO1_LTO)
+#define MODE "unite separee + LTO"
+#else
+#define MODE "unite separee"
+#endif
+
+/*  noipa : sans effet de bord, les formes seraient vues comme pures et
+    leurs appels deplaces hors de la zone mesuree */
+long forme_A(long, long);
+long forme_B(long, long);
+long forme_C(long, long);
+long reference(long, long);
+
+/* benchmark enregistre : forme et nombre d'appels attendu (min, max, incr,
+   square) pour N = |x - y| iterations, reponse de l'exercice */
+struct Benchmark {
+    const char* nom;
+    long (*f)(long, long);
+    int appels_n[NB_APPELS];    /* coefficient de N */
+    int appels_1[NB_APPELS];    /* constante */
+};
+
+const Benchmark BENCHMARKS[] = {
+    {"A: for (i = min(x,y); i < max(x,y); incr(&i,1))", forme_A, {0, 1, 1, 1}, {1, 1, 0, 0}},
+    {"B: for (i = max(x,y)-1; i >= min(x,y); incr(&i,-1))", forme_B, {1, 0, 1, 1}, {1, 1, 0, 0}},
+    {"C: low = min(x,y); high = max(x,y); for (i = low; ...)", forme_C, {0, 0, 1, 1}, {1, 1, 0, 0}},
+};
+const char* NOMS_APPELS[NB_APPELS] = {"min", "max", "incr", "square"};
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nx y number_of_loops output_file\n");
+        return -1;
+    }
+    long x = atol(argv[1]);
+    long y = atol(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    long N = x > y ? x - y : y - x;
+    EvalPerf PE;
+
+    fichier << "mode: " << MODE
+#ifdef EXO1_COMPTEURS
+            << " (avec compteurs)"
+#endif
+            << ", N=" << N << "\n";
+
+    double nbc_ref = 0;
+    long t_ref = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        t_ref = reference(x, y);
+        PE.stop();
+        PE.nb_c();
+        nbc_ref += PE.nb_tot;
+    }
+    nbc_ref /= number_of_loops;
+    fichier << "reference (boucle ecrite a la main): " << nbc_ref / N << " cycles/iteration\n";
+
+    for (const Benchmark& b : BENCHMARKS) {
+        double nbc = 0;
+        long t = 0;
+        for (int c = 0; c < NB_APPELS; c++) exo1_appels[c] = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            t = b.f(x, y);
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+        }
+        nbc /= number_of_loops;
+        double attendus = 0, mesures = 0;
+        fichier << "\n" << b.nom << (t == t_ref ? "" : " (ERREUR resultat)") << "\n";
+        fichier << "    cycles/iteration:" << nbc / N << "\n";
+        fichier << "    appels attendus / mesures:";
+        for (int c = 0; c < NB_APPELS; c++) {
+            long a = b.appels_n[c] * N + b.appels_1[c];
+            attendus += a;
+            mesures += (double) exo1_appels[c] / number_of_loops;
+            fichier << " " << NOMS_APPELS[c] << " " << a << "/";
+#ifdef EXO1_COMPTEURS
+            fichier << exo1_appels[c] / number_of_loops;
+#else
+            fichier << "-";
+#endif
+        }
+        fichier << "\n";
+        /* surcout par appel par rapport a la boucle ecrite a la main */
+#ifdef EXO1_COMPTEURS
+        double appels = mesures;
+#else
+        double appels = attendus;
+#endif
+        if (appels > 0) fichier << "    surcout cycles/appel:" << (nbc - nbc_ref) / appels << "\n";
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+__attribute__((noipa)) long forme_A(long x, long y) {
+    long t = 0;
+    for (long i = min(x, y); i < max(x, y); incr(&i, 1))
+        t += square(i);
+    return t;
+}
+
+__attribute__((noipa)) long forme_B(long x, long y) {
+    long t = 0;
+    for (long i = max(x, y) - 1; i >= min(x, y); incr(&i, -1))
+        t += square(i);
+    return t;
+}
+
+__attribute__((noipa)) long forme_C(long x, long y) {
+    long t = 0;
+    long low = min(x, y);
+    long high = max(x, y);
+    for (long i = low; i < high; incr(&i, 1))
+        t += square(i);
+    return t;
+}
+
+/*  forme C mise en ligne a la main ; la barriere vide sur t interdit au
+    compilateur de remplacer la boucle par la formule de la somme des carres */
+__attribute__((noipa)) long reference(long x, long y) {
+    long t = 0;
+    long low = x < y ? x : y, high = x < y ? y : x;
+    for (long i = low; i < high; i++) {
+        t += i * i;
+        __asm__ ("" : "+r" (t));
+    }
+    return t;
+}
+
+/*  commandes d'execution (x et y lus a l'execution, N = 1000000):
+    ./execs/tp_exo1_noinline 0 1000000 100 exo1_out_noinline.txt
+    ./execs/tp_exo1_en_ligne 0 1000000 100 exo1_out_en_ligne.txt
+    ./execs/tp_exo1_separe 0 1000000 100 exo1_out_separe.txt
+    ./execs/tp_exo1_lto 0 1000000 100 exo1_out_lto.txt
+    ./execs/tp_exo1_separe_compteurs 0 1000000 100 exo1_out_separe_compteurs.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -DEXO1_NOINLINE tp_exo1.cpp -o execs/tp_exo1_noinline
+    g++ -O2 -DEXO1_EN_LIGNE tp_exo1.cpp -o execs/tp_exo1_en_ligne
+    g++ -O2 tp_exo1.cpp fonctions_exo1.cpp -o execs/tp_exo1_separe
+    g++ -O2 -flto -DEXO1_LTO tp_exo1.cpp fonctions_exo1.cpp -o execs/tp_exo1_lto
+    ajouter -DEXO1_COMPTEURS (aux deux fichiers) pour compter les appels :
+    g++ -O2 -DEXO1_COMPTEURS tp_exo1.cpp fonctions_exo1.cpp -o execs/tp_exo1_separe_compteurs
+*/
@@ -0,0 +1,220 @@
+#ifndef EXPRESSIONS_H
+#define EXPRESSIONS_H
+
+#include <cstddef>
+#include <string>
+#include <map>
+#include <typeinfo>
+#include <type_traits>
+#include <utility>
+#include "../ModelePorts.hpp"
+
+/*  Expressions a la compilation pour l'exercice 2 (consignes.pdf) : une
+    expression ecrite naturellement,
+
+        const Var<0> a;  const Cst<1> un;
+        auto f1 = un - a * a * a * a;
+
+    n'est qu'un type (feuilles Var<I> et Cst<N> sans etat). evaluer<P>(f1, x)
+    le normalise puis l'evalue sur des double, des entiers ou des vecteurs
+    GCC (vector_size) :
+
+        - equilibrage : une chaine associative (a*b*c*d, s1+s2+...+s8) de
+          profondeur k devient un arbre de profondeur log2(k), soit plus
+          d'operations independantes par cycle ;
+        - sous-expressions communes : deux sous-arbres de meme type calculent
+          la meme valeur ; un noeud x op x n'evalue x qu'une fois, et les
+          autres repetitions sont des calculs identiques que le compilateur
+          fusionne (a*a*a*a devient t = a*a ; t*t).
+
+    L'equilibrage change l'ordre des operations, donc l'arrondi en flottant :
+    il n'est applique que sous la politique Reassociation, ou toujours pour
+    les entiers (addition et multiplication modulo 2^k sont associatives) ;
+    ceux-ci sont calcules en non signe, ou le debordement est defini.
+    Sous Strict, une expression flottante est evaluee telle qu'ecrite. */
+
+namespace expr {
+
+struct Strict {};
+struct Reassociation {};
+
+template <int I> struct Var {};
+template <int N> struct Cst {};
+
+struct OpAdd {
+    static const bool associatif = true;
+    static const ClasseOp classe = OP_FADD;
+    template <class T> static T appliquer(const T& a, const T& b) { return a + b; }
+};
+struct OpSub {
+    static const bool associatif = false;
+    static const ClasseOp classe = OP_FADD;
+    template <class T> static T appliquer(const T& a, const T& b) { return a - b; }
+};
+struct OpMul {
+    static const bool associatif = true;
+    static const ClasseOp classe = OP_FMUL;
+    template <class T> static T appliquer(const T& a, const T& b) { return a * b; }
+};
+
+template <class Op, class L, class R> struct Bin {};
+
+template <class E> struct EstExpr : std::false_type {};
+template <int I> struct EstExpr<Var<I>> : std::true_type {};
+template <int N> struct EstExpr<Cst<N>> : std::true_type {};
+template <class Op, class L, class R> struct EstExpr<Bin<Op, L, R>> : std::true_type {};
+
+template <class L, class R, class = typename std::enable_if<EstExpr<L>::value && EstExpr<R>::value>::type>
+Bin<OpAdd, L, R> operator+(L, R) { return {}; }
+template <class L, class R, class = typename std::enable_if<EstExpr<L>::value && EstExpr<R>::value>::type>
+Bin<OpSub, L, R> operator-(L, R) { return {}; }
+template <class L, class R, class = typename std::enable_if<EstExpr<L>::value && EstExpr<R>::value>::type>
+Bin<OpMul, L, R> operator*(L, R) { return {}; }
+
+/* type scalaire d'un vecteur GCC, le type lui-meme sinon */
+template <class T, class = void> struct Scalaire { typedef T type; };
+template <class T> struct Scalaire<T, decltype((void) std::declval<T>()[0])> {
+    typedef typename std::decay<decltype(std::declval<T>()[0])>::type type;
+};
+
+/* type des calculs : le non signe de meme taille pour les entiers (et les
+   vecteurs d'entiers), le type lui-meme sinon */
+template <class T, class = void> struct NonSigne { typedef T type; };
+template <class T> struct NonSigne<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+    typedef typename std::make_unsigned<T>::type type;
+};
+template <class T> struct NonSigne<T, typename std::enable_if<!std::is_integral<T>::value &&
+                                                              std::is_integral<typename Scalaire<T>::type>::value>::type> {
+    typedef typename std::make_unsigned<typename Scalaire<T>::type>::type U;
+    typedef U type __attribute__((vector_size(sizeof(T))));
+};
+
+template <class T, class P> struct Reassociable
+    : std::integral_constant<bool, std::is_same<P, Reassociation>::value ||
+                                   std::is_integral<typename Scalaire<T>::type>::value> {};
+
+namespace detail {
+
+template <class... E> struct Liste {};
+
+template <class A, class B> struct Concat;
+template <class... A, class... B> struct Concat<Liste<A...>, Liste<B...>> { typedef Liste<A..., B...> type; };
+
+/* feuilles d'une chaine de Op */
+template <class Op, class E> struct Aplatir { typedef Liste<E> type; };
+template <class Op, class L, class R> struct Aplatir<Op, Bin<Op, L, R>> {
+    typedef typename Concat<typename Aplatir<Op, L>::type, typename Aplatir<Op, R>::type>::type type;
+};
+
+/* les K premiers elements a gauche, le reste a droite */
+template <int K, class G, class D, bool fin = (K == 0)> struct Scinder;
+template <int K, class... G, class... D> struct Scinder<K, Liste<G...>, Liste<D...>, true> {
+    typedef Liste<G...> gauche;
+    typedef Liste<D...> droite;
+};
+template <int K, class... G, class X, class... D> struct Scinder<K, Liste<G...>, Liste<X, D...>, false>
+    : Scinder<K - 1, Liste<G..., X>, Liste<D...>> {};
+
+/* arbre equilibre sur les feuilles, dans leur ordre */
+template <class Op, class L> struct Arbre;
+template <class Op, class E> struct Arbre<Op, Liste<E>> { typedef E type; };
+template <class Op, class E, class F, class... Reste> struct Arbre<Op, Liste<E, F, Reste...>> {
+    typedef Scinder<(2 + (int) sizeof...(Reste)) / 2, Liste<>, Liste<E, F, Reste...>> S;
+    typedef Bin<Op, typename Arbre<Op, typename S::gauche>::type,
+                    typename Arbre<Op, typename S::droite>::type> type;
+};
+
+template <class E, bool reassocier> struct Normaliser { typedef E type; };
+template <class Op, class L, class R, bool reassocier> struct Normaliser<Bin<Op, L, R>, reassocier> {
+    typedef typename Normaliser<L, reassocier>::type L2;
+    typedef typename Normaliser<R, reassocier>::type R2;
+    typedef typename std::conditional<
+        reassocier && Op::associatif,
+        typename Arbre<Op, typename Concat<typename Aplatir<Op, L2>::type,
+                                           typename Aplatir<Op, R2>::type>::type>::type,
+        Bin<Op, L2, R2>>::type type;
+};
+
+template <class E> struct Eval;
+template <int I> struct Eval<Var<I>> {
+    template <class T> static T f(const T* v) { return v[I]; }
+};
+template <int N> struct Eval<Cst<N>> {
+    template <class T> static T f(const T*) { return T() + N; }
+};
+template <class Op, class L, class R> struct Eval<Bin<Op, L, R>> {
+    template <class T> static T f(const T* v) {
+        typedef typename NonSigne<T>::type C;
+        if (std::is_same<L, R>::value) {
+            C x = (C) Eval<L>::f(v);
+            return (T) Op::appliquer(x, x);
+        }
+        return (T) Op::appliquer((C) Eval<L>::f(v), (C) Eval<R>::f(v));
+    }
+};
+
+/* operations de l'arbre pour le modele de ports, un sous-arbre par type */
+template <class E> struct Ops {
+    static int ajouter(Noyau&, std::map<std::string, int>&) { return -1; }
+};
+template <class Op, class L, class R> struct Ops<Bin<Op, L, R>> {
+    static int ajouter(Noyau& k, std::map<std::string, int>& vus) {
+        std::string cle = typeid(Bin<Op, L, R>).name();
+        auto it = vus.find(cle);
+        if (it != vus.end()) return it->second;
+        int l = Ops<L>::ajouter(k, vus), r = Ops<R>::ajouter(k, vus);
+        std::vector<int> deps;
+        if (l >= 0) deps.push_back(l);
+        if (r >= 0 && r != l) deps.push_back(r);
+        return vus[cle] = k.op(Op::classe, deps);
+    }
+};
+
+} // namespace detail
+
+/* type effectivement evalue pour des valeurs T sous la politique P */
+template <class P, class T, class E> struct Forme {
+    typedef typename detail::Normaliser<E, Reassociable<T, P>::value>::type type;
+};
+
+template <class P, class E, class T, class... U>
+inline T evaluer(E, const T& a0, const U&... autres) {
+    const T v[] = {a0, autres...};
+    return detail::Eval<typename Forme<P, T, E>::type>::f(v);
+}
+
+/* corps d'une evaluation pour predire(), feuilles supposees en registres */
+template <class P, class T, class E>
+inline Noyau modele(E, const std::string& nom) {
+    Noyau k(nom);
+    std::map<std::string, int> vus;
+    detail::Ops<typename Forme<P, T, E>::type>::ajouter(k, vus);
+    return k;
+}
+
+/*  somme de terme(i) pour i < n : un accumulateur sous Strict en flottant,
+    sinon K accumulateurs combines en arbre (chaines de dependance K fois
+    plus courtes) */
+template <class P, int K = 4, class T, class F>
+inline T reduire(size_t n, T zero, F terme) {
+    if (!Reassociable<T, P>::value) {
+        T s = zero;
+        for (size_t i = 0; i < n; i++) s += terme(i);
+        return s;
+    }
+    T s[K];
+    for (int j = 0; j < K; j++) s[j] = zero;
+    size_t i = 0;
+    for (; i + K <= n; i += K) {
+        for (int j = 0; j < K; j++) s[j] += terme(i + j);
+    }
+    for (; i < n; i++) s[0] += terme(i);
+    for (int pas = 1; pas < K; pas *= 2) {
+        for (int j = 0; j + pas < K; j += 2 * pas) s[j] += s[j + pas];
+    }
+    return s[0];
+}
+
+} // namespace expr
+
+#endif // EXPRESSIONS_H
@@ -0,0 +1,201 @@
+/* exercice 2 : f1, f2, f3 et un polynome ecrit naivement, evalues tels
+   qu'ecrits (Strict) ou equilibres (Reassociation) ; latence par appel,
+   debit scalaire et vectoriel, et somme de ma_fonction_naive (exo6) */
+#include "../EvalPerf.hpp"
+#include "Expressions.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+using namespace expr;
+
+#ifdef __AVX__
+typedef double vdouble __attribute__((vector_size(32)));
+#else
+typedef double vdouble __attribute__((vector_size(16)));
+#endif
+const int LARGEUR = sizeof(vdouble) / sizeof(double);
+
+const Var<0> a;
+const Cst<1> un;
+const auto f1 = un - a * a * a * a;
+const auto f2 = (un + a * a) * (un - a) * (un + a);
+const auto f3 = (un - a * a) * (un + a * a);
+/* p0 + p1 a + ... + p7 a^7, coefficients en Var<1> ... Var<8> */
+const auto polynome = Var<1>() + Var<2>() * a + Var<3>() * a * a + Var<4>() * a * a * a
+                    + Var<5>() * a * a * a * a + Var<6>() * a * a * a * a * a
+                    + Var<7>() * a * a * a * a * a * a + Var<8>() * a * a * a * a * a * a * a;
+const double COEFS[8] = {0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1};
+
+template <class P, class E> double latence(E, long, double&);
+template <class P, class E> double debit_scalaire(E, const std::vector<double>&, std::vector<double>&);
+template <class P, class E> double debit_vectoriel(E, const std::vector<double>&, std::vector<double>&);
+template <class P> double naive_exo6(const std::vector<int>&, double, double&);
+template <class P> double naive_exo6_entier(const std::vector<int>&, uint32_t, uint32_t&);
+uint32_t puissance_entiere(uint32_t, size_t);
+template <class E> void comparer(const char*, E, long, int, std::ofstream&);
+
+double puits = 0;
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\narray_size number_of_loops output_file\n");
+        return -1;
+    }
+    int array_size = atoi(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+    srand(42);
+
+    comparer("f1 = 1 - a*a*a*a", f1, array_size, number_of_loops, fichier);
+    comparer("f2 = (1 + a*a) * (1 - a) * (1 + a)", f2, array_size, number_of_loops, fichier);
+    comparer("f3 = (1 - a*a) * (1 + a*a)", f3, array_size, number_of_loops, fichier);
+    comparer("polynome naif de degre 7", polynome, array_size, number_of_loops, fichier);
+
+    /* ma_fonction_naive : res += p[i] * pow(alpha, i) */
+    std::vector<int> p(array_size);
+    for (int i = 0; i < array_size; i++) p[i] = rand() % 30 + 1;
+    double c_strict = 0, c_reassoc = 0, c_entier = 0, r_strict = 0, r_reassoc = 0;
+    uint32_t r_entier = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        c_strict += naive_exo6<Strict>(p, 0.999, r_strict);
+        c_reassoc += naive_exo6<Reassociation>(p, 0.999, r_reassoc);
+        c_entier += naive_exo6_entier<Strict>(p, 6, r_entier);
+    }
+    fichier << "\nma_fonction_naive (cycles/element)\n";
+    fichier << "    double Strict:" << c_strict / number_of_loops << " (res " << r_strict << ")\n";
+    fichier << "    double Reassociation:" << c_reassoc / number_of_loops << " (res " << r_reassoc << ")\n";
+    fichier << "    uint32_t (toujours reassociee):" << c_entier / number_of_loops << " (res " << r_entier << ")\n";
+    fichier << "controle:" << puits << "\n";
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* cycles par appel de x <- f(x) : chaque appel attend le precedent */
+template <class P, class E>
+__attribute__((noinline)) double latence(E f, long n, double& x) {
+    EvalPerf PE;
+    PE.start();
+    for (long i = 0; i < n; i++) {
+        x = evaluer<P>(f, x, COEFS[0], COEFS[1], COEFS[2], COEFS[3], COEFS[4], COEFS[5], COEFS[6], COEFS[7]);
+    }
+    PE.stop();
+    PE.nb_c();
+    return PE.nb_tot / n;
+}
+
+/* cycles par element de y[i] = f(x[i]), sans vectorisation automatique */
+template <class P, class E>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+double debit_scalaire(E f, const std::vector<double>& x, std::vector<double>& y) {
+    EvalPerf PE;
+    PE.start();
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = evaluer<P>(f, x[i], COEFS[0], COEFS[1], COEFS[2], COEFS[3], COEFS[4], COEFS[5], COEFS[6], COEFS[7]);
+    }
+    PE.stop();
+    PE.nb_c();
+    return PE.nb_tot / x.size();
+}
+
+template <class P, class E>
+__attribute__((noinline)) double debit_vectoriel(E f, const std::vector<double>& x, std::vector<double>& y) {
+    vdouble c[8];
+    for (int j = 0; j < 8; j++) c[j] = vdouble() + COEFS[j];
+    EvalPerf PE;
+    PE.start();
+    size_t i = 0;
+    for (; i + LARGEUR <= x.size(); i += LARGEUR) {
+        vdouble v;
+        __builtin_memcpy(&v, &x[i], sizeof(v));
+        v = evaluer<P>(f, v, c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7]);
+        __builtin_memcpy(&y[i], &v, sizeof(v));
+    }
+    for (; i < x.size(); i++) {
+        y[i] = evaluer<P>(f, x[i], COEFS[0], COEFS[1], COEFS[2], COEFS[3], COEFS[4], COEFS[5], COEFS[6], COEFS[7]);
+    }
+    PE.stop();
+    PE.nb_c();
+    return PE.nb_tot / x.size();
+}
+
+template <class P>
+__attribute__((noinline)) double naive_exo6(const std::vector<int>& p, double alpha, double& res) {
+    EvalPerf PE;
+    PE.start();
+    res = reduire<P>(p.size(), 0.0, [&](size_t i) { return p[i] * pow(alpha, i); });
+    PE.stop();
+    PE.nb_c();
+    return PE.nb_tot / p.size();
+}
+
+/* modulo 2^32 : (int) pow(alpha, i) deborderait des i = 12 pour alpha = 6 */
+template <class P>
+__attribute__((noinline)) double naive_exo6_entier(const std::vector<int>& p, uint32_t alpha, uint32_t& res) {
+    EvalPerf PE;
+    PE.start();
+    res = reduire<P>(p.size(), (uint32_t) 0, [&](size_t i) { return (uint32_t) p[i] * puissance_entiere(alpha, i); });
+    PE.stop();
+    PE.nb_c();
+    return PE.nb_tot / p.size();
+}
+
+/* alpha^i modulo 2^32, par carres successifs */
+uint32_t puissance_entiere(uint32_t alpha, size_t i) {
+    uint32_t r = 1;
+    for (; i; i >>= 1, alpha *= alpha) {
+        if (i & 1) r *= alpha;
+    }
+    return r;
+}
+
+/* Strict contre Reassociation : mesures et modele de ports */
+template <class E>
+void comparer(const char* nom, E f, long n, int number_of_loops, std::ofstream& fichier) {
+    std::vector<double> x(n), y(n);
+    for (long i = 0; i < n; i++) x[i] = (rand() % 1000) / 1000.0;
+    double lat[2] = {0, 0}, ds[2] = {0, 0}, dv[2] = {0, 0}, x0 = 0.5, x1 = 0.5;
+    for (int k = 0; k < number_of_loops; k++) {
+        lat[0] += latence<Strict>(f, n, x0);
+        lat[1] += latence<Reassociation>(f, n, x1);
+        ds[0] += debit_scalaire<Strict>(f, x, y);
+        puits += y[n / 2];
+        ds[1] += debit_scalaire<Reassociation>(f, x, y);
+        puits += y[n / 2];
+        dv[0] += debit_vectoriel<Strict>(f, x, y);
+        puits += y[n / 2];
+        dv[1] += debit_vectoriel<Reassociation>(f, x, y);
+        puits += y[n / 2];
+    }
+    puits += x0 + x1;
+    fichier << "\n" << nom << "\n";
+    const char* pol[2] = {"Strict", "Reassociation"};
+    for (int r = 0; r < 2; r++) {
+        Noyau k = r == 0 ? modele<Strict, double>(f, pol[r]) : modele<Reassociation, double>(f, pol[r]);
+        Prediction h = predire(k, machine_haswell()), e2 = predire(k, machine_exercice2());
+        fichier << "    " << pol[r] << ": ops " << k.ops.size() << " profondeur " << h.profondeur
+                << " ILP " << h.ilp << " | exercice 2: " << e2.duree_isolee << " cycles, IPC "
+                << k.ops.size() / e2.duree_isolee << " | Haswell chemin critique " << h.duree_isolee
+                << " cycles\n";
+        fichier << "        mesure latence cycles/appel:" << lat[r] / number_of_loops
+                << " debit scalaire cycles/elem:" << ds[r] / number_of_loops
+                << " debit vectoriel (x" << LARGEUR << ") cycles/elem:" << dv[r] / number_of_loops << "\n";
+    }
+}
+
+/*  commandes d'execution:
+    ./execs/tp_exo2 100000 20 exo2_out.txt
+    ./execs/tp_exo2_avx2 100000 20 exo2_out_avx2.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_exo2.cpp -o execs/tp_exo2
+    g++ -O2 -mavx2 -mfma tp_exo2.cpp -o execs/tp_exo2_avx2
+*/
@@ -0,0 +1,181 @@
+#ifndef NOYAUX_FUSIONNES_H
+#define NOYAUX_FUSIONNES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+/*  Noyaux en flux de l'exercice 3 (consignes.pdf) :
+
+        z[i] = z[i] + u[i] * u[i] + x[i] * y[i] * z[i]
+
+    4 lectures et 1 ecriture de double par element. Variantes :
+        scalaire       : ordre ecrit, ((z + u*u) + (x*y)*z)
+        factorise      : z * (1 + x*y) + u*u, une forme qui se fond en
+                         deux fma et une multiplication
+        deroule        : scalaire deroule 4 fois
+        avx2/avx512    : 4 ou 8 elements par instruction, avec ou sans fma
+        flux           : avx + ecritures non temporelles (_mm*_stream_pd),
+                         evitent la lecture pour propriete de la ligne de z
+                         quand les tableaux ne tiennent pas dans le cache
+
+    Les versions scalaires ne sont pas vectorisees par le compilateur, pour
+    mesurer le code tel qu'il est ecrit. Les versions avx sont compilees par
+    attribut target : le programme tourne partout, l'appelant teste
+    __builtin_cpu_supports avant de les appeler. Les versions flux
+    demandent z aligne sur 64 octets au-dela d'un prologue scalaire. */
+
+#define NF_SCALAIRE __attribute__((noinline, optimize("no-tree-vectorize")))
+
+NF_SCALAIRE inline void fusion_scalaire(double* z, const double* u, const double* x,
+                                        const double* y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        z[i] = z[i] + u[i] * u[i] + x[i] * y[i] * z[i];
+    }
+}
+
+NF_SCALAIRE inline void fusion_factorisee(double* z, const double* u, const double* x,
+                                          const double* y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        z[i] = z[i] * (1.0 + x[i] * y[i]) + u[i] * u[i];
+    }
+}
+
+NF_SCALAIRE inline void fusion_deroulee(double* z, const double* u, const double* x,
+                                        const double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        double z0 = z[i], z1 = z[i+1], z2 = z[i+2], z3 = z[i+3];
+        z[i]   = (z0 + u[i]   * u[i])   + x[i]   * y[i]   * z0;
+        z[i+1] = (z1 + u[i+1] * u[i+1]) + x[i+1] * y[i+1] * z1;
+        z[i+2] = (z2 + u[i+2] * u[i+2]) + x[i+2] * y[i+2] * z2;
+        z[i+3] = (z3 + u[i+3] * u[i+3]) + x[i+3] * y[i+3] * z3;
+    }
+    for (; i < n; i++) {
+        z[i] = z[i] + u[i] * u[i] + x[i] * y[i] * z[i];
+    }
+}
+
+namespace nf_detail {
+
+/* queue (ou prologue) commune aux versions vectorielles */
+inline void queue(double* z, const double* u, const double* x, const double* y,
+                  size_t debut, size_t fin) {
+    for (size_t i = debut; i < fin; i++) {
+        z[i] = z[i] + u[i] * u[i] + x[i] * y[i] * z[i];
+    }
+}
+
+/* nombre d'elements a traiter avant que z + i soit aligne sur a octets */
+inline size_t prologue(const double* z, size_t n, size_t a) {
+    size_t p = ((a - ((uintptr_t) z % a)) % a) / sizeof(double);
+    return p < n ? p : n;
+}
+
+} // namespace nf_detail
+
+/*  sans fma : la contraction mul + add est interdite (avx512f implique fma
+    pour le compilateur) */
+#define NF_SANS_FMA optimize("fp-contract=off")
+
+__attribute__((noinline, target("avx2"), NF_SANS_FMA))
+inline void fusion_avx2(double* z, const double* u, const double* x,
+                        const double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vz = _mm256_loadu_pd(z + i), vu = _mm256_loadu_pd(u + i);
+        __m256d vxy = _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        __m256d t = _mm256_add_pd(vz, _mm256_mul_pd(vu, vu));
+        _mm256_storeu_pd(z + i, _mm256_add_pd(t, _mm256_mul_pd(vxy, vz)));
+    }
+    nf_detail::queue(z, u, x, y, i, n);
+}
+
+/* z + u*u et (x*y)*z + t : deux fma et une multiplication */
+__attribute__((noinline, target("avx2,fma")))
+inline void fusion_avx2_fma(double* z, const double* u, const double* x,
+                            const double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d vz = _mm256_loadu_pd(z + i), vu = _mm256_loadu_pd(u + i);
+        __m256d vxy = _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        __m256d t = _mm256_fmadd_pd(vu, vu, vz);
+        _mm256_storeu_pd(z + i, _mm256_fmadd_pd(vxy, vz, t));
+    }
+    nf_detail::queue(z, u, x, y, i, n);
+}
+
+/* deux vecteurs par tour : deux chaines independantes par iteration */
+__attribute__((noinline, target("avx2,fma")))
+inline void fusion_avx2_fma_deroulee(double* z, const double* u, const double* x,
+                                     const double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d z0 = _mm256_loadu_pd(z + i), z1 = _mm256_loadu_pd(z + i + 4);
+        __m256d u0 = _mm256_loadu_pd(u + i), u1 = _mm256_loadu_pd(u + i + 4);
+        __m256d xy0 = _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        __m256d xy1 = _mm256_mul_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+        __m256d t0 = _mm256_fmadd_pd(u0, u0, z0), t1 = _mm256_fmadd_pd(u1, u1, z1);
+        _mm256_storeu_pd(z + i, _mm256_fmadd_pd(xy0, z0, t0));
+        _mm256_storeu_pd(z + i + 4, _mm256_fmadd_pd(xy1, z1, t1));
+    }
+    nf_detail::queue(z, u, x, y, i, n);
+}
+
+__attribute__((noinline, target("avx2,fma")))
+inline void fusion_avx2_fma_flux(double* z, const double* u, const double* x,
+                                 const double* y, size_t n) {
+    size_t i = nf_detail::prologue(z, n, 32);
+    nf_detail::queue(z, u, x, y, 0, i);
+    for (; i + 4 <= n; i += 4) {
+        __m256d vz = _mm256_load_pd(z + i), vu = _mm256_loadu_pd(u + i);
+        __m256d vxy = _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+        __m256d t = _mm256_fmadd_pd(vu, vu, vz);
+        _mm256_stream_pd(z + i, _mm256_fmadd_pd(vxy, vz, t));
+    }
+    _mm_sfence();
+    nf_detail::queue(z, u, x, y, i, n);
+}
+
+__attribute__((noinline, target("avx512f"), NF_SANS_FMA))
+inline void fusion_avx512(double* z, const double* u, const double* x,
+                          const double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d vz = _mm512_loadu_pd(z + i), vu = _mm512_loadu_pd(u + i);
+        __m512d vxy = _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+        __m512d t = _mm512_add_pd(vz, _mm512_mul_pd(vu, vu));
+        _mm512_storeu_pd(z + i, _mm512_add_pd(t, _mm512_mul_pd(vxy, vz)));
+    }
+    nf_detail::queue(z, u, x, y, i, n);
+}
+
+__attribute__((noinline, target("avx512f")))
+inline void fusion_avx512_fma(double* z, const double* u, const double* x,
+                              const double* y, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d vz = _mm512_loadu_pd(z + i), vu = _mm512_loadu_pd(u + i);
+        __m512d vxy = _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+        __m512d t = _mm512_fmadd_pd(vu, vu, vz);
+        _mm512_storeu_pd(z + i, _mm512_fmadd_pd(vxy, vz, t));
+    }
+    nf_detail::queue(z, u, x, y, i, n);
+}
+
+__attribute__((noinline, target("avx512f")))
+inline void fusion_avx512_fma_flux(double* z, const double* u, const double* x,
+                                   const double* y, size_t n) {
+    size_t i = nf_detail::prologue(z, n, 64);
+    nf_detail::queue(z, u, x, y, 0, i);
+    for (; i + 8 <= n; i += 8) {
+        __m512d vz = _mm512_load_pd(z + i), vu = _mm512_loadu_pd(u + i);
+        __m512d vxy = _mm512_mul_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+        __m512d t = _mm512_fmadd_pd(vu, vu, vz);
+        _mm512_stream_pd(z + i, _mm512_fmadd_pd(vxy, vz, t));
+    }
+    _mm_sfence();
+    nf_detail::queue(z, u, x, y, i, n);
+}
+
+#endif // NOYAUX_FUSIONNES_H
@@ -0,0 +1,126 @@
+/* exercice 3 : noyaux en flux z[i] += u[i]*u[i] + x[i]*y[i]*z[i], cycles et
+   octets par element mesures, a cote de l'IPC predit par le modele de ports */
+#include "../EvalPerf.hpp"
+#include "../ModelePorts.hpp"
+#include "NoyauxFusionnes.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+typedef void (*noyau_t)(double*, const double*, const double*, const double*, size_t);
+
+struct Variante {
+    const char* nom;
+    noyau_t f;
+    int isa;            /* extension requise, cf. supporte() */
+    int largeur;        /* doubles par vecteur */
+    int chaines;        /* vecteurs (ou elements) independants par tour */
+    bool fma, factorise;
+};
+
+bool supporte(int);
+double* allouer(size_t);
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\narray_size number_of_loops output_file\n");
+        return -1;
+    }
+    size_t array_size = atol(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+    EvalPerf PE;
+    srand(42);
+
+    double *u = allouer(array_size), *x = allouer(array_size), *y = allouer(array_size);
+    double *z0 = allouer(array_size), *z = allouer(array_size), *ref = allouer(array_size);
+    for (size_t i = 0; i < array_size; i++) {
+        /* x*y < 0.01 : z reste borne d'un passage a l'autre */
+        u[i] = (rand() % 1000) / 1000.0;
+        x[i] = (rand() % 100) / 1000.0;
+        y[i] = (rand() % 100) / 1000.0;
+        z0[i] = ref[i] = (rand() % 1000) / 1000.0;
+    }
+    fusion_scalaire(ref, u, x, y, array_size);
+
+    Variante variantes[] = {
+        {"scalaire", fusion_scalaire, 0, 1, 1, false, false},
+        {"scalaire factorise", fusion_factorisee, 0, 1, 1, false, true},
+        {"scalaire deroule x4", fusion_deroulee, 0, 1, 4, false, false},
+        {"avx2 sans fma", fusion_avx2, 1, 4, 1, false, false},
+        {"avx2 fma", fusion_avx2_fma, 2, 4, 1, true, false},
+        {"avx2 fma deroule x2", fusion_avx2_fma_deroulee, 2, 4, 2, true, false},
+        {"avx2 fma flux", fusion_avx2_fma_flux, 2, 4, 1, true, false},
+        {"avx512 sans fma", fusion_avx512, 3, 8, 1, false, false},
+        {"avx512 fma", fusion_avx512_fma, 3, 8, 1, true, false},
+        {"avx512 fma flux", fusion_avx512_fma_flux, 3, 8, 1, true, false},
+    };
+    /* 4 lectures + 1 ecriture utiles par element */
+    const double octets = 5 * sizeof(double);
+    fichier << "n=" << array_size << " (" << octets * array_size / 1e6 << " Mo par passage)\n";
+
+    for (const Variante& v : variantes) {
+        if (!supporte(v.isa)) {
+            fichier << v.nom << ": non supporte par ce processeur\n";
+            continue;
+        }
+        /* un passage depuis z0 pour comparer au scalaire */
+        for (size_t i = 0; i < array_size; i++) z[i] = z0[i];
+        v.f(z, u, x, y, array_size);
+        double erreur = 0;
+        for (size_t i = 0; i < array_size; i++) {
+            erreur = std::max(erreur, fabs(z[i] - ref[i]) / fabs(ref[i]));
+        }
+
+        double nbc = 0, nbs = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            v.f(z, u, x, y, array_size);
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+            nbs += PE.nb_s();
+        }
+        double cycles = nbc / number_of_loops / array_size;
+        Noyau k = modele_exo3(v.nom, v.largeur, v.chaines, v.fma, v.factorise);
+        fichier << "\n" << v.nom << " (erreur relative max " << erreur << ")\n";
+        fichier << "    octets/cycle:" << octets / cycles
+                << " Go/s:" << octets * array_size * number_of_loops / nbs / 1e9 << "\n";
+        afficher_prediction(fichier, k, v.largeur == 8 ? machine_skylake_avx512() : machine_haswell(),
+                            cycles);
+    }
+    fichier.close();
+
+    free(u); free(x); free(y); free(z0); free(z); free(ref);
+    return 0;
+}
+
+
+
+double* allouer(size_t n) {
+    return (double*) aligned_alloc(64, ((n * sizeof(double) + 63) / 64) * 64);
+}
+
+/* 0 : x86-64 de base, 1 : avx2, 2 : avx2 + fma, 3 : avx512f */
+bool supporte(int isa) {
+    __builtin_cpu_init();
+    switch (isa) {
+    case 1: return __builtin_cpu_supports("avx2");
+    case 2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case 3: return __builtin_cpu_supports("avx512f");
+    default: return true;
+    }
+}
+
+/*  commandes d'execution:
+    ./execs/tp_exo3 4096 100000 exo3_out_l1.txt
+    ./execs/tp_exo3 4194304 50 exo3_out_memoire.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_exo3.cpp -o execs/tp_exo3
+*/
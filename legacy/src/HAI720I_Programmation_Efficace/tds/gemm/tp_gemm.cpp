@@ -0,0 +1,168 @@
+/* produit de matrices : naif, par blocs, puis recopie en panneaux et
+   micro-noyau vectoriel, en GFLOP/s et en pourcentage du pic pour des
+   formes carrees et etroites */
+#include "../EvalPerf.hpp"
+#include "../Gemm.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+void gemm_naif(Matrice&, const Matrice&, const Matrice&);
+double pic_par_cycle(Isa);
+double pic_mesure(Isa);
+double ecart_max(const Matrice&, const Matrice&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\nmatrix_size number_of_loops output_file\n");
+        return -1;
+    }
+    int n = atoi(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> u(-1, 1);
+    int nb_threads = omp_get_max_threads();
+
+    struct Forme {
+        const char* nom;
+        int M, N, K;
+    };
+    Forme formes[4] = {
+        {"carree", n, n, n},
+        {"haute et etroite", 16 * n, 64, 64},
+        {"large et basse", 64, 16 * n, 64},
+        {"produit interne", 64, 64, 16 * n},
+    };
+    /*  pic par coeur et par cycle rdtsc : mesure sur une boucle de fma
+        independantes (cycles rdtsc : en turbo, il depasse la valeur
+        theorique, et certains processeurs n'ont qu'une unite fma 512 bits) */
+    double pic[4];
+    fichier << "pic par coeur, flops/cycle (theorique, mesure) :";
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        pic[isa] = pic_mesure((Isa) isa);
+        fichier << " " << NOMS_ISA[isa] << " (" << pic_par_cycle((Isa) isa) << ", " << pic[isa] << ")";
+    }
+    fichier << " ; " << nb_threads << " threads\n";
+    Isa meilleure = isa_effective(ISA_AUTO);
+
+    for (const Forme& f : formes) {
+        Matrice A(f.M, f.K), B(f.K, f.N), C(f.M, f.N), R(f.M, f.N);
+        for (double& x : A.v) x = u(gen);
+        for (double& x : B.v) x = u(gen);
+        gemm_bloque(R, A, B);
+        double N = flops_gemm(f.M, f.N, f.K);
+        fichier << f.nom << " M=" << f.M << " N=" << f.N << " K=" << f.K << "\n";
+
+        struct Variante {
+            std::string nom;
+            std::function<void()> g;
+            double pic;
+        };
+        std::vector<Variante> variantes;
+        if (f.M == n && (double) n * n * n <= 1e9) {
+            variantes.push_back({"naif i-j-k", [&] { gemm_naif(C, A, B); }, pic[meilleure]});
+        }
+        variantes.push_back({"par blocs", [&] { gemm_bloque(C, A, B); }, pic[meilleure]});
+        for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+            Isa i = (Isa) isa;
+            variantes.push_back({std::string("panneaux ") + NOMS_ISA[isa] + ", 1 thread", [&, i] {
+                omp_set_num_threads(1);
+                gemm_packe(f.M, f.N, f.K, 1, A.v.data(), f.K, B.v.data(), f.N, 0, C.v.data(), f.N, i);
+                omp_set_num_threads(nb_threads);
+            }, pic[i]});
+        }
+        if (nb_threads > 1) {
+            variantes.push_back({"panneaux, " + std::to_string(nb_threads) + " threads", [&] { gemm(C, A, B); },
+                                 pic[meilleure] * nb_threads});
+        }
+        for (const Variante& va : variantes) {
+            double nbc = 0, nbs = 0;
+            for (int k = 0; k < number_of_loops; k++) {
+                PE.start();
+                va.g();
+                PE.stop();
+                PE.nb_c();
+                nbc += PE.nb_tot;
+                nbs += PE.nb_s();
+            }
+            PE.nb_tot = nbc / number_of_loops;
+            double flops_par_cycle = PE.cpi(N);
+            fichier << "    " << va.nom << ": " << nbs / number_of_loops * 1e3 << " ms, "
+                    << N / (nbs / number_of_loops) * 1e-9 << " GFLOP/s, " << flops_par_cycle << " flops/cycle, "
+                    << 100 * flops_par_cycle / va.pic << " % du pic mesure, ecart " << ecart_max(C, R) << "\n";
+        }
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+void gemm_naif(Matrice& C, const Matrice& A, const Matrice& B) {
+    for (int i = 0; i < A.lignes; i++) {
+        for (int j = 0; j < B.colonnes; j++) {
+            double s = 0;
+            for (int k = 0; k < A.colonnes; k++) s += A[i][k] * B[k][j];
+            C[i][j] = s;
+        }
+    }
+}
+
+/*  flops par cycle et par coeur : sse2 sans fma, une addition et une
+    multiplication de 2 doubles ; avx2 et avx512, deux fma de 4 ou 8 */
+double pic_par_cycle(Isa isa) {
+    return isa == ISA_AVX512 ? 32 : isa == ISA_AVX2 ? 16 : 4;
+}
+
+/* 16 chaines de fma independantes (latence 4 x 2 unites = 8 en vol au moins) */
+struct BouclePic {
+    long tours;
+    double* sortie;
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        typedef typename Simd<double, L>::v V;
+        V acc[16], x = V() + 1.0000001, y = V() + 1e-9;
+        for (int i = 0; i < 16; i++) acc[i] = V() + i;
+        for (long t = 0; t < tours; t++) {
+            #pragma GCC unroll 16
+            for (int i = 0; i < 16; i++) acc[i] = acc[i] * x + y;
+        }
+        double s = 0;
+        for (int i = 0; i < 16; i++) s += acc[i][0];
+        *sortie = s;
+    }
+};
+
+double pic_mesure(Isa isa) {
+    EvalPerf PE;
+    double s;
+    BouclePic b = {1 << 20, &s};
+    lancer_simd<double>(b, isa);
+    PE.start();
+    lancer_simd<double>(b, isa);
+    PE.stop();
+    PE.nb_c();
+    return PE.cpi(2.0 * 16 * voies<double>(isa) * b.tours);
+}
+
+double ecart_max(const Matrice& X, const Matrice& Y) {
+    double e = 0;
+    for (size_t i = 0; i < X.v.size(); i++) e = std::max(e, fabs(X.v[i] - Y.v[i]));
+    return e;
+}
+
+/*  commandes d'execution:
+    ./execs/tp_gemm 1024 5 gemm_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_gemm.cpp -o execs/tp_gemm
+*/
@@ -0,0 +1,155 @@
+/* noyau de graphe CSR : debit de construction, de chargement et de parcours
+   selon la numerotation des sommets */
+#include "../EvalPerf.hpp"
+#include "../Graphe.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <random>
+
+uint64_t parcours_voisins(const Graphe&);
+uint64_t parcours_largeur(const Graphe&, sommet_t, std::vector<sommet_t>&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nlog2_nb_vertices edge_factor number_of_loops output_file [graph_file]\n");
+        return -1;
+    }
+    int echelle = atoi(argv[1]);
+    int facteur = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    const char* chemin = argc > 5 ? argv[5] : "graphe.bin";
+    uint32_t n = 1u << echelle;
+    uint64_t m = (uint64_t) facteur * n;
+    EvalPerf PE;
+
+    std::vector<Arete> aretes = aretes_rmat(n, m, 42);
+    OptionsConstruction opt;
+    opt.symetriser = true;
+    opt.boucles = false;
+    opt.dedoublonner = true;
+
+    /* construction : arcs inseres par seconde */
+    Graphe g;
+    double nbs_construction = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        g = construire_csr(n, aretes, true, opt);
+        PE.stop();
+        nbs_construction += PE.nb_s();
+    }
+    nbs_construction /= number_of_loops;
+    fichier << "graphe: n=" << g.n << " m=" << g.m << " threads=" << omp_get_max_threads() << "\n";
+    fichier << "construction nbs:" << nbs_construction << "\n";
+    fichier << "construction aretes/s:" << aretes.size() / nbs_construction << "\n";
+
+    PE.start();
+    Graphe gt = transposee(g);
+    PE.stop();
+    fichier << "transposee nbs:" << PE.nb_s() << "\n";
+
+    /* sauvegarde puis chargement par projection memoire */
+    PE.start();
+    bool ok = sauvegarder_graphe(g, chemin);
+    PE.stop();
+    fichier << "sauvegarde nbs:" << PE.nb_s() << (ok ? "" : " (echec)") << "\n";
+    Graphe charge;
+    PE.start();
+    ok = charger_graphe(chemin, charge);
+    PE.stop();
+    PE.nb_c();
+    fichier << "chargement nbc:" << PE.nb_tot << (ok ? "" : " (echec)") << "\n";
+    if (ok && parcours_voisins(charge) != parcours_voisins(g)) {
+        printf("graphe charge different du graphe sauvegarde\n");
+    }
+
+    /* parcours selon la numerotation : aleatoire, degre, Cuthill-McKee inverse */
+    std::vector<sommet_t> hasard(n);
+    for (uint32_t u = 0; u < n; u++) hasard[u] = u;
+    std::shuffle(hasard.begin(), hasard.end(), std::mt19937(7));
+    std::vector<std::pair<const char*, Graphe>> versions;
+    versions.push_back({"aleatoire", renumeroter(g, hasard)});
+    PE.start();
+    std::vector<sommet_t> rang_degre = ordre_degre(versions[0].second);
+    PE.stop();
+    fichier << "ordre degre nbs:" << PE.nb_s() << "\n";
+    PE.start();
+    std::vector<sommet_t> rang_bfs = ordre_bfs(versions[0].second);
+    PE.stop();
+    fichier << "ordre bfs nbs:" << PE.nb_s() << "\n";
+    versions.push_back({"degre", renumeroter(versions[0].second, rang_degre)});
+    versions.push_back({"bfs", renumeroter(versions[0].second, rang_bfs)});
+
+    std::vector<sommet_t> file;
+    for (auto& ver : versions) {
+        double nbs_voisins = 0, nbs_largeur = 0;
+        uint64_t arcs = 0, controle = 0;
+        /* source : le sommet de plus fort degre, le meme dans chaque version */
+        sommet_t source = 0;
+        for (uint32_t u = 1; u < n; u++) {
+            if (ver.second.degre(u) > ver.second.degre(source)) source = u;
+        }
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            controle += parcours_voisins(ver.second);
+            PE.stop();
+            nbs_voisins += PE.nb_s();
+            PE.start();
+            arcs = parcours_largeur(ver.second, source, file);
+            PE.stop();
+            nbs_largeur += PE.nb_s();
+        }
+        fichier << ver.first << " balayage arcs/s:" << ver.second.m * number_of_loops / nbs_voisins << "\n";
+        fichier << ver.first << " largeur arcs/s:" << arcs * number_of_loops / nbs_largeur
+                << " (controle " << controle % 1000 << ")\n";
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* somme ponderee sur tous les arcs : debit brut de lecture de la CSR */
+uint64_t parcours_voisins(const Graphe& g) {
+    uint64_t s = 0;
+    for (uint32_t u = 0; u < g.n; u++) {
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+            s += *p ^ u;
+        }
+    }
+    return s;
+}
+
+/* parcours en largeur sequentiel, renvoie le nombre d'arcs examines */
+uint64_t parcours_largeur(const Graphe& g, sommet_t s, std::vector<sommet_t>& file) {
+    std::vector<uint8_t> vu(g.n, 0);
+    file.clear();
+    file.push_back(s);
+    vu[s] = 1;
+    uint64_t arcs = 0;
+    for (size_t tete = 0; tete < file.size(); tete++) {
+        sommet_t u = file[tete];
+        arcs += g.degre(u);
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+            if (!vu[*p]) {
+                vu[*p] = 1;
+                file.push_back(*p);
+            }
+        }
+    }
+    return arcs;
+}
+
+/*  commandes d'execution:
+    ./execs/tp_graphe 20 16 5 graphe_out.txt /tmp/graphe.bin
+    OMP_NUM_THREADS=1 ./execs/tp_graphe 20 16 5 graphe_out_1t.txt /tmp/graphe.bin
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_graphe.cpp -o execs/tp_graphe
+    g++ -O3 -march=native -fopenmp tp_graphe.cpp -o execs/tp_graphe_O3
+*/
@@ -0,0 +1,165 @@
+#ifndef HISTOGRAMME_H
+#define HISTOGRAMME_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <omp.h>
+#include "../Simd.hpp"
+
+/*  Histogramme h[b] = #{i : x[i] = b} de valeurs x[i] < nb_cases (comptes
+    sur 32 bits : moins de 2^32 elements), avant une somme prefixe
+    (SommePrefixe.hpp) dans la construction CSR, le tri par base, ...
+
+        HISTO_SCALAIRE : h[x[i]]++, un seul tableau. Deux valeurs egales
+            proches (cas frequent sur une loi de Zipf) enchainent lecture,
+            increment et ecriture de la meme case : la lecture attend
+            l'ecriture precedente (transfert memoire a memoire).
+
+        HISTO_SOUS_HISTOGRAMMES : HISTOGRAMME_COPIES copies, l'element i
+            va dans la copie i % HISTOGRAMME_COPIES ; les increments d'une
+            meme case se chevauchent, puis les copies sont sommees. Tant
+            que les copies tiennent en L1 : aussi rapide que le scalaire
+            sur des cases variees, 2.5 fois plus sur une case unique.
+
+        HISTO_PRIVE : une copie (ou des sous-histogrammes si elles tiennent
+            en cache) par thread sur son bloc, puis fusion vectorielle :
+            chaque thread somme une tranche de cases de toutes les copies.
+
+        HISTO_ATOMIQUE : un seul tableau partage, increments atomiques ;
+            sans fusion ni memoire en plus, pour les grands nombres de
+            cases ou nb_threads copies ne tiennent pas en cache ou coutent
+            plus a fusionner que l'histogramme lui-meme.
+
+    strategie_histo choisit selon le nombre de cases, n et les threads. */
+
+#ifndef HISTOGRAMME_COPIES
+#define HISTOGRAMME_COPIES 4
+#endif
+/* octets pour toutes les copies d'un thread (L1), pour une copie par thread (L2) */
+#ifndef HISTOGRAMME_L1
+#define HISTOGRAMME_L1 (1 << 16)
+#endif
+#ifndef HISTOGRAMME_CACHE
+#define HISTOGRAMME_CACHE (1 << 20)
+#endif
+
+enum StrategieHisto { HISTO_AUTO, HISTO_SCALAIRE, HISTO_SOUS_HISTOGRAMMES, HISTO_PRIVE, HISTO_ATOMIQUE };
+
+static const char* const NOMS_HISTO[5] = {"auto", "scalaire", "sous-histogrammes", "prive", "atomique"};
+
+inline StrategieHisto strategie_histo(uint32_t nb_cases, size_t n, int nb_threads) {
+    size_t octets = (size_t) nb_cases * sizeof(uint32_t);
+    if (nb_threads == 1 || n < ((size_t) 1 << 16)) {
+        return octets * HISTOGRAMME_COPIES <= HISTOGRAMME_L1 ? HISTO_SOUS_HISTOGRAMMES : HISTO_SCALAIRE;
+    }
+    /* fusion : nb_threads nb_cases lectures, a comparer aux n increments */
+    if (octets <= HISTOGRAMME_CACHE && (size_t) nb_cases * nb_threads <= n / 8) return HISTO_PRIVE;
+    return HISTO_ATOMIQUE;
+}
+
+namespace histo_detail {
+
+/* copies par thread : plusieurs seulement si elles tiennent ensemble en cache */
+inline int copies(uint32_t nb_cases) {
+    return (size_t) nb_cases * sizeof(uint32_t) * HISTOGRAMME_COPIES <= HISTOGRAMME_L1 ? HISTOGRAMME_COPIES : 1;
+}
+
+inline void compter(const uint32_t* x, size_t deb, size_t fin, uint32_t* h) {
+    for (size_t i = deb; i < fin; i++) h[x[i]]++;
+}
+
+/* K copies de nb cases consecutives en c */
+template <int K>
+void compter_copies(const uint32_t* x, size_t deb, size_t fin, uint32_t* c, size_t nb) {
+    uint32_t* ck[K];
+    for (int k = 0; k < K; k++) ck[k] = c + k * nb;
+    size_t i = deb;
+    for (; i + K <= fin; i += K) {
+        #pragma GCC unroll 16
+        for (int k = 0; k < K; k++) ck[k][x[i + k]]++;
+    }
+    for (; i < fin; i++) c[x[i]]++;
+}
+
+inline void compter_copies(const uint32_t* x, size_t deb, size_t fin, uint32_t* c, size_t nb, int K) {
+    if (K == HISTOGRAMME_COPIES) compter_copies<HISTOGRAMME_COPIES>(x, deb, fin, c, nb);
+    else compter(x, deb, fin, c);
+}
+
+/*  h[b] = somme des m copies src[k pas + b], cases reparties sur les
+    threads de l'equipe (omp for orphelin) */
+struct Fusion {
+    const uint32_t* src;
+    size_t pas;
+    int m;
+    uint32_t* h;
+    size_t nb;
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        typedef typename Simd<float, L>::vu V;
+        size_t nb_v = nb / L * L;
+        #pragma omp for schedule(static)
+        for (size_t b = 0; b < nb_v; b += L) {
+            V s, v;
+            memcpy(&s, src + b, sizeof(V));
+            for (int k = 1; k < m; k++) {
+                memcpy(&v, src + k * pas + b, sizeof(V));
+                s += v;
+            }
+            memcpy(h + b, &s, sizeof(V));
+        }
+        #pragma omp single
+        for (size_t b = nb_v; b < nb; b++) {
+            uint32_t s = 0;
+            for (int k = 0; k < m; k++) s += src[k * pas + b];
+            h[b] = s;
+        }
+    }
+};
+
+} // namespace histo_detail
+
+/* h : nb_cases comptes, ecrases */
+inline void histogramme(const uint32_t* x, size_t n, uint32_t* h, uint32_t nb_cases,
+                        StrategieHisto s = HISTO_AUTO, Isa isa = ISA_AUTO) {
+    using namespace histo_detail;
+    int nb_threads = omp_get_max_threads();
+    if (s == HISTO_AUTO) s = strategie_histo(nb_cases, n, nb_threads);
+    const size_t nb = nb_cases;
+
+    if (s == HISTO_SCALAIRE) {
+        memset(h, 0, nb * sizeof(uint32_t));
+        compter(x, 0, n, h);
+    } else if (s == HISTO_SOUS_HISTOGRAMMES) {
+        std::vector<uint32_t> c(HISTOGRAMME_COPIES * nb, 0);
+        compter_copies<HISTOGRAMME_COPIES>(x, 0, n, c.data(), nb);
+        Fusion f = {c.data(), nb, HISTOGRAMME_COPIES, h, nb};
+        lancer_simd<float>(f, isa);
+    } else if (s == HISTO_PRIVE) {
+        const int K = copies(nb_cases);
+        std::unique_ptr<uint32_t[]> c(new uint32_t[(size_t) nb_threads * K * nb]);
+        #pragma omp parallel num_threads(nb_threads)
+        {
+            int t = omp_get_thread_num(), nt = omp_get_num_threads();
+            /* chaque thread met a zero ses copies : premieres ecritures locales */
+            uint32_t* ct = c.get() + (size_t) t * K * nb;
+            memset(ct, 0, K * nb * sizeof(uint32_t));
+            compter_copies(x, n * t / nt, n * (t + 1) / nt, ct, nb, K);
+            #pragma omp barrier
+            Fusion f = {c.get(), nb, nt * K, h, nb};
+            lancer_simd<float>(f, isa);
+        }
+    } else {
+        #pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < nb; b++) h[b] = 0;
+        #pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < n; i++) {
+            #pragma omp atomic
+            h[x[i]]++;
+        }
+    }
+}
+
+#endif // HISTOGRAMME_H
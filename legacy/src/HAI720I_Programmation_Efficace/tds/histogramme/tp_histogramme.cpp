@@ -0,0 +1,101 @@
+/* histogrammes : scalaire, sous-histogrammes, copies privees par thread
+   fusionnees en SIMD, atomique ; entrees uniformes et de Zipf, de 16 a
+   2^24 cases, en elements par cycle */
+#include "../EvalPerf.hpp"
+#include "Histogramme.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+std::vector<uint32_t> uniforme(size_t, uint32_t, std::mt19937_64&);
+std::vector<uint32_t> zipf(size_t, uint32_t, double, std::mt19937_64&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\nsize number_of_loops output_file\n");
+        return -1;
+    }
+    size_t n = atoll(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    int nb_threads = omp_get_max_threads();
+
+    fichier << nb_threads << " threads, " << n << " elements\n";
+    for (uint32_t nb_cases : {16u, 256u, 4096u, 1u << 16, 1u << 20, 1u << 24}) {
+        for (int loi = 0; loi < 2; loi++) {
+            std::vector<uint32_t> x = loi == 0 ? uniforme(n, nb_cases, gen) : zipf(n, nb_cases, 1.1, gen);
+            std::vector<uint32_t> h(nb_cases), ref(nb_cases, 0);
+            for (uint32_t v : x) ref[v]++;
+            fichier << nb_cases << " cases, " << (loi == 0 ? "uniforme" : "Zipf (s = 1.1)") << ", auto : "
+                    << NOMS_HISTO[strategie_histo(nb_cases, n, nb_threads)] << "\n";
+
+            auto mesurer = [&](const std::string& nom, StrategieHisto s, int threads) {
+                double nbc = 0, nbs = 0;
+                omp_set_num_threads(threads);
+                histogramme(x.data(), n, h.data(), nb_cases, s);
+                for (int k = 0; k < number_of_loops; k++) {
+                    PE.start();
+                    histogramme(x.data(), n, h.data(), nb_cases, s);
+                    PE.stop();
+                    PE.nb_c();
+                    nbc += PE.nb_tot;
+                    nbs += PE.nb_s();
+                }
+                omp_set_num_threads(nb_threads);
+                fichier << "    " << nom << ", " << threads << (threads > 1 ? " threads: " : " thread: ")
+                        << n * number_of_loops / nbc << " elements/cycle, "
+                        << n * number_of_loops / nbs * 1e-9 << " Gelements/s, " << (h == ref ? "correct" : "FAUX")
+                        << "\n";
+            };
+            mesurer("scalaire", HISTO_SCALAIRE, 1);
+            mesurer("sous-histogrammes", HISTO_SOUS_HISTOGRAMMES, 1);
+            for (int t : {1, nb_threads}) {
+                mesurer("prive", HISTO_PRIVE, t);
+                mesurer("atomique", HISTO_ATOMIQUE, t);
+                if (nb_threads == 1) break;
+            }
+            mesurer("auto", HISTO_AUTO, nb_threads);
+        }
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+std::vector<uint32_t> uniforme(size_t n, uint32_t nb_cases, std::mt19937_64& gen) {
+    std::uniform_int_distribution<uint32_t> u(0, nb_cases - 1);
+    std::vector<uint32_t> x(n);
+    for (uint32_t& v : x) v = u(gen);
+    return x;
+}
+
+/* P(b) proportionnel a 1 / (b + 1)^s : inversion de la repartition */
+std::vector<uint32_t> zipf(size_t n, uint32_t nb_cases, double s, std::mt19937_64& gen) {
+    std::vector<double> F(nb_cases);
+    double acc = 0;
+    for (uint32_t b = 0; b < nb_cases; b++) F[b] = acc += pow(b + 1.0, -s);
+    std::uniform_real_distribution<double> u(0, acc);
+    std::vector<uint32_t> x(n);
+    for (uint32_t& v : x) {
+        v = std::min<uint32_t>(std::upper_bound(F.begin(), F.end(), u(gen)) - F.begin(), nb_cases - 1);
+    }
+    return x;
+}
+
+/*  commandes d'execution:
+    ./execs/tp_histogramme 100000000 5 histogramme_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_histogramme.cpp -o execs/tp_histogramme
+*/
@@ -0,0 +1,398 @@
+#ifndef INTERPOLATION_H
+#define INTERPOLATION_H
+
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "../Simd.hpp"
+
+/*  Interpolation polynomiale aux noeuds x0 .. x(n-1), deux formes :
+
+    barycentrique (seconde forme), poids w(j) = 1 / prod_{k != j} (xj - xk)
+    calcules une fois par jeu de noeuds en O(n^2) :
+
+        p(t) = sum w(j) f(j) / (t - xj)  /  sum w(j) / (t - xj)
+
+    O(n) par point, stable, et p(xj) = f(j) exactement (cas t == xj traite
+    a part). Les poids ne dependent pas des valeurs : changer f ne coute
+    rien.
+
+    Newton, differences divisees calculees en place en O(n^2) :
+
+        c(i) <- (c(i) - c(i-1)) / (xi - x(i-k))   pour k = 1 .. n-1,
+                                                   i = n-1 .. k
+
+    a k fixe, la mise a jour ne lit que des c(i-1) pas encore ecrasees si
+    l'on descend : elle se vectorise par blocs de L indices. Les inverses
+    1 / (xi - x(i-k)) dependent seulement des noeuds : precalcules dans
+    Noeuds, la division devient une multiplication. L'evaluation est un
+    Horner decale, p = p (t - xk) + c(k) ; newton_vers_monomes donne les
+    coefficients pour Horner.hpp (mal conditionnes au-dela d'une vingtaine
+    de noeuds, comme toute base monomiale).
+
+    Mode lot : nb problemes partageant les noeuds, valeurs rangees par
+    noeud (f[j * nb + p] pour le probleme p) : toutes les operations se
+    vectorisent sur les problemes avec des coefficients scalaires communs
+    (inverses des ecarts, t - xk, poids barycentriques normalises).
+
+        preparer_noeuds(x)                  poids et inverses des ecarts
+        barycentrique(nd, f, t)             un probleme, un point
+        differences_divisees(x, c, n)       en place, reference scalaire
+        newton(x, c, n, t)                  t scalaire
+        newton(p, x, c, n, t)               t scalaire ou vecteur, resultat
+                                            dans p (Simd.hpp)
+        barycentrique_points(nd, f, t, y, m, isa)
+                                            un probleme, m points, vectorise
+                                            sur les points
+        differences_divisees_simd(nd, c, isa)
+                                            un probleme, par blocs de L
+        differences_divisees_lot(nd, c, nb, isa)
+        newton_lot(nd, c, nb, t, m, y, isa)
+        barycentrique_lot(nd, f, nb, t, m, y, isa)
+                                            y[q * nb + p] = p-ieme
+                                            interpolant en t[q] */
+
+#define INTERP_EN_LIGNE SIMD_EN_LIGNE
+
+template <class S>
+struct Noeuds {
+    std::vector<S> x;
+    std::vector<S> w;           /* poids barycentriques, max |w| = 1 */
+    std::vector<S> inv;         /* 1 / (x(i) - x(i-k)) en inv[debut[k] + i - k] */
+    std::vector<size_t> debut;
+
+    int n() const { return (int) x.size(); }
+};
+
+/* poids en long double (l'exposant de prod (xj - xk) croit comme n) */
+template <class S>
+Noeuds<S> preparer_noeuds(const std::vector<S>& x) {
+    Noeuds<S> nd;
+    int n = (int) x.size();
+    nd.x = x;
+    std::vector<long double> w(n, 1);
+    long double maxi = 0;
+    for (int j = 0; j < n; j++) {
+        for (int k = 0; k < n; k++) {
+            if (k != j) w[j] *= (long double) x[j] - x[k];
+        }
+        w[j] = 1 / w[j];
+        maxi = std::max(maxi, fabsl(w[j]));
+    }
+    for (int j = 0; j < n; j++) nd.w.push_back((S) (w[j] / maxi));
+    nd.debut.assign(n, 0);
+    for (int k = 1; k < n; k++) {
+        nd.debut[k] = nd.inv.size();
+        for (int i = k; i < n; i++) nd.inv.push_back((S) (1 / ((long double) x[i] - x[i - k])));
+    }
+    return nd;
+}
+
+/* points de Chebyshev de seconde espece (extrema de T(n-1)) sur [a, b] */
+template <class S>
+std::vector<S> noeuds_chebyshev(int n, S a, S b) {
+    std::vector<S> x(n);
+    for (int j = 0; j < n; j++) {
+        long double c = n == 1 ? 0 : -cosl(3.14159265358979323846264338327950288L * j / (n - 1));
+        x[j] = (S) ((a + b) / 2.0L + (b - a) / 2.0L * c);
+    }
+    return x;
+}
+
+template <class S>
+std::vector<S> noeuds_equidistants(int n, S a, S b) {
+    std::vector<S> x(n);
+    for (int j = 0; j < n; j++) x[j] = n == 1 ? a : (S) (a + (long double) (b - a) * j / (n - 1));
+    return x;
+}
+
+/*  r <- p(t), t scalaire ou vecteur : les points qui tombent sur un noeud
+    rendent la valeur au noeud (masque), sans branchement */
+template <class T, class S>
+INTERP_EN_LIGNE void barycentrique(T& r, const S* x, const S* w, const S* f, int n, const T& t) {
+    typedef decltype(t == t) Masque;
+    T num = T(), den = T(), exact = T();
+    Masque touche = Masque();
+    for (int j = 0; j < n; j++) {
+        T d = t - x[j];
+        Masque nul = d == 0;
+        T q = w[j] / (nul ? T() + 1 : d);
+        num += q * f[j];
+        den += q;
+        exact = nul ? T() + f[j] : exact;
+        touche = touche | nul;
+    }
+    r = touche ? exact : num / den;
+}
+
+template <class S>
+inline S barycentrique(const Noeuds<S>& nd, const S* f, S t) {
+    S r;
+    barycentrique(r, nd.x.data(), nd.w.data(), f, nd.n(), t);
+    return r;
+}
+
+/* c : valeurs f(xi) en entree, coefficients de Newton en sortie */
+template <class S>
+inline void differences_divisees(const S* x, S* c, int n) {
+    for (int k = 1; k < n; k++) {
+        for (int i = n - 1; i >= k; i--) c[i] = (c[i] - c[i - 1]) / (x[i] - x[i - k]);
+    }
+}
+
+template <class T, class S>
+INTERP_EN_LIGNE void newton(T& p, const S* x, const S* c, int n, const T& t) {
+    T q = T() + c[n - 1];
+    for (int k = n - 2; k >= 0; k--) q = q * (t - x[k]) + c[k];
+    p = q;
+}
+
+template <class S>
+inline S newton(const S* x, const S* c, int n, S t) {
+    S p;
+    newton(p, x, c, n, t);
+    return p;
+}
+
+/* p(t) = sum a(k) t^k, a de taille n, pour horner(a, n, t) */
+template <class S>
+std::vector<S> newton_vers_monomes(const S* x, const S* c, int n) {
+    std::vector<long double> a(n, 0);
+    int deg = 0;
+    a[0] = c[n - 1];
+    for (int k = n - 2; k >= 0; k--) {
+        /* a <- a (t - xk) + c(k) */
+        a[deg + 1] = a[deg];
+        for (int j = deg; j >= 1; j--) a[j] = a[j - 1] - x[k] * a[j];
+        a[0] = -x[k] * a[0] + c[k];
+        deg++;
+    }
+    return std::vector<S>(a.begin(), a.end());
+}
+
+namespace interp_detail {
+
+/* un probleme, m points : 2 vecteurs de points par tour (n divisions chacun) */
+template <class S>
+struct BarycentriquePoints {
+    const Noeuds<S>* nd;
+    const S* f;
+    const S* t;
+    S* y;
+    size_t m;
+
+    template <int L> INTERP_EN_LIGNE void executer() const {
+        typedef typename Simd<S, L>::v V;
+        const S* x = nd->x.data();
+        const S* w = nd->w.data();
+        int n = nd->n();
+        size_t i = 0;
+        for (; i + 2 * L <= m; i += 2 * L) {
+            V u[2];
+            memcpy(&u[0], t + i, sizeof(V));
+            memcpy(&u[1], t + i + L, sizeof(V));
+            barycentrique(u[0], x, w, f, n, u[0]);
+            barycentrique(u[1], x, w, f, n, u[1]);
+            memcpy(y + i, &u[0], sizeof(V));
+            memcpy(y + i + L, &u[1], sizeof(V));
+        }
+        for (; i < m; i++) barycentrique(y[i], x, w, f, n, t[i]);
+    }
+};
+
+/* un probleme : a k fixe, blocs de L indices en descendant */
+template <class S>
+struct DifferencesUn {
+    const Noeuds<S>* nd;
+    S* c;
+
+    template <int L> INTERP_EN_LIGNE void executer() const {
+        typedef typename Simd<S, L>::v V;
+        int n = nd->n();
+        for (int k = 1; k < n; k++) {
+            const S* inv = nd->inv.data() + nd->debut[k];
+            int i = n;
+            for (; i - L >= k; i -= L) {
+                V a, b, r;
+                memcpy(&a, c + i - L, sizeof(V));
+                memcpy(&b, c + i - L - 1, sizeof(V));
+                memcpy(&r, inv + (i - L - k), sizeof(V));
+                a = (a - b) * r;
+                memcpy(c + i - L, &a, sizeof(V));
+            }
+            for (i--; i >= k; i--) c[i] = (c[i] - c[i - 1]) * inv[i - k];
+        }
+    }
+};
+
+/* nb problemes, c[i * nb + p] : tuiles de K L problemes, O(n^2) par tuile */
+template <class S>
+struct DifferencesLot {
+    const Noeuds<S>* nd;
+    S* c;
+    size_t nb;
+
+    template <int L> INTERP_EN_LIGNE void executer() const {
+        typedef typename Simd<S, L>::v V;
+        const int K = 4;
+        int n = nd->n();
+        size_t p = 0;
+        for (; p + K * L <= nb; p += K * L) {
+            for (int k = 1; k < n; k++) {
+                const S* inv = nd->inv.data() + nd->debut[k];
+                for (int i = n - 1; i >= k; i--) {
+                    S* ci = c + i * nb + p;
+                    #pragma GCC unroll 4
+                    for (int j = 0; j < K; j++) {
+                        V a, b;
+                        memcpy(&a, ci + j * L, sizeof(V));
+                        memcpy(&b, ci - nb + j * L, sizeof(V));
+                        a = (a - b) * inv[i - k];
+                        memcpy(ci + j * L, &a, sizeof(V));
+                    }
+                }
+            }
+        }
+        for (; p < nb; p++) {
+            for (int k = 1; k < n; k++) {
+                const S* inv = nd->inv.data() + nd->debut[k];
+                for (int i = n - 1; i >= k; i--) c[i * nb + p] = (c[i * nb + p] - c[(i - 1) * nb + p]) * inv[i - k];
+            }
+        }
+    }
+};
+
+/* nb problemes en m points : Horner decale, K chaines de L problemes */
+template <class S>
+struct NewtonLot {
+    const Noeuds<S>* nd;
+    const S* c;
+    size_t nb;
+    const S* t;
+    size_t m;
+    S* y;
+
+    template <int L> INTERP_EN_LIGNE void executer() const {
+        typedef typename Simd<S, L>::v V;
+        const int K = 8;
+        const S* x = nd->x.data();
+        int n = nd->n();
+        for (size_t q = 0; q < m; q++) {
+            S* yq = y + q * nb;
+            size_t p = 0;
+            for (; p + K * L <= nb; p += K * L) {
+                V r[K];
+                #pragma GCC unroll 8
+                for (int j = 0; j < K; j++) memcpy(&r[j], c + (n - 1) * nb + p + j * L, sizeof(V));
+                for (int k = n - 2; k >= 0; k--) {
+                    S d = t[q] - x[k];
+                    #pragma GCC unroll 8
+                    for (int j = 0; j < K; j++) {
+                        V a;
+                        memcpy(&a, c + k * nb + p + j * L, sizeof(V));
+                        r[j] = r[j] * d + a;
+                    }
+                }
+                #pragma GCC unroll 8
+                for (int j = 0; j < K; j++) memcpy(yq + p + j * L, &r[j], sizeof(V));
+            }
+            for (; p < nb; p++) {
+                S r = c[(n - 1) * nb + p];
+                for (int k = n - 2; k >= 0; k--) r = r * (t[q] - x[k]) + c[k * nb + p];
+                yq[p] = r;
+            }
+        }
+    }
+};
+
+/*  nb problemes en m points : les poids lambda(j) = w(j) / (t - xj) / sum
+    sont communs a tous les problemes (n divisions par point), il reste
+    un produit matrice-vecteur vectorise sur les problemes */
+template <class S>
+struct BarycentriqueLot {
+    const Noeuds<S>* nd;
+    const S* f;
+    size_t nb;
+    const S* t;
+    size_t m;
+    S* y;
+    S* lambda;
+
+    template <int L> INTERP_EN_LIGNE void executer() const {
+        typedef typename Simd<S, L>::v V;
+        const int K = 8;
+        const S* x = nd->x.data();
+        const S* w = nd->w.data();
+        int n = nd->n();
+        for (size_t q = 0; q < m; q++) {
+            S den = 0;
+            int exact = -1;
+            for (int j = 0; j < n; j++) {
+                S d = t[q] - x[j];
+                if (d == 0) exact = j;
+                lambda[j] = w[j] / d;
+                den += lambda[j];
+            }
+            for (int j = 0; j < n; j++) lambda[j] = exact < 0 ? lambda[j] / den : (S) (j == exact);
+            S* yq = y + q * nb;
+            size_t p = 0;
+            for (; p + K * L <= nb; p += K * L) {
+                V r[K] = {};
+                for (int j = 0; j < n; j++) {
+                    #pragma GCC unroll 8
+                    for (int i = 0; i < K; i++) {
+                        V a;
+                        memcpy(&a, f + j * nb + p + i * L, sizeof(V));
+                        r[i] += lambda[j] * a;
+                    }
+                }
+                #pragma GCC unroll 8
+                for (int i = 0; i < K; i++) memcpy(yq + p + i * L, &r[i], sizeof(V));
+            }
+            for (; p < nb; p++) {
+                S r = 0;
+                for (int j = 0; j < n; j++) r += lambda[j] * f[j * nb + p];
+                yq[p] = r;
+            }
+        }
+    }
+};
+
+} // namespace interp_detail
+
+template <class S>
+inline void barycentrique_points(const Noeuds<S>& nd, const S* f, const S* t, S* y, size_t m, Isa isa = ISA_AUTO) {
+    interp_detail::BarycentriquePoints<S> e = {&nd, f, t, y, m};
+    lancer_simd<S>(e, isa);
+}
+
+/* inverses precalcules : quelques ulp d'ecart avec la version par division */
+template <class S>
+inline void differences_divisees_simd(const Noeuds<S>& nd, S* c, Isa isa = ISA_AUTO) {
+    interp_detail::DifferencesUn<S> e = {&nd, c};
+    lancer_simd<S>(e, isa);
+}
+
+template <class S>
+inline void differences_divisees_lot(const Noeuds<S>& nd, S* c, size_t nb, Isa isa = ISA_AUTO) {
+    interp_detail::DifferencesLot<S> e = {&nd, c, nb};
+    lancer_simd<S>(e, isa);
+}
+
+template <class S>
+inline void newton_lot(const Noeuds<S>& nd, const S* c, size_t nb, const S* t, size_t m, S* y, Isa isa = ISA_AUTO) {
+    interp_detail::NewtonLot<S> e = {&nd, c, nb, t, m, y};
+    lancer_simd<S>(e, isa);
+}
+
+template <class S>
+inline void barycentrique_lot(const Noeuds<S>& nd, const S* f, size_t nb, const S* t, size_t m, S* y,
+                              Isa isa = ISA_AUTO) {
+    std::vector<S> lambda(nd.n());
+    interp_detail::BarycentriqueLot<S> e = {&nd, f, nb, t, m, y, lambda.data()};
+    lancer_simd<S>(e, isa);
+}
+
+#endif // INTERPOLATION_H
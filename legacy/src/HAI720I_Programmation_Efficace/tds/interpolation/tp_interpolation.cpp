@@ -0,0 +1,211 @@
+/* interpolation polynomiale : formes barycentrique et de Newton, un
+   probleme evalue en beaucoup de points, puis beaucoup de petits problemes
+   partageant leurs noeuds */
+#include "../EvalPerf.hpp"
+#include "../Horner.hpp"
+#include "Interpolation.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+#define INTERP_SCALAIRE __attribute__((noinline, optimize("no-tree-vectorize")))
+
+void lagrange_naif(const std::vector<double>&, const double*, const double*, double*, size_t);
+void barycentrique_scalaire(const Noeuds<double>&, const double*, const double*, double*, size_t);
+void newton_scalaire(const Noeuds<double>&, const double*, const double*, double*, size_t);
+void horner_scalaire(const std::vector<double>&, const double*, double*, size_t);
+void differences_une_a_une(const Noeuds<double>&, double*, size_t);
+void differences_une_a_une_simd(const Noeuds<double>&, double*, size_t, Isa);
+void newton_une_a_une(const Noeuds<double>&, const double*, size_t, const double*, size_t, double*);
+
+struct Mesure {
+    std::string nom;
+    std::function<void()> g;
+    std::function<double()> erreur;
+};
+
+double mesurer(const std::function<void()>& g, int number_of_loops) {
+    EvalPerf PE;
+    double nbc = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        g();
+        PE.stop();
+        PE.nb_c();
+        nbc += PE.nb_tot;
+    }
+    return nbc / number_of_loops;
+}
+
+
+int main(int argc, char **argv) {
+    if (argc < 6) {
+        printf("You must enter the following details:\nnb_nodes nb_problems nb_points number_of_loops output_file\n");
+        return -1;
+    }
+    int n = atoi(argv[1]);
+    size_t nb = atol(argv[2]);
+    size_t m = atol(argv[3]);
+    int number_of_loops = atoi(argv[4]);
+    std::ofstream fichier {argv[5]};
+
+    Noeuds<double> nd = preparer_noeuds(noeuds_chebyshev(n, -1.0, 1.0));
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> u(-1, 1), v(1, 3);
+
+    /* probleme p : f(x) = sin(a(p) x) + b(p), a dans [1, 3] */
+    std::vector<double> a(nb), b(nb);
+    for (size_t p = 0; p < nb; p++) {
+        a[p] = v(gen);
+        b[p] = u(gen);
+    }
+    auto f = [&](size_t p, double x) { return sin(a[p] * x) + b[p]; };
+    std::vector<double> t(m), y(m), exact(m);
+    for (size_t i = 0; i < m; i++) t[i] = u(gen);
+    t[0] = nd.x[n / 2];   /* un point sur un noeud */
+
+    /* 1. un probleme, m points */
+    std::vector<double> fx(n), c(n);
+    for (int j = 0; j < n; j++) fx[j] = f(0, nd.x[j]);
+    c = fx;
+    differences_divisees(nd.x.data(), c.data(), n);
+    std::vector<double> mono = newton_vers_monomes(nd.x.data(), c.data(), n);
+    for (size_t i = 0; i < m; i++) exact[i] = f(0, t[i]);
+    auto erreur = [&] {
+        double e = 0;
+        for (size_t i = 0; i < m; i++) e = std::max(e, fabs(y[i] - exact[i]));
+        return e;
+    };
+    fichier << "un probleme, " << n << " noeuds de Chebyshev, " << m << " points\n";
+    std::vector<Mesure> mesures = {
+        {"Lagrange naif O(n^2)", [&] { lagrange_naif(nd.x, fx.data(), t.data(), y.data(), m); }, erreur},
+        {"barycentrique", [&] { barycentrique_scalaire(nd, fx.data(), t.data(), y.data(), m); }, erreur},
+        {"Newton", [&] { newton_scalaire(nd, c.data(), t.data(), y.data(), m); }, erreur},
+        {"Horner (monomes)", [&] { horner_scalaire(mono, t.data(), y.data(), m); }, erreur},
+    };
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        Isa i = (Isa) isa;
+        mesures.push_back({std::string("barycentrique_points ") + NOMS_ISA[isa],
+                           [&, i] { barycentrique_points(nd, fx.data(), t.data(), y.data(), m, i); }, erreur});
+    }
+    for (const Mesure& me : mesures) {
+        double nbc = mesurer(me.g, number_of_loops);
+        fichier << "    " << me.nom << ": cycles/point " << nbc / m << ", erreur max " << me.erreur() << "\n";
+    }
+
+    /* 2. nb problemes partageant les noeuds */
+    size_t mq = std::min(m, (size_t) 64);
+    std::vector<double> fp(nb * n), fl(nb * n), cp(nb * n), cl(nb * n), yp(mq * nb), yl(mq * nb);
+    for (size_t p = 0; p < nb; p++) {
+        for (int j = 0; j < n; j++) fp[p * n + j] = fl[j * nb + p] = f(p, nd.x[j]);
+    }
+    auto erreur_lot = [&](const std::vector<double>& z) {
+        double e = 0;
+        for (size_t q = 0; q < mq; q++) {
+            for (size_t p = 0; p < nb; p += 97) e = std::max(e, fabs(z[q * nb + p] - f(p, t[q])));
+        }
+        return e;
+    };
+    /* ecart a la reference rapporte au plus grand coefficient du probleme :
+       les derniers coefficients, minuscules, ne sont que du bruit d'arrondi */
+    auto ecart_coefficients = [&](bool lot) {
+        double e = 0;
+        for (size_t p = 0; p < nb; p++) {
+            double d = 0, maxi = 0;
+            for (int j = 0; j < n; j++) {
+                double z = lot ? cl[j * nb + p] : cl[p * n + j];
+                d = std::max(d, fabs(z - cp[p * n + j]));
+                maxi = std::max(maxi, fabs(cp[p * n + j]));
+            }
+            e = std::max(e, d / maxi);
+        }
+        return e;
+    };
+    fichier << nb << " problemes de " << n << " noeuds, " << mq << " points\n";
+    fichier << "    differences divisees, cycles/probleme (ecart a la reference):\n";
+    double ref = mesurer([&] { cp = fp; differences_une_a_une(nd, cp.data(), nb); }, number_of_loops);
+    fichier << "        un a un, division: " << ref / nb << "\n";
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        Isa i = (Isa) isa;
+        double nbc = mesurer([&] { cl = fp; differences_une_a_une_simd(nd, cl.data(), nb, i); }, number_of_loops);
+        fichier << "        un a un, " << NOMS_ISA[isa] << ": " << nbc / nb << " (" << ecart_coefficients(false) << ")\n";
+    }
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        Isa i = (Isa) isa;
+        double nbc = mesurer([&] { cl = fl; differences_divisees_lot(nd, cl.data(), nb, i); }, number_of_loops);
+        fichier << "        lot " << NOMS_ISA[isa] << ": " << nbc / nb << " (" << ecart_coefficients(true) << ")\n";
+    }
+    fichier << "    evaluation, cycles/(probleme x point):\n";
+    {
+        double nbc = mesurer([&] { newton_une_a_une(nd, cp.data(), nb, t.data(), mq, yp.data()); }, number_of_loops);
+        fichier << "        Newton un a un: " << nbc / nb / mq << ", erreur " << erreur_lot(yp) << "\n";
+    }
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        Isa i = (Isa) isa;
+        double nbc = mesurer([&] { newton_lot(nd, cl.data(), nb, t.data(), mq, yl.data(), i); }, number_of_loops);
+        fichier << "        newton_lot " << NOMS_ISA[isa] << ": " << nbc / nb / mq << ", erreur " << erreur_lot(yl) << "\n";
+        nbc = mesurer([&] { barycentrique_lot(nd, fl.data(), nb, t.data(), mq, yl.data(), i); }, number_of_loops);
+        fichier << "        barycentrique_lot " << NOMS_ISA[isa] << ": " << nbc / nb / mq << ", erreur "
+                << erreur_lot(yl) << "\n";
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+INTERP_SCALAIRE void lagrange_naif(const std::vector<double>& x, const double* f, const double* t, double* y, size_t m) {
+    int n = (int) x.size();
+    for (size_t i = 0; i < m; i++) {
+        double s = 0;
+        for (int j = 0; j < n; j++) {
+            double l = 1;
+            for (int k = 0; k < n; k++) {
+                if (k != j) l *= (t[i] - x[k]) / (x[j] - x[k]);
+            }
+            s += l * f[j];
+        }
+        y[i] = s;
+    }
+}
+
+INTERP_SCALAIRE void barycentrique_scalaire(const Noeuds<double>& nd, const double* f, const double* t, double* y, size_t m) {
+    for (size_t i = 0; i < m; i++) y[i] = barycentrique(nd, f, t[i]);
+}
+
+INTERP_SCALAIRE void newton_scalaire(const Noeuds<double>& nd, const double* c, const double* t, double* y, size_t m) {
+    for (size_t i = 0; i < m; i++) y[i] = newton(nd.x.data(), c, nd.n(), t[i]);
+}
+
+INTERP_SCALAIRE void horner_scalaire(const std::vector<double>& a, const double* t, double* y, size_t m) {
+    for (size_t i = 0; i < m; i++) y[i] = horner(a.data(), (int) a.size(), t[i]);
+}
+
+/* problemes ranges l'un apres l'autre : c[p * n + j] */
+INTERP_SCALAIRE void differences_une_a_une(const Noeuds<double>& nd, double* c, size_t nb) {
+    for (size_t p = 0; p < nb; p++) differences_divisees(nd.x.data(), c + p * nd.n(), nd.n());
+}
+
+void differences_une_a_une_simd(const Noeuds<double>& nd, double* c, size_t nb, Isa isa) {
+    for (size_t p = 0; p < nb; p++) differences_divisees_simd(nd, c + p * nd.n(), isa);
+}
+
+INTERP_SCALAIRE void newton_une_a_une(const Noeuds<double>& nd, const double* c, size_t nb, const double* t,
+                                      size_t m, double* y) {
+    for (size_t q = 0; q < m; q++) {
+        for (size_t p = 0; p < nb; p++) y[q * nb + p] = newton(nd.x.data(), c + p * nd.n(), nd.n(), t[q]);
+    }
+}
+
+/*  commandes d'execution:
+    ./execs/tp_interpolation 16 10000 1000 10 interpolation_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_interpolation.cpp -o execs/tp_interpolation
+*/
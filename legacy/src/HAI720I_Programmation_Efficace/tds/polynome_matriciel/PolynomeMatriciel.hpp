@@ -0,0 +1,126 @@
+#ifndef POLYNOME_MATRICIEL_H
+#define POLYNOME_MATRICIEL_H
+
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "../Gemm.hpp"
+
+/*  Polynomes de matrices p(A) = c0 I + c1 A + ... + c(n-1) A^(n-1), degre
+    d = n - 1. Seuls les produits de matrices comptent (n^3 chacun), les
+    combinaisons lineaires sont en n^2.
+
+        horner_matriciel : R <- R A + c(k) I, d - 1 produits
+
+        paterson_stockmeyer : on calcule A^2 .. A^s (s - 1 produits) puis
+
+            p(A) = B0 + B1 A^s + B2 (A^s)^2 + ... + Br (A^s)^r,
+            Bj = c(js) I + c(js+1) A + ... + c(js+s-1) A^(s-1)
+
+        les Bj sont des combinaisons lineaires des puissances deja connues,
+        Horner en A^s coute r = d / s produits : environ 2 sqrt(d) en tout
+        pour s ~ sqrt(d) (un de moins si s divise d : Br = c(d) I).
+
+        expm : mise a l'echelle et elevation au carre, exp(A) = exp(A / 2^e)^(2^e)
+        avec |A / 2^e|_1 <= 1 ; exp y est la serie de Taylor de degre 18
+        (reste < 1 / 19! ~ 8e-18) evaluee par Paterson-Stockmeyer (7
+        produits au lieu de 17), puis e carres. Si |A|_1 n'est pas fini
+        (infini, NaN ou debordement), E est remplie de NaN sans produit.
+
+    Chaque fonction renvoie le nombre de produits effectues. */
+
+/* p(A) par Horner */
+inline int horner_matriciel(const double* c, int n, const Matrice& A, Matrice& R) {
+    int d = n - 1, produits = 0;
+    R = Matrice(A.lignes, A.colonnes);
+    if (d == 0) {
+        ajouter_identite(R, c[0]);
+        return 0;
+    }
+    axpy(R, c[d], A);
+    ajouter_identite(R, c[d - 1]);
+    Matrice T(A.lignes, A.colonnes);
+    for (int k = d - 2; k >= 0; k--) {
+        gemm(T, R, A);
+        ajouter_identite(T, c[k]);
+        std::swap(R, T);
+        produits++;
+    }
+    return produits;
+}
+
+/* nombre de produits de Paterson-Stockmeyer de degre d et pas s */
+inline int cout_paterson_stockmeyer(int d, int s) {
+    return s - 1 + d / s - (d % s == 0 ? 1 : 0);
+}
+
+/* s <= 0 : pas de cout minimal */
+inline int paterson_stockmeyer(const double* c, int n, const Matrice& A, Matrice& R, int s = 0) {
+    int d = n - 1;
+    if (d <= 1) return horner_matriciel(c, n, A, R);
+    if (s <= 0) {
+        s = 1;
+        for (int t = 2; t <= d; t++) {
+            if (cout_paterson_stockmeyer(d, t) < cout_paterson_stockmeyer(d, s)) s = t;
+        }
+    }
+    int produits = 0;
+    std::vector<Matrice> P(s + 1);
+    P[1] = A;
+    for (int i = 2; i <= s; i++) {
+        P[i] = Matrice(A.lignes, A.colonnes);
+        gemm(P[i], P[i - 1], A);
+        produits++;
+    }
+    /* Bj, termes d'indice <= d */
+    auto bloc = [&](int j, Matrice& B) {
+        B = Matrice(A.lignes, A.colonnes);
+        ajouter_identite(B, c[j * s]);
+        for (int i = 1; i < s && j * s + i <= d; i++) axpy(B, c[j * s + i], P[i]);
+    };
+    int r = d / s, j;
+    if (d % s == 0) {
+        bloc(r - 1, R);
+        axpy(R, c[d], P[s]);
+        j = r - 2;
+    } else {
+        bloc(r, R);
+        j = r - 1;
+    }
+    Matrice T;
+    for (; j >= 0; j--) {
+        bloc(j, T);
+        gemm(T, R, P[s], 1, 1);
+        std::swap(R, T);
+        produits++;
+    }
+    return produits;
+}
+
+#define EXPM_DEGRE 18
+
+inline int expm(const Matrice& A, Matrice& E, bool paterson = true) {
+    double c[EXPM_DEGRE + 1];
+    c[0] = 1;
+    for (int k = 1; k <= EXPM_DEGRE; k++) c[k] = c[k - 1] / k;
+    double norme = norme_1(A);
+    if (!std::isfinite(norme)) {
+        E = Matrice(A.lignes, A.colonnes, NAN);
+        return 0;
+    }
+    int e = norme > 1 ? (int) ceil(log2(norme)) : 0;
+    Matrice X = A;
+    for (double& x : X.v) x = ldexp(x, -e);
+    int produits = paterson ? paterson_stockmeyer(c, EXPM_DEGRE + 1, X, E)
+                            : horner_matriciel(c, EXPM_DEGRE + 1, X, E);
+    Matrice T(A.lignes, A.colonnes);
+    for (int i = 0; i < e; i++) {
+        gemm(T, E, E);
+        std::swap(E, T);
+        produits++;
+    }
+    return produits;
+}
+
+#endif // POLYNOME_MATRICIEL_H
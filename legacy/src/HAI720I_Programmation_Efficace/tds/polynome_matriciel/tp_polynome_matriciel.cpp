@@ -0,0 +1,143 @@
+/* polynomes de matrices : Horner (d - 1 produits) contre Paterson-Stockmeyer
+   (~2 sqrt(d) produits), et exponentielle par mise a l'echelle et elevation
+   au carre */
+#include "../EvalPerf.hpp"
+#include "PolynomeMatriciel.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+
+Matrice matrice_aleatoire(int, std::mt19937_64&);
+Matrice symetrique_connue(int, double, double, std::mt19937_64&, Matrice&);
+double ecart_relatif(const Matrice&, const Matrice&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nmatrix_size max_degree number_of_loops output_file\n");
+        return -1;
+    }
+    int n = atoi(argv[1]);
+    int degre_max = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+
+    /* debit du produit seul */
+    Matrice A = matrice_aleatoire(n, gen), C(n, n);
+    double nbs = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        gemm(C, A, A);
+        PE.stop();
+        nbs += PE.nb_s();
+    }
+    double s_produit = nbs / number_of_loops;
+    fichier << "gemm " << n << "x" << n << ": " << s_produit * 1e3 << " ms, "
+            << 2.0 * n * n * n / s_produit * 1e-9 << " GFLOP/s\n";
+
+    /* p(A), coefficients dans [-1, 1] */
+    std::uniform_real_distribution<double> u(-1, 1);
+    fichier << "p(A) de degre d, " << n << "x" << n << "\n";
+    for (int d = 4; d <= degre_max; d *= 2) {
+        std::vector<double> c(d + 1);
+        for (double& x : c) x = u(gen);
+        Matrice Rh, Rps;
+        int ph = 0, pps = 0;
+        double nbs_h = 0, nbs_ps = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            ph = horner_matriciel(c.data(), d + 1, A, Rh);
+            PE.stop();
+            nbs_h += PE.nb_s();
+            PE.start();
+            pps = paterson_stockmeyer(c.data(), d + 1, A, Rps);
+            PE.stop();
+            nbs_ps += PE.nb_s();
+        }
+        fichier << "    d=" << d << " Horner: " << ph << " produits, " << nbs_h / number_of_loops * 1e3
+                << " ms ; Paterson-Stockmeyer: " << pps << " produits (2 sqrt(d) = " << 2 * sqrt(d) << "), "
+                << nbs_ps / number_of_loops * 1e3 << " ms ; acceleration " << nbs_h / nbs_ps
+                << " ; ecart relatif " << ecart_relatif(Rps, Rh) << "\n";
+    }
+
+    /* exp(A) pour A = H D H connue, valeurs propres dans [-50, 5] */
+    Matrice exact;
+    Matrice S = symetrique_connue(n, -50, 5, gen, exact);
+    fichier << "exp(A), |A|_1 = " << norme_1(S) << "\n";
+    for (bool paterson : {false, true}) {
+        Matrice E;
+        int produits = 0;
+        nbs = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            produits = expm(S, E, paterson);
+            PE.stop();
+            nbs += PE.nb_s();
+        }
+        fichier << "    " << (paterson ? "Paterson-Stockmeyer" : "Horner") << ": " << produits << " produits, "
+                << nbs / number_of_loops * 1e3 << " ms, erreur relative " << ecart_relatif(E, exact) << "\n";
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/*  entrees uniformes sur [-1, 1] multipliees par sqrt(3 / n) : rayon
+    spectral ~1 (loi du cercle), les puissances de A ne tendent ni vers 0
+    (nombres denormaux, tres lents) ni vers l'infini */
+Matrice matrice_aleatoire(int n, std::mt19937_64& gen) {
+    std::uniform_real_distribution<double> u(-1, 1);
+    Matrice A(n, n);
+    for (double& x : A.v) x = u(gen) * sqrt(3.0 / n);
+    return A;
+}
+
+/*  A = H D H avec H = I - 2 v v^T / v^T v (symetrique, orthogonale) :
+    exp(A) = H exp(D) H */
+Matrice symetrique_connue(int n, double a, double b, std::mt19937_64& gen, Matrice& exponentielle) {
+    std::uniform_real_distribution<double> u(-1, 1), l(a, b);
+    std::vector<double> v(n), D(n);
+    double vv = 0;
+    for (int i = 0; i < n; i++) {
+        v[i] = u(gen);
+        vv += v[i] * v[i];
+        D[i] = l(gen);
+    }
+    Matrice H = identite(n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) H[i][j] -= 2 * v[i] * v[j] / vv;
+    }
+    auto conjuguer = [&](const std::vector<double>& diag) {
+        Matrice HD = H, R(n, n);
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) HD[i][j] *= diag[j];
+        }
+        gemm(R, HD, H);
+        return R;
+    };
+    std::vector<double> eD(n);
+    for (int i = 0; i < n; i++) eD[i] = exp(D[i]);
+    exponentielle = conjuguer(eD);
+    return conjuguer(D);
+}
+
+double ecart_relatif(const Matrice& X, const Matrice& Y) {
+    Matrice Z = X;
+    axpy(Z, -1, Y);
+    return norme_1(Z) / norme_1(Y);
+}
+
+/*  commandes d'execution:
+    ./execs/tp_polynome_matriciel 512 64 3 polynome_matriciel_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_polynome_matriciel.cpp -o execs/tp_polynome_matriciel
+*/
@@ -0,0 +1,249 @@
+/* modele statique de pression sur les ports : cycles/element predits pour
+   les noyaux des exercices 4, 5 et 6, a cote des cycles mesures par EvalPerf,
+   puis prediction seule pour les fonctions de l'exercice 2 et le noyau de
+   l'exercice 3 */
+#include "../EvalPerf.hpp"
+#include "../ModelePorts.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+/* memes corps de boucle que dans exo4, exo5 et exo6 */
+int ma_fonction_exo4(int);
+void somme_prefixe_exo5(int*, int);
+int horner_exo6(int*, int, int);
+double horner_double(const double*, int, double);
+void noyau_exo3(double*, const double*, const double*, const double*, int);
+
+Noyau modele_exo4();
+Noyau modele_exo5();
+Noyau modele_horner_entier();
+Noyau modele_horner_double();
+Noyau modele_exo3_deroule(int deroulement, bool fma);
+void modeles_exercice2(Noyau&, Noyau&, Noyau&);
+
+int puits = 0;
+double puits_d = 0;
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\narray_size number_of_loops output_file\n");
+        return -1;
+    }
+    int array_size = atoi(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+    EvalPerf PE;
+    Machine hsw = machine_haswell();
+    srand(42);
+
+    std::vector<int> A(array_size), B(array_size);
+    std::vector<double> P(array_size), u(array_size), x(array_size), y(array_size), z(array_size);
+    for (int i = 0; i < array_size; i++) {
+        A[i] = rand() % 31;
+        P[i] = (rand() % 1000) / 1000.0;
+        /* x*y < 0.01 : z reste borne d'un passage a l'autre */
+        u[i] = (rand() % 1000) / 1000.0;
+        x[i] = y[i] = (rand() % 100) / 1000.0;
+        z[i] = 0;
+    }
+
+    /* chaque mesure : moyenne en cycles/element sur number_of_loops passages */
+    double nbc = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        puits += ma_fonction_exo4(array_size);
+        PE.stop();
+        PE.nb_c();
+        nbc += PE.nb_tot;
+    }
+    afficher_prediction(fichier, modele_exo4(), hsw, nbc / number_of_loops / array_size);
+
+    nbc = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        for (int i = 0; i < array_size; i++) B[i] = A[i];
+        PE.start();
+        somme_prefixe_exo5(B.data(), array_size);
+        PE.stop();
+        PE.nb_c();
+        nbc += PE.nb_tot;
+        puits += B[array_size - 1];
+    }
+    afficher_prediction(fichier, modele_exo5(), hsw, nbc / number_of_loops / array_size);
+
+    nbc = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        puits += horner_exo6(A.data(), array_size, 6);
+        PE.stop();
+        PE.nb_c();
+        nbc += PE.nb_tot;
+    }
+    afficher_prediction(fichier, modele_horner_entier(), hsw, nbc / number_of_loops / array_size);
+
+    nbc = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        puits_d += horner_double(P.data(), array_size, 0.999);
+        PE.stop();
+        PE.nb_c();
+        nbc += PE.nb_tot;
+    }
+    afficher_prediction(fichier, modele_horner_double(), hsw, nbc / number_of_loops / array_size);
+
+    nbc = 0;
+    for (int k = 0; k < number_of_loops; k++) {
+        PE.start();
+        noyau_exo3(z.data(), u.data(), x.data(), y.data(), array_size);
+        PE.stop();
+        PE.nb_c();
+        nbc += PE.nb_tot;
+    }
+    puits_d += z[array_size / 2];
+    afficher_prediction(fichier, modele_exo3_deroule(1, false), hsw, nbc / number_of_loops / array_size);
+
+    /* predictions seules : variantes de l'exercice 3 (mesurees dans exo3) */
+    fichier << "\n";
+    afficher_prediction(fichier, modele_exo3_deroule(4, false), hsw, 0);
+    afficher_prediction(fichier, modele_exo3_deroule(4, true), hsw, 0);
+
+    /* exercice 2 : une evaluation isolee, on lit chemin critique et ILP */
+    fichier << "\n";
+    Noyau f1, f2, f3;
+    modeles_exercice2(f1, f2, f3);
+    for (int v = 0; v < 2; v++) {
+        Machine m = machine_exercice2(v == 1);
+        afficher_prediction(fichier, f1, m, 0);
+        afficher_prediction(fichier, f2, m, 0);
+        afficher_prediction(fichier, f3, m, 0);
+    }
+    fichier << "controle:" << puits << " " << puits_d << "\n";
+    fichier.close();
+
+    return 0;
+}
+
+
+
+__attribute__((noinline)) int ma_fonction_exo4(int n) {
+    int t = 0;
+    for (int i = 0; i < n; i++) {
+        t += i;
+        t *= i;
+    }
+    return t;
+}
+
+__attribute__((noinline)) void somme_prefixe_exo5(int* B, int n) {
+    for (int i = 1; i < n; i++) {
+        B[i] = B[i] + B[i-1];
+    }
+}
+
+__attribute__((noinline)) int horner_exo6(int* p, int n, int alpha) {
+    int res = 0;
+    for (int i = 1; i <= n; i++) {
+        res += res * alpha + p[n-i];
+    }
+    return res;
+}
+
+__attribute__((noinline)) double horner_double(const double* p, int n, double alpha) {
+    double res = 0;
+    for (int i = 1; i <= n; i++) {
+        res = res * alpha + p[n-i];
+    }
+    return res;
+}
+
+__attribute__((noinline)) void noyau_exo3(double* z, const double* u, const double* x,
+                                          const double* y, int n) {
+    for (int i = 0; i < n; i++) {
+        z[i] = z[i] + u[i] * u[i] + x[i] * y[i] * z[i];
+    }
+}
+
+/* t = (t + i) * i : la chaine add -> imul porte sur t */
+Noyau modele_exo4() {
+    Noyau k("exo4 ma_fonction: t += i; t *= i");
+    int a = k.op(OP_ALU);
+    int m = k.op(OP_IMUL, {a});
+    k.ops[a].deps_prec.push_back(m);
+    k.gestion_boucle();
+    return k;
+}
+
+/* B[i-1] reste dans un registre : la chaine ne porte que sur l'addition */
+Noyau modele_exo5() {
+    Noyau k("exo5 somme prefixe: B[i] += B[i-1]");
+    int l = k.op(OP_LOAD);
+    int a = k.op(OP_ALU, {l});
+    k.ops[a].deps_prec.push_back(a);
+    k.op(OP_STORE, {a});
+    k.gestion_boucle();
+    return k;
+}
+
+/* gcc factorise res + res * alpha en res * (alpha + 1) : imul puis add */
+Noyau modele_horner_entier() {
+    Noyau k("exo6 horner entier: res += res * alpha + p[n-i]");
+    int l = k.op(OP_LOAD);
+    int m = k.op(OP_IMUL);
+    int a = k.op(OP_ALU, {m, l});
+    k.ops[m].deps_prec.push_back(a);
+    k.gestion_boucle();
+    return k;
+}
+
+Noyau modele_horner_double() {
+    Noyau k("horner double sans fma: res = res * alpha + p[n-i]");
+    int l = k.op(OP_LOAD);
+    int m = k.op(OP_FMUL);
+    int a = k.op(OP_FADD, {m, l});
+    k.ops[m].deps_prec.push_back(a);
+    k.gestion_boucle();
+    return k;
+}
+
+/* scalaire deroule d fois (modele partage avec exo3) */
+Noyau modele_exo3_deroule(int d, bool fma) {
+    return modele_exo3(std::string("exo3 z += u*u + x*y*z, deroule x") + std::to_string(d)
+                       + (fma ? ", fma" : ", sans fma"), 1, d, fma);
+}
+
+/*  exercice 2, evaluation dans l'ordre ecrit :
+        f1 = 1 - a*a*a*a
+        f2 = (1 + a*a) * (1 - a) * (1 + a)
+        f3 = (1 - a*a) * (1 + a*a) */
+void modeles_exercice2(Noyau& f1, Noyau& f2, Noyau& f3) {
+    f1 = Noyau("exercice 2 f1");
+    int m1 = f1.op(OP_FMUL);
+    int m2 = f1.op(OP_FMUL, {m1});
+    int m3 = f1.op(OP_FMUL, {m2});
+    f1.op(OP_FADD, {m3});
+
+    f2 = Noyau("exercice 2 f2");
+    int x = f2.op(OP_FADD);
+    int y = f2.op(OP_FADD);
+    int aa = f2.op(OP_FMUL);
+    int s = f2.op(OP_FADD, {aa});
+    int p = f2.op(OP_FMUL, {s, x});
+    f2.op(OP_FMUL, {p, y});
+
+    f3 = Noyau("exercice 2 f3");
+    int a2 = f3.op(OP_FMUL);
+    int d = f3.op(OP_FADD, {a2});
+    int e = f3.op(OP_FADD, {a2});
+    f3.op(OP_FMUL, {d, e});
+}
+
+/*  commandes d'execution:
+    ./execs/tp_ports 100000 100 ports_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_ports.cpp -o execs/tp_ports
+*/
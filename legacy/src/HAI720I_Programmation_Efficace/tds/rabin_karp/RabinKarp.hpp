@@ -0,0 +1,446 @@
+#ifndef RABIN_KARP_H
+#define RABIN_KARP_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <omp.h>
+#include "../Simd.hpp"
+
+/*  Hachage polynomial roulant (Rabin-Karp) : l'empreinte d'une fenetre
+    s[0 .. m) est le polynome de tp2_exo6 evalue par Horner en la base B,
+
+        H(s) = s[0] B^(m-1) + s[1] B^(m-2) + ... + s[m-1]   mod P = 2^61 - 1
+
+    (P premier de Mersenne : la reduction est un masque, un decalage et une
+    addition). Glisser d'un octet coute O(1) : H' = H B - s[0] B^m + s[m].
+    La base est tiree au hasard dans [2^8, 2^31] : deux chaines distinctes
+    de longueur m ont la meme empreinte avec probabilite <= m / P, et
+    B < 2^32 ramene H B a deux produits 32 x 32 -> 64 bits (pmuludq) : le
+    meme code sert aux scalaires et aux vecteurs de voies 64 bits.
+
+        FenetreRoulante     une fenetre, glissement O(1)
+        PrefixesHachage     h[i] = H(s[0 .. i)) : H(s[i .. j)) en O(1)
+        empreintes_fenetres H de toutes les fenetres de longueur m ; le
+                            texte est coupe en L segments, un par voie : L
+                            fenetres avancent ensemble au lieu d'une chaine
+                            de dependances de ~10 cycles par octet
+        rechercher_motifs   plusieurs motifs : une table des empreintes par
+                            longueur, chaque fenetre y est cherchee puis
+                            comparee octet a octet (pas de faux positifs)
+
+    Les blocs du texte sont repartis entre les threads ; projeter_fichier
+    projette un fichier en memoire (mmap) pour les parcourir sans copie. */
+
+/* fenetres par bloc (au moins 512 m : 2 L m octets de depart par bloc) */
+#ifndef RABIN_KARP_BLOC
+#define RABIN_KARP_BLOC (1 << 14)
+#endif
+#ifndef RABIN_KARP_SEUIL_THREADS
+#define RABIN_KARP_SEUIL_THREADS (1 << 20)
+#endif
+
+struct Occurrence {
+    size_t position;
+    uint32_t motif;
+};
+
+namespace rk_detail {
+
+const uint64_t P = ((uint64_t) 1 << 61) - 1;
+const uint64_t M32 = 0xFFFFFFFFull, M29 = (1ull << 29) - 1;
+
+inline uint64_t mul_mod(uint64_t a, uint64_t b) {
+    unsigned __int128 r = (unsigned __int128) a * b;
+    uint64_t x = ((uint64_t) r & P) + (uint64_t) (r >> 61);
+    return x >= P ? x - P : x;
+}
+
+/*  resultat en premier argument, vecteurs par reference (Simd.hpp) ; les
+    formes scalaires rendent leur valeur. */
+
+/* produit des 32 bits de poids faible de a et b, par voie de 64 bits */
+template <class V>
+SIMD_EN_LIGNE void mul32(V& r, const V& a, const V& b) {
+    typedef int v4si __attribute__((vector_size(16)));
+    if constexpr (sizeof(V) == 16) r = (V) __builtin_ia32_pmuludq128((v4si) a, (v4si) b);
+    else r = (a & M32) * (b & M32);
+}
+
+SIMD_EN_LIGNE_AVX2 void mul32(Simd<double, 4>::vu& r, const Simd<double, 4>::vu& a, const Simd<double, 4>::vu& b) {
+    typedef int v8si __attribute__((vector_size(32)));
+    r = (Simd<double, 4>::vu) __builtin_ia32_pmuludq256((v8si) a, (v8si) b);
+}
+
+SIMD_EN_LIGNE_AVX512 void mul32(Simd<double, 8>::vu& r, const Simd<double, 8>::vu& a, const Simd<double, 8>::vu& b) {
+    typedef int v16si __attribute__((vector_size(64)));
+    typedef long long v8di __attribute__((vector_size(64)));
+    r = (Simd<double, 8>::vu) __builtin_ia32_pmuludq512_mask((v16si) a, (v16si) b, v8di(), (uint8_t) 0xFF);
+}
+
+/* x < 2^64 -> x mod P, dans [0, P) */
+template <class V>
+SIMD_EN_LIGNE void reduire(V& r, const V& x) {
+    V y = (x & P) + (x >> 61);
+    /* y < P + 8 : y >= P si et seulement si y + 1 >= 2^61 */
+    r = (y + ((y + 1) >> 61)) & P;
+}
+
+/* h c, h < 2^64, c < 2^32, non reduit (< 2^62 + 2^35) */
+template <class V>
+SIMD_EN_LIGNE void fois(V& r, const V& h, const V& c) {
+    V q, l;
+    mul32(q, h >> 32, c);
+    mul32(l, h, c);
+    /* q 2^32 = (q >> 29) 2^61 + (q mod 2^29) 2^32, et 2^61 = 1 mod P */
+    r = (q >> 29) + ((q & M29) << 32) + (l & P) + (l >> 61);
+}
+
+/* o B^m, o < 2^8, B^m = bh 2^32 + bl : o bl < 2^40 n'a pas a etre reduit */
+template <class V>
+SIMD_EN_LIGNE void fois_octet(V& r, const V& o, const V& bh, const V& bl) {
+    V q, l;
+    mul32(q, o, bh);
+    mul32(l, o, bl);
+    r = (q >> 29) + ((q & M29) << 32) + l;
+}
+
+/* H B - sortant B^m + entrant ; 4 P > fois_octet(sortant, ...) */
+template <class V>
+SIMD_EN_LIGNE void rouler(V& r, const V& h, const V& entrant, const V& sortant, const V& b, const V& bh, const V& bl) {
+    V f, g;
+    fois(f, h, b);
+    fois_octet(g, sortant, bh, bl);
+    reduire(r, f + entrant + (4 * P - g));
+}
+
+inline uint64_t reduire(uint64_t x) {
+    reduire<uint64_t>(x, x);
+    return x;
+}
+
+inline uint64_t fois(uint64_t h, uint64_t c) {
+    uint64_t r;
+    fois<uint64_t>(r, h, c);
+    return r;
+}
+
+/* L fenetres consecutives d'un octet, une par segment de longueur seg */
+template <int L, class V>
+SIMD_EN_LIGNE void octets(V& v, const uint8_t* s, size_t seg) {
+    uint64_t o[L];
+    for (int j = 0; j < L; j++) o[j] = s[j * seg];
+    memcpy(&v, o, sizeof(V));
+}
+
+} // namespace rk_detail
+
+inline uint64_t base_aleatoire() {
+    std::random_device a;
+    std::mt19937_64 gen(((uint64_t) a() << 32) | a());
+    return std::uniform_int_distribution<uint64_t>(1 << 8, 1u << 31)(gen);
+}
+
+inline uint64_t puissance_mod(uint64_t b, uint64_t e) {
+    uint64_t r = 1;
+    for (; e; e >>= 1, b = rk_detail::mul_mod(b, b)) {
+        if (e & 1) r = rk_detail::mul_mod(r, b);
+    }
+    return r;
+}
+
+/* Horner (tp2_exo6) */
+inline uint64_t hacher(const uint8_t* s, size_t m, uint64_t base) {
+    uint64_t h = 0;
+    for (size_t i = 0; i < m; i++) h = rk_detail::reduire(rk_detail::fois(h, base) + s[i]);
+    return h;
+}
+
+struct FenetreRoulante {
+    uint64_t base, bm, h;
+
+    FenetreRoulante(const uint8_t* s, size_t m, uint64_t base)
+        : base(base), bm(puissance_mod(base, m)), h(hacher(s, m, base)) {}
+
+    /* s[0 .. m) -> s[1 .. m + 1) */
+    void glisser(uint8_t sortant, uint8_t entrant) {
+        rk_detail::rouler<uint64_t>(h, h, entrant, sortant, base, bm >> 32, bm);
+    }
+};
+
+struct PrefixesHachage {
+    std::vector<uint64_t> h, p;      /* h[i] = H(s[0 .. i)), p[i] = B^i */
+
+    PrefixesHachage(const uint8_t* s, size_t n, uint64_t base) : h(n + 1), p(n + 1) {
+        h[0] = 0;
+        p[0] = 1;
+        for (size_t i = 0; i < n; i++) {
+            h[i + 1] = rk_detail::reduire(rk_detail::fois(h[i], base) + s[i]);
+            p[i + 1] = rk_detail::reduire(rk_detail::fois(p[i], base));
+        }
+    }
+
+    /* H(s[i .. j)) = h[j] - h[i] B^(j - i) */
+    uint64_t sous_chaine(size_t i, size_t j) const {
+        return rk_detail::reduire(h[j] + rk_detail::P - rk_detail::mul_mod(h[i], p[j - i]));
+    }
+};
+
+namespace rk_detail {
+
+/*  h[i] = H(s[i .. i + m)) pour i < nb (s : nb + m - 1 octets). Le texte
+    est coupe en S = 2 L segments de seg fenetres : deux chaines de
+    vecteurs independantes cachent la latence du produit. 8 octets
+    entrants et sortants par segment sont lus d'un coup. Si entrelace, les
+    S empreintes d'un pas sont ecrites ensemble : h[r S + j] est la
+    fenetre j seg + r (position()) ; sinon elles sont transposees par un
+    tableau pour etre ecrites dans l'ordre. */
+struct Fenetres {
+    static const int CHAINES = 2;
+    const uint8_t* s;
+    size_t nb, m;
+    uint64_t base, bm;
+    uint64_t* h;
+    bool entrelace;
+
+    static size_t position(size_t i, size_t nb, int S) {
+        size_t seg = nb / S;
+        return i < S * seg ? i % S * seg + i / S : i;
+    }
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        typedef typename Simd<double, L>::vu V;
+        const int S = CHAINES * L;
+        const size_t seg = nb / S;
+        if (seg > 0) {
+            const V b = V() + base, bh = V() + (bm >> 32), bl = V() + bm;
+            uint64_t t[8][S];
+            for (int j = 0; j < S; j++) t[0][j] = hacher(s + j * seg, m, base);
+            V v[CHAINES];
+            memcpy(v, t[0], sizeof(v));
+            size_t k = 0;
+            /* k + 8 < seg : le dernier octet entrant lu est s[S seg + m - 2] */
+            for (; k + 8 < seg; k += 8) {
+                uint64_t e[S], o[S];
+                for (int j = 0; j < S; j++) {
+                    memcpy(&o[j], s + j * seg + k, 8);
+                    memcpy(&e[j], s + j * seg + k + m, 8);
+                }
+                V ve[CHAINES], vo[CHAINES];
+                memcpy(ve, e, sizeof(ve));
+                memcpy(vo, o, sizeof(vo));
+                #pragma GCC unroll 8
+                for (int r = 0; r < 8; r++) {
+                    memcpy(entrelace ? h + (k + r) * S : t[r], v, sizeof(v));
+                    #pragma GCC unroll 8
+                    for (int c = 0; c < CHAINES; c++) {
+                        rouler<V>(v[c], v[c], (ve[c] >> (8 * r)) & 0xFF, (vo[c] >> (8 * r)) & 0xFF, b, bh, bl);
+                    }
+                }
+                if (!entrelace) {
+                    for (int j = 0; j < S; j++) {
+                        for (int r = 0; r < 8; r++) h[j * seg + k + r] = t[r][j];
+                    }
+                }
+            }
+            for (; k < seg; k++) {
+                memcpy(entrelace ? h + k * S : t[0], v, sizeof(v));
+                if (!entrelace) {
+                    for (int j = 0; j < S; j++) h[j * seg + k] = t[0][j];
+                }
+                if (k + 1 == seg) break;
+                for (int c = 0; c < CHAINES; c++) {
+                    const uint8_t* sc = s + c * L * seg + k;
+                    V e, o;
+                    octets<L>(e, sc + m, seg);
+                    octets<L>(o, sc, seg);
+                    rouler(v[c], v[c], e, o, b, bh, bl);
+                }
+            }
+        }
+        /* reste : nb - S seg < S fenetres */
+        for (size_t i = S * seg; i < nb; i++) h[i] = hacher(s + i, m, base);
+    }
+};
+
+} // namespace rk_detail
+
+/* h[i] = H(s[i .. i + m)), 0 <= i <= n - m */
+inline void empreintes_fenetres(const uint8_t* s, size_t n, size_t m, uint64_t base, uint64_t* h,
+                                Isa isa = ISA_AUTO) {
+    if (m == 0 || m > n) return;
+    rk_detail::Fenetres e = {s, n - m + 1, m, base, puissance_mod(base, m), h, false};
+    lancer_simd<double>(e, isa);
+}
+
+/*  motifs groupes par longueur ; pour chaque longueur, table a adressage
+    ouvert (capacite >= 4 motifs) empreinte -> premier motif, les motifs
+    de meme empreinte chaines par suivant. Un filtre de 64 bits par motif
+    (bit x mod taille pour l'empreinte x) ecarte presque toutes les
+    fenetres sans entrer dans la table ni rater de prediction. */
+struct MotifsRabinKarp {
+    struct Groupe {
+        size_t m;
+        std::vector<uint64_t> cles;     /* VIDE : case libre */
+        std::vector<uint32_t> tete;
+        std::vector<uint64_t> filtre;
+    };
+    static constexpr uint64_t VIDE = ~0ull;
+    static constexpr uint32_t AUCUN = ~0u;
+
+    uint64_t base;
+    std::vector<std::string> motifs;
+    std::vector<Groupe> groupes;
+    std::vector<uint32_t> suivant;
+};
+
+/* les motifs vides sont ignores */
+inline MotifsRabinKarp preparer_motifs(const std::vector<std::string>& motifs, uint64_t base = base_aleatoire()) {
+    MotifsRabinKarp mk;
+    mk.base = base;
+    mk.motifs = motifs;
+    mk.suivant.assign(motifs.size(), MotifsRabinKarp::AUCUN);
+    std::vector<std::pair<size_t, uint32_t>> par_longueur;
+    for (size_t i = 0; i < motifs.size(); i++) {
+        if (!motifs[i].empty()) par_longueur.push_back({motifs[i].size(), (uint32_t) i});
+    }
+    std::sort(par_longueur.begin(), par_longueur.end());
+    for (size_t a = 0, b; a < par_longueur.size(); a = b) {
+        for (b = a; b < par_longueur.size() && par_longueur[b].first == par_longueur[a].first; b++) {}
+        MotifsRabinKarp::Groupe g;
+        g.m = par_longueur[a].first;
+        size_t cap = 16;
+        while (cap < 4 * (b - a)) cap *= 2;
+        g.cles.assign(cap, MotifsRabinKarp::VIDE);
+        g.tete.assign(cap, MotifsRabinKarp::AUCUN);
+        g.filtre.assign(std::max((size_t) 64, cap / 4), 0);
+        for (size_t k = a; k < b; k++) {
+            uint32_t id = par_longueur[k].second;
+            uint64_t x = hacher((const uint8_t*) motifs[id].data(), g.m, base);
+            size_t c = x & (cap - 1);
+            while (g.cles[c] != MotifsRabinKarp::VIDE && g.cles[c] != x) c = (c + 1) & (cap - 1);
+            g.cles[c] = x;
+            mk.suivant[id] = g.tete[c];
+            g.tete[c] = id;
+            g.filtre[(x >> 6) & (g.filtre.size() - 1)] |= 1ull << (x & 63);
+        }
+        mk.groupes.push_back(std::move(g));
+    }
+    return mk;
+}
+
+namespace rk_detail {
+
+/* occurrences des motifs du groupe en s (empreinte x) */
+inline size_t verifier(const MotifsRabinKarp& mk, const MotifsRabinKarp::Groupe& g, uint64_t x,
+                       const uint8_t* s, size_t position, std::vector<Occurrence>* occ) {
+    const size_t masque = g.cles.size() - 1;
+    for (size_t c = x & masque; g.cles[c] != MotifsRabinKarp::VIDE; c = (c + 1) & masque) {
+        if (g.cles[c] != x) continue;
+        size_t nb = 0;
+        for (uint32_t id = g.tete[c]; id != MotifsRabinKarp::AUCUN; id = mk.suivant[id]) {
+            if (memcmp(s, mk.motifs[id].data(), g.m) == 0) {
+                nb++;
+                if (occ) occ->push_back({position, id});
+            }
+        }
+        return nb;
+    }
+    return 0;
+}
+
+} // namespace rk_detail
+
+/*  nombre d'occurrences (chevauchantes) de tous les motifs dans s[0 .. n) ;
+    occ (optionnel) : les occurrences, triees par position puis motif */
+inline size_t rechercher_motifs(const MotifsRabinKarp& mk, const uint8_t* s, size_t n,
+                                std::vector<Occurrence>* occ = nullptr, Isa isa = ISA_AUTO) {
+    int nb_threads = omp_get_max_threads();
+    const int S = rk_detail::Fenetres::CHAINES * voies<double>(isa_effective(isa));
+    std::vector<std::vector<Occurrence>> occ_thread(nb_threads);
+    /* un bloc du texte est parcouru pour toutes les longueurs tant qu'il est en cache */
+    size_t m_max = 0;
+    std::vector<uint64_t> bm;
+    for (const MotifsRabinKarp::Groupe& g : mk.groupes) {
+        m_max = std::max(m_max, g.m);
+        bm.push_back(puissance_mod(mk.base, g.m));
+    }
+    const size_t C = std::max((size_t) RABIN_KARP_BLOC, 512 * m_max);
+    size_t total = 0;
+    #pragma omp parallel num_threads(nb_threads) if (n > RABIN_KARP_SEUIL_THREADS) reduction(+ : total)
+    {
+        std::vector<Occurrence>* mes_occ = occ ? &occ_thread[omp_get_thread_num()] : nullptr;
+        std::vector<uint64_t> h(std::min(C, n));
+        #pragma omp for schedule(static)
+        for (size_t c = 0; c < n; c += C) {
+            for (size_t q = 0; q < mk.groupes.size(); q++) {
+                const MotifsRabinKarp::Groupe& g = mk.groupes[q];
+                if (c + g.m > n) continue;
+                size_t k = std::min(C, n - g.m + 1 - c);
+                rk_detail::Fenetres e = {s + c, k, g.m, mk.base, bm[q], h.data(), true};
+                lancer_simd<double>(e, isa);
+                const uint64_t* f = g.filtre.data();
+                const size_t mf = g.filtre.size() - 1;
+                for (size_t i = 0; i < k; i++) {
+                    if (!((f[(h[i] >> 6) & mf] >> (h[i] & 63)) & 1)) continue;
+                    size_t p = c + rk_detail::Fenetres::position(i, k, S);
+                    total += rk_detail::verifier(mk, g, h[i], s + p, p, mes_occ);
+                }
+            }
+        }
+    }
+    if (occ) {
+        occ->clear();
+        for (const std::vector<Occurrence>& o : occ_thread) occ->insert(occ->end(), o.begin(), o.end());
+        std::sort(occ->begin(), occ->end(), [](const Occurrence& a, const Occurrence& b) {
+            return a.position != b.position ? a.position < b.position : a.motif < b.motif;
+        });
+    }
+    return total;
+}
+
+/* fichier projete en lecture seule, lu sequentiellement (madvise) */
+struct FichierProjete {
+    const uint8_t* donnees = nullptr;
+    size_t taille = 0;
+
+    FichierProjete() {}
+    FichierProjete(const FichierProjete&) = delete;
+    FichierProjete& operator=(const FichierProjete&) = delete;
+    FichierProjete(FichierProjete&& f) { std::swap(donnees, f.donnees); std::swap(taille, f.taille); }
+    FichierProjete& operator=(FichierProjete&& f) {
+        std::swap(donnees, f.donnees);
+        std::swap(taille, f.taille);
+        return *this;
+    }
+    ~FichierProjete() { if (donnees) munmap((void*) donnees, taille); }
+};
+
+inline bool projeter_fichier(const char* chemin, FichierProjete& f) {
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* carte = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (carte == MAP_FAILED) return false;
+    madvise(carte, st.st_size, MADV_SEQUENTIAL);
+    FichierProjete g;
+    g.donnees = (const uint8_t*) carte;
+    g.taille = st.st_size;
+    f = std::move(g);
+    return true;
+}
+
+#endif // RABIN_KARP_H
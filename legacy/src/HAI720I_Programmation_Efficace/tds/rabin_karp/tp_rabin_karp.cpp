@@ -0,0 +1,219 @@
+/* hachage roulant de Rabin-Karp (Horner modulo 2^61 - 1) : empreintes de
+   toutes les fenetres (une chaine scalaire, plusieurs fenetres par
+   vecteur), empreintes de sous-chaines par prefixes, recherche de
+   plusieurs motifs dans un fichier projete en memoire ; octets par seconde */
+#include "../EvalPerf.hpp"
+#include "RabinKarp.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+bool ecrire_texte(const char*, size_t, std::mt19937_64&);
+void fenetres_scalaire(const uint8_t*, size_t, size_t, uint64_t, uint64_t*);
+size_t compter_memmem(const uint8_t*, size_t, const std::string&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nsize_MB number_of_patterns number_of_loops output_file "
+               "[text_file]\n");
+        return -1;
+    }
+    size_t taille = (size_t) atoll(argv[1]) << 20;
+    int nb_motifs = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    const char* chemin = argc > 5 ? argv[5] : "rabin_karp_texte.txt";
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    int nb_threads = omp_get_max_threads();
+
+    /* sans fichier donne : texte aleatoire ecrit puis projete */
+    FichierProjete f;
+    if (argc <= 5 && !ecrire_texte(chemin, taille, gen)) {
+        printf("cannot write %s\n", chemin);
+        return -1;
+    }
+    if (!projeter_fichier(chemin, f)) {
+        printf("cannot map %s\n", chemin);
+        return -1;
+    }
+    const uint8_t* s = f.donnees;
+    const size_t n = f.taille;
+    /* motifs de 64 octets au plus pris dans le texte (u(0, n - 64)) */
+    if (n < 64) {
+        printf("%s: at least 64 bytes of text needed, got %zu\n", chemin, n);
+        return -1;
+    }
+    fichier << chemin << " : " << n << " octets, " << nb_threads << " threads\n";
+
+    auto mesurer = [&](const std::string& nom, size_t octets, const std::function<void()>& g, const char* etat) {
+        double nbs = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            g();
+            PE.stop();
+            nbs += PE.nb_s();
+        }
+        fichier << "    " << nom << ": " << octets * number_of_loops / nbs * 1e-9 << " Go/s";
+        if (etat) fichier << ", " << etat;
+        fichier << "\n";
+    };
+    auto seul = [&](const std::function<void()>& g) {
+        return [&, g] {
+            omp_set_num_threads(1);
+            g();
+            omp_set_num_threads(nb_threads);
+        };
+    };
+    uint64_t base = base_aleatoire();
+
+    /* empreintes de toutes les fenetres de 16 octets (64 Mo au plus : 8 octets par fenetre) */
+    {
+        const size_t m = 16, nf = std::min(n, (size_t) 64 << 20);
+        std::vector<uint64_t> ref(nf), h(nf);
+        fichier << "empreintes des fenetres de " << m << " octets, " << nf << " octets\n";
+        mesurer("une chaine scalaire (Horner roulant)", nf, [&] { fenetres_scalaire(s, nf, m, base, ref.data()); },
+                nullptr);
+        for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+            std::fill(h.begin(), h.end(), 0);
+            empreintes_fenetres(s, nf, m, base, h.data(), (Isa) isa);
+            int S = rk_detail::Fenetres::CHAINES * voies<double>((Isa) isa);
+            mesurer(std::string(NOMS_ISA[isa]) + ", " + std::to_string(S) + " fenetres par pas", nf,
+                    [&, isa] { empreintes_fenetres(s, nf, m, base, h.data(), (Isa) isa); },
+                    h == ref ? "correct" : "FAUX");
+        }
+    }
+
+    /* prefixes : construction, puis sous-chaines aleatoires comparees a hacher */
+    {
+        const size_t np = std::min(n, (size_t) 16 << 20);
+        fichier << "prefixes de " << np << " octets\n";
+        PE.start();
+        PrefixesHachage p(s, np, base);
+        PE.stop();
+        fichier << "    construction: " << np / PE.nb_s() * 1e-9 << " Go/s\n";
+        const int nq = 1000000;
+        std::vector<size_t> deb(nq), lon(nq);
+        std::uniform_int_distribution<size_t> u(0, np - 1);
+        for (int q = 0; q < nq; q++) {
+            deb[q] = u(gen);
+            lon[q] = std::min(np - deb[q], (size_t) 1 + u(gen) % 64);
+        }
+        uint64_t somme = 0;
+        PE.start();
+        for (int q = 0; q < nq; q++) somme += p.sous_chaine(deb[q], deb[q] + lon[q]);
+        PE.stop();
+        bool correct = true;
+        for (int q = 0; q < nq; q++) correct = correct && p.sous_chaine(deb[q], deb[q] + lon[q])
+                                                          == hacher(s + deb[q], lon[q], base);
+        fichier << "    " << nq / PE.nb_s() * 1e-6 << " M sous-chaines/s (" << somme % 10 << "), "
+                << (correct ? "correct" : "FAUX") << "\n";
+    }
+
+    /* motifs de 8, 16, 32 et 64 octets : pris dans le texte, un sur quatre aleatoire */
+    {
+        std::vector<std::string> motifs;
+        std::uniform_int_distribution<size_t> u(0, n - 64);
+        std::uniform_int_distribution<int> lettre('a', 'z');
+        for (int k = 0; k < nb_motifs; k++) {
+            size_t m = 8 << (k % 4);
+            if (k % 4 == 3) {
+                std::string x(m, ' ');
+                for (char& c : x) c = lettre(gen);
+                motifs.push_back(x);
+            } else {
+                motifs.push_back(std::string((const char*) s + u(gen), m));
+            }
+        }
+        MotifsRabinKarp mk = preparer_motifs(motifs, base);
+        fichier << nb_motifs << " motifs, " << mk.groupes.size() << " longueurs\n";
+
+        std::vector<Occurrence> occ;
+        size_t total = rechercher_motifs(mk, s, n, &occ);
+        /* reference : memmem motif par motif (4 premiers) */
+        bool correct = occ.size() == total;
+        for (int k = 0; k < std::min(nb_motifs, 4); k++) {
+            size_t c = 0;
+            for (const Occurrence& o : occ) c += o.motif == (uint32_t) k;
+            correct = correct && c == compter_memmem(s, n, motifs[k]);
+        }
+        fichier << "    " << total << " occurrences, " << (correct ? "correct (memmem)" : "FAUX (memmem)") << "\n";
+        if (nb_motifs > 0) {
+            size_t t = 0;
+            mesurer("memmem, un motif, 1 thread", n, [&] { t = compter_memmem(s, n, motifs[0]); }, nullptr);
+            fichier << "        " << t << " occurrences\n";
+        }
+
+        for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+            size_t t = 0;
+            mesurer(std::string(NOMS_ISA[isa]) + ", 1 thread", n,
+                    seul([&, isa] { t = rechercher_motifs(mk, s, n, nullptr, (Isa) isa); }), nullptr);
+            fichier << "        " << (t == total ? "correct" : "FAUX") << "\n";
+        }
+        if (nb_threads > 1) {
+            size_t t = 0;
+            mesurer(std::to_string(nb_threads) + " threads", n, [&] { t = rechercher_motifs(mk, s, n); }, nullptr);
+            fichier << "        " << (t == total ? "correct" : "FAUX") << "\n";
+        }
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* lettres minuscules et espaces, par blocs de 1 Mo */
+bool ecrire_texte(const char* chemin, size_t n, std::mt19937_64& gen) {
+    FILE* f = fopen(chemin, "wb");
+    if (!f) return false;
+    std::uniform_int_distribution<int> u(0, 26);
+    std::vector<char> b(1 << 20);
+    for (size_t i = 0; i < n; i += b.size()) {
+        size_t k = std::min(b.size(), n - i);
+        for (size_t j = 0; j < k; j++) {
+            int c = u(gen);
+            b[j] = c == 26 ? ' ' : 'a' + c;
+        }
+        if (fwrite(b.data(), 1, k, f) != k) {
+            fclose(f);
+            return false;
+        }
+    }
+    return fclose(f) == 0;
+}
+
+/* une seule fenetre roulante : chaine de dependances d'un octet au suivant */
+void fenetres_scalaire(const uint8_t* s, size_t n, size_t m, uint64_t base, uint64_t* h) {
+    FenetreRoulante w(s, m, base);
+    h[0] = w.h;
+    for (size_t i = 1; i + m <= n; i++) {
+        w.glisser(s[i - 1], s[i + m - 1]);
+        h[i] = w.h;
+    }
+}
+
+/* occurrences chevauchantes */
+size_t compter_memmem(const uint8_t* s, size_t n, const std::string& motif) {
+    size_t c = 0;
+    const uint8_t* p = s;
+    while ((p = (const uint8_t*) memmem(p, s + n - p, motif.data(), motif.size()))) {
+        c++;
+        p++;
+    }
+    return c;
+}
+
+/*  commandes d'execution (texte aleatoire de 1 Go, ou un fichier donne) :
+    ./execs/tp_rabin_karp 1024 100 3 rabin_karp_out.txt
+    ./execs/tp_rabin_karp 0 1000 3 rabin_karp_fichier_out.txt gros_fichier.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_rabin_karp.cpp -o execs/tp_rabin_karp
+*/
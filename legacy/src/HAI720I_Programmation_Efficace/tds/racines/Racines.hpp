@@ -0,0 +1,330 @@
+#ifndef RACINES_H
+#define RACINES_H
+
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <omp.h>
+#include "../Simd.hpp"
+#include "../rationnel/Rationnel.hpp"
+
+/*  Toutes les racines complexes d'un polynome par la methode d'Aberth-
+    Ehrlich : les n approximations z(i) sont corrigees simultanement,
+
+        N(i) = p(z(i)) / p'(z(i))                     (pas de Newton)
+        S(i) = sum_{j != i} 1 / (z(i) - z(j))         (repulsion)
+        z(i) <- z(i) - N(i) / (1 - N(i) S(i))
+
+    convergence cubique pour les racines simples. p et p' sont evalues
+    ensemble par Horner en arithmetique complexe (D = D z + P, P = P z + a).
+    Pour |z| > 1 on evalue le polynome renverse en w = 1 / z (coefficients
+    dans l'ordre inverse), ce qui evite les debordements en degre eleve :
+
+        p(z) / p'(z) = z q(w) / (n q(w) - w q'(w))
+
+    Une racine est acceptee quand |p(z)| <= 4 n eps sum |a(k)| |z|^k (la
+    valeur n'est plus que de l'erreur d'arrondi de Horner) ou quand le pas
+    devient negligeable devant |z| ; elle n'est plus modifiee ensuite.
+
+    Version vectorisee : les racines sont traitees par blocs de K L (L voies,
+    parties reelles et imaginaires dans des vecteurs separes), les
+    coefficients sont diffuses, le choix direct / renverse et l'arret par
+    racine sont des masques par voie, les blocs entierement convergees sont
+    sautes. Les blocs sont mis a jour l'un apres l'autre (Gauss-Seidel entre
+    blocs), ce qui converge plus vite que des mises a jour toutes
+    simultanees. Les n inverses 1 / |z(i) - z(j)|^2 de S(i) dominent :
+    ModeDivision (Rationnel.hpp) permet de les remplacer par une
+    approximation materielle raffinee par Newton.
+
+    Approximations initiales (Bini) : sur l'enveloppe convexe superieure des
+    points (k, log |a(k)|), chaque segment [k1, k2] donne k2 - k1 points
+    equirepartis sur le cercle de rayon (|a(k1)| / |a(k2)|)^(1 / (k2 - k1)).
+
+        aberth_reference(p, r, iter_max)    std::complex, racine par racine
+        aberth(p, r, iter_max, isa)         vectorise
+        aberth_lot(ps, rs, iter_max, isa)   un polynome par tache, threads */
+
+#define RAC_EN_LIGNE SIMD_EN_LIGNE
+
+/* a(k), coefficient de z^k, k = 0 .. degre ; a(degre) != 0 */
+template <class S>
+struct Polynome {
+    std::vector<S> re, im;
+
+    int degre() const { return (int) re.size() - 1; }
+};
+
+template <class S>
+struct Racines {
+    std::vector<S> re, im;
+    std::vector<char> convergee;
+    int iterations = 0;
+
+    int nb_convergees() const { return (int) std::count(convergee.begin(), convergee.end(), 1); }
+};
+
+/* racines nulles (a(0) = ... = a(k0-1) = 0) placees d'office et convergees */
+template <class S>
+void racines_initiales(const Polynome<S>& p, Racines<S>& r) {
+    int n = p.degre();
+    r.re.assign(n, 0);
+    r.im.assign(n, 0);
+    r.convergee.assign(n, 0);
+    r.iterations = 0;
+    std::vector<int> hk;
+    std::vector<double> hl;
+    int pos = 0;
+    for (int k = 0; k <= n; k++) {
+        double m = std::abs(std::complex<double>(p.re[k], p.im[k]));
+        if (m == 0) {
+            if (k == pos && k < n) r.convergee[pos++] = 1;
+            continue;
+        }
+        double l = log(m);
+        while (hk.size() >= 2) {
+            size_t a = hk.size() - 2, b = hk.size() - 1;
+            if ((hk[b] - hk[a]) * (l - hl[a]) - (hl[b] - hl[a]) * (k - hk[a]) < 0) break;
+            hk.pop_back();
+            hl.pop_back();
+        }
+        hk.push_back(k);
+        hl.push_back(l);
+    }
+    const double sigma = 0.7, pi = 3.14159265358979323846;
+    for (size_t s = 0; s + 1 < hk.size(); s++) {
+        int d = hk[s + 1] - hk[s];
+        double rayon = exp((hl[s] - hl[s + 1]) / d);
+        for (int j = 0; j < d; j++) {
+            double angle = 2 * pi * j / d + 2 * pi * hk[s] / n + sigma;
+            r.re[pos] = (S) (rayon * cos(angle));
+            r.im[pos] = (S) (rayon * sin(angle));
+            pos++;
+        }
+    }
+}
+
+namespace rac_detail {
+
+/*  N = p(z) / p'(z) et test d'arret en un point, forme directe ou
+    renversee selon |z| */
+template <class S>
+inline bool newton_complexe(const Polynome<S>& p, std::complex<S> z, std::complex<S>& N) {
+    typedef std::complex<S> C;
+    int n = p.degre();
+    bool grand = std::norm(z) > 1;
+    C x = grand ? (S) 1 / z : z;
+    S ax = std::abs(x);
+    C P = 0, D = 0;
+    S B = 0;
+    for (int s = 0; s <= n; s++) {
+        int k = grand ? s : n - s;
+        C a(p.re[k], p.im[k]);
+        D = D * x + P;
+        P = P * x + a;
+        B = B * ax + std::abs(a);
+    }
+    S seuil = 4 * n * std::numeric_limits<S>::epsilon() * B;
+    N = grand ? z * P / ((S) n * P - x * D) : P / D;
+    return std::norm(P) <= seuil * seuil;
+}
+
+} // namespace rac_detail
+
+template <class S>
+int aberth_reference(const Polynome<S>& p, Racines<S>& r, int iter_max = 100) {
+    typedef std::complex<S> C;
+    const S eps = std::numeric_limits<S>::epsilon();
+    racines_initiales(p, r);
+    int n = p.degre();
+    std::vector<C> z(n);
+    for (int i = 0; i < n; i++) z[i] = C(r.re[i], r.im[i]);
+    int restantes = n - r.nb_convergees(), it = 0;
+    while (restantes > 0 && it < iter_max) {
+        it++;
+        for (int i = 0; i < n; i++) {
+            if (r.convergee[i]) continue;
+            C N;
+            bool fini = rac_detail::newton_complexe(p, z[i], N);
+            if (!fini) {
+                C s = 0;
+                for (int j = 0; j < n; j++) {
+                    if (j != i) s += (S) 1 / (z[i] - z[j]);
+                }
+                C w = N / ((S) 1 - N * s);
+                if (w == w) z[i] -= w;
+                fini = std::norm(w) <= eps * eps * std::norm(z[i]);
+            }
+            if (fini) {
+                r.convergee[i] = 1;
+                restantes--;
+            }
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        r.re[i] = z[i].real();
+        r.im[i] = z[i].imag();
+    }
+    r.iterations = it;
+    return it;
+}
+
+namespace rac_detail {
+
+/*  un balayage de toutes les racines par blocs de K vecteurs, actif = 1 pour
+    les racines encore corrigees ; renvoie vrai s'il en reste */
+template <class S, ModeDivision D>
+struct Balayage {
+    const S* ar;
+    const S* ai;
+    const S* aa;    /* |a(k)| */
+    int n;
+    S* zr;
+    S* zi;
+    S* actif;
+    size_t np;      /* n arrondi au multiple de K L, voies de bourrage inactives */
+    bool* reste;
+
+    template <int L> RAC_EN_LIGNE void executer() const {
+        typedef typename Simd<S, L>::v V;
+        typedef typename Simd<S, L>::vi M;
+        const int K = 2;
+        const S eps = std::numeric_limits<S>::epsilon();
+        const S seuil = 4 * n * eps;
+        const V un = V() + 1, zero = V();
+        bool encore = false;
+        for (size_t b = 0; b < np; b += K * L) {
+            bool occupe = false;
+            for (int l = 0; l < K * L; l++) occupe |= actif[b + l] != 0;
+            if (!occupe) continue;
+
+            V Zr[K], Zi[K], Xr[K], Xi[K], Ax[K], Pr[K], Pi[K], Dr[K], Di[K], B[K];
+            M grand[K];
+            #pragma GCC unroll 2
+            for (int k = 0; k < K; k++) {
+                memcpy(&Zr[k], zr + b + k * L, sizeof(V));
+                memcpy(&Zi[k], zi + b + k * L, sizeof(V));
+                V m2 = Zr[k] * Zr[k] + Zi[k] * Zi[k];
+                grand[k] = m2 > 1;
+                V inv = un / m2;
+                Xr[k] = grand[k] ? Zr[k] * inv : Zr[k];
+                Xi[k] = grand[k] ? -Zi[k] * inv : Zi[k];
+                V x2 = Xr[k] * Xr[k] + Xi[k] * Xi[k];
+                S ax[L];
+                for (int l = 0; l < L; l++) ax[l] = __builtin_sqrt(x2[l]);
+                memcpy(&Ax[k], ax, sizeof(V));
+                Pr[k] = Pi[k] = Dr[k] = Di[k] = B[k] = zero;
+            }
+            for (int s = 0; s <= n; s++) {
+                S fr = ar[n - s], fi = ai[n - s], fa = aa[n - s];
+                S rr = ar[s], ri = ai[s], ra = aa[s];
+                #pragma GCC unroll 2
+                for (int k = 0; k < K; k++) {
+                    V cr = grand[k] ? V() + rr : V() + fr;
+                    V ci = grand[k] ? V() + ri : V() + fi;
+                    V ca = grand[k] ? V() + ra : V() + fa;
+                    V dr = Dr[k] * Xr[k] - Di[k] * Xi[k] + Pr[k];
+                    Di[k] = Dr[k] * Xi[k] + Di[k] * Xr[k] + Pi[k];
+                    Dr[k] = dr;
+                    V pr = Pr[k] * Xr[k] - Pi[k] * Xi[k] + cr;
+                    Pi[k] = Pr[k] * Xi[k] + Pi[k] * Xr[k] + ci;
+                    Pr[k] = pr;
+                    B[k] = B[k] * Ax[k] + ca;
+                }
+            }
+            #pragma GCC unroll 2
+            for (int k = 0; k < K; k++) {
+                V act;
+                memcpy(&act, actif + b + k * L, sizeof(V));
+                V borne = seuil * B[k];
+                M conv = Pr[k] * Pr[k] + Pi[k] * Pi[k] <= borne * borne;
+
+                /* N = num / den */
+                V nr = grand[k] ? Zr[k] * Pr[k] - Zi[k] * Pi[k] : Pr[k];
+                V ni = grand[k] ? Zr[k] * Pi[k] + Zi[k] * Pr[k] : Pi[k];
+                V dr = grand[k] ? (S) n * Pr[k] - (Xr[k] * Dr[k] - Xi[k] * Di[k]) : Dr[k];
+                V di = grand[k] ? (S) n * Pi[k] - (Xr[k] * Di[k] + Xi[k] * Dr[k]) : Di[k];
+                V q = un / (dr * dr + di * di);
+                V Nr = (nr * dr + ni * di) * q;
+                V Ni = (ni * dr - nr * di) * q;
+
+                V Sr = zero, Si = zero;
+                for (int j = 0; j < n; j++) {
+                    V er = Zr[k] - zr[j], ei = Zi[k] - zi[j];
+                    V e2 = er * er + ei * ei;
+                    V r;
+                    rat_detail::quotient<S, L, D>(r, un, e2);
+                    r = e2 == 0 ? zero : r;
+                    Sr += er * r;
+                    Si -= ei * r;
+                }
+
+                /* w = N / (1 - N S) */
+                V tr = un - (Nr * Sr - Ni * Si);
+                V ti = -(Nr * Si + Ni * Sr);
+                q = un / (tr * tr + ti * ti);
+                V wr = (Nr * tr + Ni * ti) * q;
+                V wi = (Ni * tr - Nr * ti) * q;
+                V nzr = Zr[k] - wr, nzi = Zi[k] - wi;
+                M vivant = act != 0;
+                M maj = vivant & ~conv & (nzr == nzr) & (nzi == nzi);
+                Zr[k] = maj ? nzr : Zr[k];
+                Zi[k] = maj ? nzi : Zi[k];
+                M pas_nul = wr * wr + wi * wi <= eps * eps * (Zr[k] * Zr[k] + Zi[k] * Zi[k]);
+                act = vivant & ~conv & ~pas_nul ? un : zero;
+                memcpy(zr + b + k * L, &Zr[k], sizeof(V));
+                memcpy(zi + b + k * L, &Zi[k], sizeof(V));
+                memcpy(actif + b + k * L, &act, sizeof(V));
+                for (int l = 0; l < L; l++) encore |= act[l] != 0;
+            }
+        }
+        *reste = encore;
+    }
+};
+
+} // namespace rac_detail
+
+template <ModeDivision D = RECIPROQUE_NEWTON, class S>
+int aberth(const Polynome<S>& p, Racines<S>& r, int iter_max = 100, Isa isa = ISA_AUTO) {
+    racines_initiales(p, r);
+    int n = p.degre();
+    isa = isa_effective(isa);
+    size_t bloc = 2 * voies<S>(isa);
+    size_t np = (n + bloc - 1) / bloc * bloc;
+    std::vector<S> zr(np, 0), zi(np, 0), actif(np, 0), aa(n + 1);
+    for (int i = 0; i < n; i++) {
+        zr[i] = r.re[i];
+        zi[i] = r.im[i];
+        actif[i] = !r.convergee[i];
+    }
+    for (int k = 0; k <= n; k++) aa[k] = std::abs(std::complex<S>(p.re[k], p.im[k]));
+    bool reste = std::count(actif.begin(), actif.end(), (S) 1) > 0;
+    rac_detail::Balayage<S, D> e = {p.re.data(), p.im.data(), aa.data(), n, zr.data(), zi.data(),
+                                    actif.data(), np, &reste};
+    int it = 0;
+    while (it < iter_max && reste) {
+        it++;
+        lancer_simd<S>(e, isa);
+    }
+    for (int i = 0; i < n; i++) {
+        r.re[i] = zr[i];
+        r.im[i] = zi[i];
+        r.convergee[i] = actif[i] == 0;
+    }
+    r.iterations = it;
+    return it;
+}
+
+/* un polynome par tache : les degres et nombres d'iterations varient */
+template <ModeDivision D = RECIPROQUE_NEWTON, class S>
+void aberth_lot(const std::vector<Polynome<S>>& ps, std::vector<Racines<S>>& rs, int iter_max = 100,
+                Isa isa = ISA_AUTO) {
+    rs.resize(ps.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long i = 0; i < (long) ps.size(); i++) aberth<D>(ps[i], rs[i], iter_max, isa);
+}
+
+#endif // RACINES_H
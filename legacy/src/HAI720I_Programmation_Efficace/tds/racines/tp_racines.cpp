@@ -0,0 +1,190 @@
+/* toutes les racines de polynomes de degre 50 a 500 par Aberth-Ehrlich :
+   reference std::complex, version vectorisee sur les racines, lot de
+   polynomes sur plusieurs threads */
+#include "../EvalPerf.hpp"
+#include "Racines.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+Polynome<double> polynome_aleatoire(int, std::mt19937_64&);
+Polynome<double> racines_unite(int);
+template <class S> double erreur_inverse(const Polynome<S>&, const Racines<S>&);
+template <class S> double erreur_racines_unite(const Racines<S>&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\ndegree nb_polynomials number_of_loops output_file\n");
+        return -1;
+    }
+    int n = atoi(argv[1]);
+    int nb = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    const int iter_max = 200;
+    EvalPerf PE;
+
+    std::mt19937_64 gen(42);
+    std::vector<Polynome<double>> ps;
+    for (int i = 0; i < nb; i++) ps.push_back(polynome_aleatoire(n, gen));
+
+    /* precision : z^n - 1 (racines connues) et polynomes aleatoires
+       (erreur inverse |p(z)| / sum |a(k)| |z|^k) */
+    struct Solveur {
+        std::string nom;
+        std::function<int(const Polynome<double>&, Racines<double>&)> f;
+    };
+    std::vector<Solveur> solveurs = {
+        {"reference std::complex", [&](const Polynome<double>& p, Racines<double>& r) {
+            return aberth_reference(p, r, iter_max); }},
+    };
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        Isa i = (Isa) isa;
+        solveurs.push_back({std::string(NOMS_ISA[isa]) + ", division", [=](const Polynome<double>& p, Racines<double>& r) {
+            return aberth<DIVISION>(p, r, iter_max, i); }});
+        solveurs.push_back({std::string(NOMS_ISA[isa]) + ", reciproque + Newton", [=](const Polynome<double>& p, Racines<double>& r) {
+            return aberth<RECIPROQUE_NEWTON>(p, r, iter_max, i); }});
+    }
+
+    fichier << "degre " << n << ", " << nb << " polynomes a coefficients gaussiens complexes\n";
+    Polynome<double> unite = racines_unite(n);
+    for (const Solveur& so : solveurs) {
+        Racines<double> r;
+        double nbc = 0, nbs = 0, iterations = 0, pire = 0;
+        int non_convergees = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            for (const Polynome<double>& p : ps) {
+                PE.start();
+                iterations += so.f(p, r);
+                PE.stop();
+                PE.nb_c();
+                nbc += PE.nb_tot;
+                nbs += PE.nb_s();
+                pire = std::max(pire, erreur_inverse(p, r));
+                non_convergees += n - r.nb_convergees();
+            }
+        }
+        double nb_resolutions = (double) number_of_loops * nb;
+        so.f(unite, r);
+        fichier << "    " << so.nom << ":\n";
+        fichier << "        iterations/polynome " << iterations / nb_resolutions << ", cycles/polynome "
+                << nbc / nb_resolutions << ", ms/polynome " << 1e3 * nbs / nb_resolutions << "\n";
+        fichier << "        erreur inverse max " << pire << ", racines non convergees " << non_convergees
+                << ", z^n - 1: erreur max " << erreur_racines_unite(r) << " en " << r.iterations << " iterations\n";
+    }
+
+    /* simple precision : deux fois plus de voies, seuil d'arret en eps float */
+    std::vector<Polynome<float>> pf(nb);
+    for (int i = 0; i < nb; i++) {
+        pf[i].re.assign(ps[i].re.begin(), ps[i].re.end());
+        pf[i].im.assign(ps[i].im.begin(), ps[i].im.end());
+    }
+    Polynome<float> unite_f;
+    unite_f.re.assign(unite.re.begin(), unite.re.end());
+    unite_f.im.assign(unite.im.begin(), unite.im.end());
+    fichier << "float :\n";
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        Racines<float> r;
+        double nbs = 0, iterations = 0, pire = 0;
+        int non_convergees = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            for (const Polynome<float>& p : pf) {
+                PE.start();
+                iterations += aberth(p, r, iter_max, (Isa) isa);
+                PE.stop();
+                nbs += PE.nb_s();
+                pire = std::max(pire, erreur_inverse(p, r));
+                non_convergees += n - r.nb_convergees();
+            }
+        }
+        double nb_resolutions = (double) number_of_loops * nb;
+        aberth(unite_f, r, iter_max, (Isa) isa);
+        fichier << "    " << NOMS_ISA[isa] << ", reciproque + Newton: iterations/polynome "
+                << iterations / nb_resolutions << ", ms/polynome " << 1e3 * nbs / nb_resolutions
+                << ", erreur inverse max " << pire << ", racines non convergees " << non_convergees
+                << ", z^n - 1: erreur max " << erreur_racines_unite(r) << "\n";
+    }
+
+    /* lot sur tous les threads */
+    std::vector<int> threads = {1};
+    if (omp_get_max_threads() > 1) threads.push_back(omp_get_max_threads());
+    for (int t : threads) {
+        std::vector<Racines<double>> rs;
+        double nbs = 0;
+        omp_set_num_threads(t);
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            aberth_lot(ps, rs, iter_max);
+            PE.stop();
+            nbs += PE.nb_s();
+        }
+        fichier << "    aberth_lot, " << t << " threads: " << number_of_loops * nb / nbs << " polynomes/s\n";
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+Polynome<double> polynome_aleatoire(int n, std::mt19937_64& gen) {
+    std::normal_distribution<double> g(0, 1);
+    Polynome<double> p;
+    for (int k = 0; k <= n; k++) {
+        p.re.push_back(g(gen));
+        p.im.push_back(g(gen));
+    }
+    return p;
+}
+
+Polynome<double> racines_unite(int n) {
+    Polynome<double> p;
+    p.re.assign(n + 1, 0);
+    p.im.assign(n + 1, 0);
+    p.re[0] = -1;
+    p.re[n] = 1;
+    return p;
+}
+
+template <class S>
+double erreur_inverse(const Polynome<S>& p, const Racines<S>& r) {
+    double pire = 0;
+    for (size_t i = 0; i < r.re.size(); i++) {
+        std::complex<long double> z(r.re[i], r.im[i]), v = 0;
+        long double b = 0, az = std::abs(z);
+        for (int k = p.degre(); k >= 0; k--) {
+            std::complex<long double> a(p.re[k], p.im[k]);
+            v = v * z + a;
+            b = b * az + std::abs(a);
+        }
+        pire = std::max(pire, (double) (std::abs(v) / b));
+    }
+    return pire;
+}
+
+/* distance de chaque racine a la racine n-ieme de l'unite la plus proche */
+template <class S>
+double erreur_racines_unite(const Racines<S>& r) {
+    int n = (int) r.re.size();
+    double pire = 0;
+    for (int i = 0; i < n; i++) {
+        double k = round(atan2(r.im[i], r.re[i]) * n / (2 * M_PI));
+        std::complex<double> exact = std::polar(1.0, 2 * M_PI * k / n);
+        pire = std::max(pire, std::abs(std::complex<double>(r.re[i], r.im[i]) - exact));
+    }
+    return pire;
+}
+
+/*  commandes d'execution:
+    ./execs/tp_racines 100 200 3 racines_out.txt
+    ./execs/tp_racines 500 20 3 racines_out_500.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_racines.cpp -o execs/tp_racines
+*/
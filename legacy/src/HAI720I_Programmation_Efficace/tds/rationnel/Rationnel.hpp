@@ -0,0 +1,225 @@
+#ifndef RATIONNEL_H
+#define RATIONNEL_H
+
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "../Simd.hpp"
+#include "../Horner.hpp"
+
+/*  Fonctions rationnelles R(x) = P(x) / Q(x), P de degre np - 1, Q de
+    degre nq - 1 (approximants de Pade, fractions continues tronquees).
+
+    P et Q sont evalues par deux chaines de Horner entrelacees dans la meme
+    boucle : les deux fma d'une etape sont independantes, la latence d'un
+    point est celle du plus long des deux polynomes et non leur somme. Une
+    seule division par point, ou bien une approximation materielle de 1/Q
+    (rcpps 12 bits, vrcp14 14 bits) raffinee par Newton :
+
+        r <- r + r (1 - Q r)        double le nombre de bits exacts
+
+    ce qui evite le diviseur (non pipeline, ~4 a 16 cycles par vecteur)
+    au prix de 2 ou 3 fma par pas et d'environ 1 ulp de plus. Sans
+    approximation materielle (double en sse2 et avx2), la division reste.
+
+        rationnel(p, np, q, nq, x)        nombres de coefficients a l'execution
+        Rationnel<NP, NQ>::f(p, q, x)     connus a la compilation, deroule
+        rationnel_lot(r, x, y, m, ...)    par vecteurs, version choisie a
+                                          l'execution (Simd.hpp)
+        pade(a, L, M)                     approximant [L/M] depuis la serie de
+                                          Taylor a(0..L+M) */
+
+#define RAT_EN_LIGNE SIMD_EN_LIGNE
+
+enum ModeDivision { DIVISION, RECIPROQUE_NEWTON };
+
+/* P(x) et Q(x) par deux chaines entrelacees */
+template <class T, class S>
+RAT_EN_LIGNE void horner_entrelace(const S* p, int np, const S* q, int nq, const T& x, T& P, T& Q) {
+    P = T();
+    Q = T();
+    int k = std::max(np, nq) - 1;
+    for (; k >= nq; k--) P = P * x + p[k];
+    for (; k >= np; k--) Q = Q * x + q[k];
+    for (; k >= 0; k--) {
+        P = P * x + p[k];
+        Q = Q * x + q[k];
+    }
+}
+
+template <class T, class S>
+inline T rationnel(const S* p, int np, const S* q, int nq, T x) {
+    T P, Q;
+    horner_entrelace(p, np, q, nq, x, P, Q);
+    return P / Q;
+}
+
+template <int NP, int NQ> struct Rationnel {
+    template <class T, class S> static RAT_EN_LIGNE void paire(const S* p, const S* q, const T& x, T& P, T& Q) {
+        Horner<NP>::f(P, p, x);
+        Horner<NQ>::f(Q, q, x);
+    }
+    template <class T, class S> static RAT_EN_LIGNE T f(const S* p, const S* q, T x) {
+        T P, Q;
+        paire(p, q, x, P, Q);
+        return P / Q;
+    }
+};
+
+template <class S>
+struct FonctionRationnelle {
+    std::vector<S> p, q;
+
+    S operator()(S x) const { return rationnel(p.data(), (int) p.size(), q.data(), (int) q.size(), x); }
+};
+
+/*  approximant de Pade [L/M] de la serie sum a(k) x^k (a de taille >= L+M+1),
+    q(0) = 1 : les coefficients de x^(L+1) .. x^(L+M) de Q(x) A(x) sont nuls
+    (systeme M x M, Gauss avec pivot partiel en long double), puis P est la
+    troncature de Q A au degre L */
+template <class S>
+FonctionRationnelle<S> pade(const std::vector<long double>& a, int L, int M) {
+    auto coef = [&](int k) { return k >= 0 && k < (int) a.size() ? a[k] : 0.0L; };
+    std::vector<std::vector<long double>> A(M, std::vector<long double>(M + 1));
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < M; j++) A[i][j] = coef(L + 1 + i - (j + 1));
+        A[i][M] = -coef(L + 1 + i);
+    }
+    for (int c = 0; c < M; c++) {
+        int piv = c;
+        for (int i = c + 1; i < M; i++) if (fabsl(A[i][c]) > fabsl(A[piv][c])) piv = i;
+        std::swap(A[c], A[piv]);
+        for (int i = 0; i < M; i++) {
+            if (i == c || A[c][c] == 0) continue;
+            long double f = A[i][c] / A[c][c];
+            for (int j = c; j <= M; j++) A[i][j] -= f * A[c][j];
+        }
+    }
+    std::vector<long double> q(M + 1, 1);
+    for (int j = 0; j < M; j++) q[j + 1] = A[j][M] / A[j][j];
+    FonctionRationnelle<S> r;
+    for (int k = 0; k <= L; k++) {
+        long double s = 0;
+        for (int j = 0; j <= std::min(k, M); j++) s += q[j] * coef(k - j);
+        r.p.push_back((S) s);
+    }
+    for (int j = 0; j <= M; j++) r.q.push_back((S) q[j]);
+    return r;
+}
+
+namespace rat_detail {
+
+/* approximation materielle de 1/x et sa precision en bits (0 : aucune) */
+template <class S, int L> struct ApproxInverse {
+    static const int BITS = 0;
+    static RAT_EN_LIGNE void f(typename Simd<S, L>::v& r, const typename Simd<S, L>::v& x) { r = 1 / x; }
+};
+template <> struct ApproxInverse<float, 4> {
+    static const int BITS = 12;
+    static RAT_EN_LIGNE void f(Simd<float, 4>::v& r, const Simd<float, 4>::v& x) { r = __builtin_ia32_rcpps(x); }
+};
+template <> struct ApproxInverse<float, 8> {
+    static const int BITS = 12;
+    static SIMD_EN_LIGNE_AVX2 void f(Simd<float, 8>::v& r, const Simd<float, 8>::v& x) { r = __builtin_ia32_rcpps256(x); }
+};
+template <> struct ApproxInverse<float, 16> {
+    static const int BITS = 14;
+    static SIMD_EN_LIGNE_AVX512 void f(Simd<float, 16>::v& r, const Simd<float, 16>::v& x) {
+        r = __builtin_ia32_rcp14ps512_mask(x, x, (unsigned short) -1);
+    }
+};
+template <> struct ApproxInverse<double, 8> {
+    static const int BITS = 14;
+    static SIMD_EN_LIGNE_AVX512 void f(Simd<double, 8>::v& r, const Simd<double, 8>::v& x) {
+        r = __builtin_ia32_rcp14pd512_mask(x, x, (unsigned char) -1);
+    }
+};
+
+/* R = P / Q */
+template <class S, int L, ModeDivision D>
+RAT_EN_LIGNE void quotient(typename Simd<S, L>::v& R, const typename Simd<S, L>::v& P,
+                           const typename Simd<S, L>::v& Q) {
+    typedef ApproxInverse<S, L> A;
+    if (D == DIVISION || A::BITS == 0) {
+        R = P / Q;
+        return;
+    }
+    typename Simd<S, L>::v r;
+    A::f(r, Q);
+    for (int b = A::BITS; b < (int) (sizeof(S) == 4 ? 24 : 53); b *= 2) r = r + r * (1 - Q * r);
+    R = P * r;
+}
+
+/* coefficients connus a l'execution */
+template <class S> struct Execution {
+    const S* p;
+    const S* q;
+    int np, nq;
+    template <class T> RAT_EN_LIGNE void operator()(const T& x, T& P, T& Q) const { horner_entrelace(p, np, q, nq, x, P, Q); }
+};
+
+/* coefficients connus a la compilation */
+template <class S, int NP, int NQ> struct Compilation {
+    const S* p;
+    const S* q;
+    template <class T> RAT_EN_LIGNE void operator()(const T& x, T& P, T& Q) const { Rationnel<NP, NQ>::paire(p, q, x, P, Q); }
+};
+
+/* K vecteurs par iteration : 2 K chaines independantes */
+template <class S, int L, int K, ModeDivision D, class E>
+RAT_EN_LIGNE void rationnel_voies(const E& e, const S* x, S* y, size_t m) {
+    typedef typename Simd<S, L>::v V;
+    size_t i = 0;
+    for (; i + K * L <= m; i += K * L) {
+        V t[K], P[K], Q[K];
+        memcpy(t, x + i, sizeof(t));
+        #pragma GCC unroll 8
+        for (int k = 0; k < K; k++) e(t[k], P[k], Q[k]);
+        #pragma GCC unroll 8
+        for (int k = 0; k < K; k++) quotient<S, L, D>(t[k], P[k], Q[k]);
+        memcpy(y + i, t, sizeof(t));
+    }
+    for (; i < m; i++) {
+        S P, Q;
+        e(x[i], P, Q);
+        y[i] = P / Q;
+    }
+}
+
+template <class S, ModeDivision D, class E> SIMD_CIBLE_SSE2 void rationnel_sse2(E e, const S* x, S* y, size_t m) {
+    rationnel_voies<S, voies<S>(ISA_SSE2), 4, D>(e, x, y, m);
+}
+template <class S, ModeDivision D, class E> SIMD_CIBLE_AVX2 void rationnel_avx2(E e, const S* x, S* y, size_t m) {
+    rationnel_voies<S, voies<S>(ISA_AVX2), 4, D>(e, x, y, m);
+}
+template <class S, ModeDivision D, class E> SIMD_CIBLE_AVX512 void rationnel_avx512(E e, const S* x, S* y, size_t m) {
+    rationnel_voies<S, voies<S>(ISA_AVX512), 4, D>(e, x, y, m);
+}
+
+template <class S, ModeDivision D, class E>
+inline void rationnel_lot(const E& e, const S* x, S* y, size_t m, Isa isa) {
+    isa = isa_effective(isa);
+    if (isa == ISA_AVX512) rationnel_avx512<S, D>(e, x, y, m);
+    else if (isa == ISA_AVX2) rationnel_avx2<S, D>(e, x, y, m);
+    else rationnel_sse2<S, D>(e, x, y, m);
+}
+
+} // namespace rat_detail
+
+/* y[i] = r(x[i]) */
+template <ModeDivision D = DIVISION, class S>
+inline void rationnel_lot(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m, Isa isa = ISA_AUTO) {
+    rat_detail::Execution<S> e = {r.p.data(), r.q.data(), (int) r.p.size(), (int) r.q.size()};
+    rat_detail::rationnel_lot<S, D>(e, x, y, m, isa);
+}
+
+/* idem, np et nq fixes : r.p et r.q doivent avoir NP et NQ coefficients */
+template <int NP, int NQ, ModeDivision D = DIVISION, class S>
+inline void rationnel_lot(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m, Isa isa = ISA_AUTO) {
+    rat_detail::Compilation<S, NP, NQ> e = {r.p.data(), r.q.data()};
+    rat_detail::rationnel_lot<S, D>(e, x, y, m, isa);
+}
+
+#endif // RATIONNEL_H
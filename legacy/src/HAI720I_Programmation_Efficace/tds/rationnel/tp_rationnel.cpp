@@ -0,0 +1,199 @@
+/* fonctions rationnelles P/Q : chaines de Horner entrelacees et une seule
+   division (ou reciproque + Newton) contre deux evaluations separees */
+#include "../EvalPerf.hpp"
+#include "Rationnel.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+#define RAT_SCALAIRE __attribute__((noinline, optimize("no-tree-vectorize")))
+
+template <class S> void separees(const FonctionRationnelle<S>&, const S*, S*, size_t);
+template <class S> void deux_passes(const FonctionRationnelle<S>&, const S*, S*, size_t);
+template <class S> void entrelacee(const FonctionRationnelle<S>&, const S*, S*, size_t);
+template <class S> void fixe_6_6(const FonctionRationnelle<S>&, const S*, S*, size_t);
+template <class S> void separees_lot(const FonctionRationnelle<S>&, const S*, S*, size_t, Isa);
+template <class S> void mesurer_type(const char*, int, int, size_t, int, std::ofstream&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 6) {
+        printf("You must enter the following details:\nnumerator_degree denominator_degree nb_points number_of_loops output_file\n");
+        return -1;
+    }
+    int L = atoi(argv[1]), M = atoi(argv[2]);
+    size_t m = atol(argv[3]);
+    int number_of_loops = atoi(argv[4]);
+    std::ofstream fichier {argv[5]};
+
+    mesurer_type<double>("double", L, M, m, number_of_loops, fichier);
+    mesurer_type<float>("float", L, M, m, number_of_loops, fichier);
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* serie de Taylor de exp */
+std::vector<long double> taylor_exp(int n) {
+    std::vector<long double> a(n, 1);
+    for (int k = 1; k < n; k++) a[k] = a[k - 1] / k;
+    return a;
+}
+
+template <class S>
+void mesurer_type(const char* type, int L, int M, size_t m, int number_of_loops, std::ofstream& fichier) {
+    EvalPerf PE;
+    FonctionRationnelle<S> r = pade<S>(taylor_exp(L + M + 1), L, M);
+    FonctionRationnelle<S> r66 = pade<S>(taylor_exp(13), 6, 6);
+    std::vector<S> x(m), y(m);
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> u(-0.5, 0.5);
+    for (size_t i = 0; i < m; i++) x[i] = (S) u(gen);
+
+    /* erreur relative max contre P/Q evalue en long double, en ulp de S */
+    auto erreur = [&](const FonctionRationnelle<S>& f, const std::vector<S>& z) {
+        long double pire = 0;
+        for (size_t i = 0; i < m; i++) {
+            long double exact = rationnel(f.p.data(), (int) f.p.size(), f.q.data(), (int) f.q.size(),
+                                          (long double) x[i]);
+            pire = std::max(pire, fabsl(z[i] - exact) / fabsl(exact));
+        }
+        return (double) (pire / std::numeric_limits<S>::epsilon());
+    };
+
+    fichier << type << ", exp [" << L << "/" << M << "] sur [-0.5, 0.5]\n";
+    {
+        long double pire = 0;
+        for (size_t i = 0; i < m; i++) {
+            long double P, Q;
+            horner_entrelace(r.p.data(), (int) r.p.size(), r.q.data(), (int) r.q.size(), (long double) x[i], P, Q);
+            pire = std::max(pire, fabsl(P / Q - expl((long double) x[i])) / expl((long double) x[i]));
+        }
+        fichier << "    erreur relative a exp (coefficients arrondis): " << (double) pire << "\n";
+    }
+
+    struct Mesure {
+        std::string nom;
+        const FonctionRationnelle<S>* f;
+        std::function<void()> g;
+    };
+    std::vector<Mesure> mesures = {
+        {"separees (P puis Q par point)", &r, [&] { separees(r, x.data(), y.data(), m); }},
+        {"deux passes (P partout, puis Q)", &r, [&] { deux_passes(r, x.data(), y.data(), m); }},
+        {"entrelacee", &r, [&] { entrelacee(r, x.data(), y.data(), m); }},
+        {"[6/6] entrelacee", &r66, [&] { entrelacee(r66, x.data(), y.data(), m); }},
+        {"[6/6] Rationnel<7, 7>", &r66, [&] { fixe_6_6(r66, x.data(), y.data(), m); }},
+    };
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        std::string n = NOMS_ISA[isa];
+        Isa i = (Isa) isa;
+        mesures.push_back({"lot " + n + " separees", &r, [&, i] { separees_lot(r, x.data(), y.data(), m, i); }});
+        mesures.push_back({"lot " + n + " entrelacee, division", &r,
+                           [&, i] { rationnel_lot<DIVISION>(r, x.data(), y.data(), m, i); }});
+        mesures.push_back({"lot " + n + " entrelacee, reciproque + Newton", &r,
+                           [&, i] { rationnel_lot<RECIPROQUE_NEWTON>(r, x.data(), y.data(), m, i); }});
+        mesures.push_back({"lot " + n + " [6/6] entrelacee, division", &r66,
+                           [&, i] { rationnel_lot<DIVISION>(r66, x.data(), y.data(), m, i); }});
+        mesures.push_back({"lot " + n + " [6/6] Rationnel<7, 7>, division", &r66,
+                           [&, i] { rationnel_lot<7, 7, DIVISION>(r66, x.data(), y.data(), m, i); }});
+        mesures.push_back({"lot " + n + " [6/6] Rationnel<7, 7>, reciproque + Newton", &r66,
+                           [&, i] { rationnel_lot<7, 7, RECIPROQUE_NEWTON>(r66, x.data(), y.data(), m, i); }});
+    }
+    for (const Mesure& me : mesures) {
+        double nbc = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            me.g();
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+        }
+        fichier << "    " << me.nom << ": cycles/point " << nbc / number_of_loops / m << ", erreur "
+                << erreur(*me.f, y) << " ulp\n";
+    }
+}
+
+template <class S>
+RAT_SCALAIRE void separees(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    for (size_t i = 0; i < m; i++) {
+        S P = horner(r.p.data(), (int) r.p.size(), x[i]);
+        S Q = horner(r.q.data(), (int) r.q.size(), x[i]);
+        y[i] = P / Q;
+    }
+}
+
+template <class S>
+RAT_SCALAIRE void deux_passes(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    for (size_t i = 0; i < m; i++) y[i] = horner(r.p.data(), (int) r.p.size(), x[i]);
+    for (size_t i = 0; i < m; i++) y[i] /= horner(r.q.data(), (int) r.q.size(), x[i]);
+}
+
+template <class S>
+RAT_SCALAIRE void entrelacee(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    for (size_t i = 0; i < m; i++) y[i] = r(x[i]);
+}
+
+template <class S>
+RAT_SCALAIRE void fixe_6_6(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    const S* p = r.p.data();
+    const S* q = r.q.data();
+    for (size_t i = 0; i < m; i++) y[i] = Rationnel<7, 7>::f(p, q, x[i]);
+}
+
+/* P sur tous les points puis Q, par vecteurs de L voies, 4 vecteurs par tour */
+template <class S, int L>
+RAT_EN_LIGNE void separees_voies(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    typedef typename Simd<S, L>::v V;
+    const S* c[2] = {r.p.data(), r.q.data()};
+    int n[2] = {(int) r.p.size(), (int) r.q.size()};
+    for (int passe = 0; passe < 2; passe++) {
+        size_t i = 0;
+        for (; i + 4 * L <= m; i += 4 * L) {
+            V t[4], v[4];
+            memcpy(t, x + i, sizeof(t));
+            #pragma GCC unroll 4
+            for (int k = 0; k < 4; k++) horner(v[k], c[passe], n[passe], t[k]);
+            if (passe == 1) {
+                memcpy(t, y + i, sizeof(t));
+                #pragma GCC unroll 4
+                for (int k = 0; k < 4; k++) v[k] = t[k] / v[k];
+            }
+            memcpy(y + i, v, sizeof(v));
+        }
+        for (; i < m; i++) {
+            S v = horner(c[passe], n[passe], x[i]);
+            y[i] = passe ? y[i] / v : v;
+        }
+    }
+}
+
+template <class S> SIMD_CIBLE_SSE2 void separees_sse2(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    separees_voies<S, voies<S>(ISA_SSE2)>(r, x, y, m);
+}
+template <class S> SIMD_CIBLE_AVX2 void separees_avx2(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    separees_voies<S, voies<S>(ISA_AVX2)>(r, x, y, m);
+}
+template <class S> SIMD_CIBLE_AVX512 void separees_avx512(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m) {
+    separees_voies<S, voies<S>(ISA_AVX512)>(r, x, y, m);
+}
+
+template <class S>
+void separees_lot(const FonctionRationnelle<S>& r, const S* x, S* y, size_t m, Isa isa) {
+    if (isa == ISA_AVX512) separees_avx512(r, x, y, m);
+    else if (isa == ISA_AVX2) separees_avx2(r, x, y, m);
+    else separees_sse2(r, x, y, m);
+}
+
+/*  commandes d'execution:
+    ./execs/tp_rationnel 8 8 1000000 10 rationnel_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_rationnel.cpp -o execs/tp_rationnel
+*/
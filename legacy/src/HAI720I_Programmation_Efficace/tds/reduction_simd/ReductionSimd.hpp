@@ -0,0 +1,299 @@
+#ifndef REDUCTION_SIMD_H
+#define REDUCTION_SIMD_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+#include <omp.h>
+#include "../Simd.hpp"
+
+/*  Reductions vectorisees sur int32_t, int64_t, float, double : somme,
+    produit scalaire, minimum, maximum, argmin, argmax (premier indice en
+    cas d'egalite ; pas de NaN). Entiers : somme et produits modulo 2^32 ou
+    2^64, comme les operations machine.
+
+    Chaque thread reduit son bloc avec K accumulateurs vectoriels de L
+    voies (L selon l'isa) : K chaines de dependances independantes, la
+    latence de l'addition (4 cycles en flottant) ne limite plus le debit.
+    Les resultats partiels des threads sont combines dans l'ordre des
+    threads ; sous REDUCTION_SEUIL_THREADS elements, pas de region
+    parallele (son cout depasse celui de la reduction).
+
+    En flottant le resultat d'une somme depend de cet ordre (isa, K,
+    nombre de threads). Option deterministe : le tableau est coupe en blocs
+    de REDUCTION_BLOC elements repartis sur les threads ; dans un bloc
+    l'element i va dans l'accumulateur i % W (W = REDUCTION_OCTETS /
+    sizeof(S) voies, soit W / L vecteurs quelle que soit l'isa), les W
+    accumulateurs sont sommes par paires, puis les blocs dans l'ordre. Les
+    produits sont arrondis avant l'addition (pas de fma, absente en sse2) :
+    meme resultat au bit pres pour toute isa et tout nombre de threads. */
+
+#ifndef REDUCTION_ACCUMULATEURS
+#define REDUCTION_ACCUMULATEURS 4
+#endif
+#ifndef REDUCTION_BLOC
+#define REDUCTION_BLOC (1 << 14)
+#endif
+#ifndef REDUCTION_SEUIL_THREADS
+#define REDUCTION_SEUIL_THREADS (1 << 15)
+#endif
+#define REDUCTION_OCTETS 128
+
+struct OptionsReduction {
+    Isa isa = ISA_AUTO;
+    int accumulateurs = REDUCTION_ACCUMULATEURS;    /* 1, 2, 4 ou 8 */
+    bool deterministe = false;
+};
+
+template <class S>
+struct ValeurIndice {
+    S valeur;
+    size_t indice;
+};
+
+namespace reduc_detail {
+
+/* entiers : calcul en non signe (debordement defini) */
+template <class S> using Acc = typename std::conditional<std::is_integral<S>::value,
+                                                         typename EntierDe<S>::non_signe, S>::type;
+template <class S, int L> using VecAcc = typename std::conditional<std::is_integral<S>::value,
+                                                                   typename Simd<S, L>::vu,
+                                                                   typename Simd<S, L>::v>::type;
+
+/* vecteur par reference (Simd.hpp) */
+template <class V, class S>
+SIMD_EN_LIGNE void charger(V& v, const S* p) {
+    memcpy(&v, p, sizeof(V));
+}
+
+/*  somme sur [deb, fin) de x[i] (ou x[i] y[i]) ; sorties : les K L voies
+    dans l'ordre des elements (w[i % (K L)]), queue scalaire comprise */
+template <class S, int L, int K, bool PRODUIT, bool ARRONDI>
+SIMD_EN_LIGNE void accumuler(const S* x, const S* y, size_t deb, size_t fin, Acc<S>* w) {
+    typedef VecAcc<S, L> V;
+    V a[K];
+    for (int k = 0; k < K; k++) a[k] = V();
+    size_t i = deb;
+    for (; i + K * L <= fin; i += K * L) {
+        #pragma GCC unroll 8
+        for (int k = 0; k < K; k++) {
+            V v;
+            charger(v, x + i + k * L);
+            if constexpr (PRODUIT) {
+                V u;
+                charger(u, y + i + k * L);
+                v *= u;
+                /* le produit arrondi avant l'addition : pas de contraction en fma */
+                if constexpr (ARRONDI) asm("" : "+v"(v));
+            }
+            a[k] += v;
+        }
+    }
+    for (int k = 0; k < K; k++) {
+        for (int j = 0; j < L; j++) w[k * L + j] = a[k][j];
+    }
+    for (size_t r = 0; i < fin; i++, r++) {
+        Acc<S> v = (Acc<S>) x[i];
+        if constexpr (PRODUIT) {
+            Acc<S> p = v * (Acc<S>) y[i];
+            if constexpr (ARRONDI && !std::is_integral<S>::value) asm("" : "+x"(p));
+            v = p;
+        }
+        w[r] += v;
+    }
+}
+
+/* somme par paires de w[0 .. W - 1], W puissance de 2 */
+template <class T>
+T par_paires(T* w, int W) {
+    for (int p = W / 2; p > 0; p /= 2) {
+        for (int j = 0; j < p; j++) w[j] += w[j + p];
+    }
+    return w[0];
+}
+
+template <class S, bool PRODUIT>
+struct Somme {
+    const S* x;
+    const S* y;
+    size_t n;
+    OptionsReduction o;
+    Acc<S>* partiels;   /* un par thread, ou un par bloc si deterministe */
+
+    template <int L, int K> SIMD_EN_LIGNE Acc<S> rapide(size_t deb, size_t fin) const {
+        Acc<S> w[K * L];
+        accumuler<S, L, K, PRODUIT, false>(x, y, deb, fin, w);
+        Acc<S> s = 0;
+        for (int j = 0; j < K * L; j++) s += w[j];
+        return s;
+    }
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        if (o.deterministe) {
+            constexpr int W = REDUCTION_OCTETS / sizeof(S);
+            size_t nb_blocs = (n + REDUCTION_BLOC - 1) / REDUCTION_BLOC;
+            #pragma omp for schedule(static)
+            for (size_t b = 0; b < nb_blocs; b++) {
+                Acc<S> w[W];
+                accumuler<S, L, W / L, PRODUIT, true>(x, y, b * REDUCTION_BLOC,
+                                                      std::min(n, (b + 1) * REDUCTION_BLOC), w);
+                partiels[b] = par_paires(w, W);
+            }
+            return;
+        }
+        int t = omp_get_thread_num(), nt = omp_get_num_threads();
+        size_t deb = n * t / nt, fin = n * (t + 1) / nt;
+        Acc<S> s;
+        switch (o.accumulateurs) {
+            case 1: s = rapide<L, 1>(deb, fin); break;
+            case 2: s = rapide<L, 2>(deb, fin); break;
+            case 8: s = rapide<L, 8>(deb, fin); break;
+            default: s = rapide<L, 4>(deb, fin); break;
+        }
+        partiels[t] = s;
+    }
+};
+
+/* e.executer<L>() par chaque thread, ou par le seul appelant si n est petit */
+template <class S, class E>
+void lancer(const E& e, size_t n, int nb_threads, Isa isa) {
+    if (nb_threads == 1 || n < REDUCTION_SEUIL_THREADS) {
+        lancer_simd<S>(e, isa);
+        return;
+    }
+    #pragma omp parallel num_threads(nb_threads)
+    lancer_simd<S>(e, isa);
+}
+
+template <class S, bool PRODUIT>
+S somme(const S* x, const S* y, size_t n, const OptionsReduction& o) {
+    int nb_threads = n < REDUCTION_SEUIL_THREADS ? 1 : omp_get_max_threads();
+    size_t nb = o.deterministe ? (n + REDUCTION_BLOC - 1) / REDUCTION_BLOC : (size_t) nb_threads;
+    std::vector<Acc<S>> partiels(nb, 0);
+    Somme<S, PRODUIT> e = {x, y, n, o, partiels.data()};
+    lancer<S>(e, n, nb_threads, o.isa);
+    Acc<S> s = 0;
+    for (Acc<S> p : partiels) s += p;
+    return (S) s;
+}
+
+/* (a, i) avant (b, j) : plus petit (plus grand si MAX), puis premier indice */
+template <bool MAX, class S>
+bool meilleur(S a, size_t i, S b, size_t j) {
+    return (MAX ? a > b : a < b) || (a == b && i < j);
+}
+
+/*  min (MAX = false) ou max de [deb, fin), avec l'indice du premier
+    extremum si INDICE ; comparaisons strictes : a valeur egale, chaque
+    voie garde son premier indice */
+template <class S, bool MAX, bool INDICE>
+struct Extremum {
+    const S* x;
+    size_t n;
+    ValeurIndice<S>* partiels;
+
+    template <int L> SIMD_EN_LIGNE ValeurIndice<S> bloc(size_t deb, size_t fin) const {
+        typedef typename Simd<S, L>::v V;
+        typedef typename Simd<S, L>::vi VI;
+        constexpr int K = 2;
+        ValeurIndice<S> r = {x[deb], deb};
+        size_t i = deb;
+        if (fin - deb >= K * L) {
+            V m[K];
+            VI ind[K], cour[K];
+            typename EntierDe<S>::type iota[K * L];
+            for (int j = 0; j < K * L; j++) iota[j] = j;
+            memcpy(ind, iota, sizeof(ind));
+            memcpy(cour, iota, sizeof(cour));
+            for (int k = 0; k < K; k++) charger(m[k], x + deb + k * L);
+            /* indices relatifs a deb : 2^31 elements au plus par bloc */
+            for (i = deb + K * L; i + K * L <= fin; i += K * L) {
+                #pragma GCC unroll 2
+                for (int k = 0; k < K; k++) {
+                    V v;
+                    charger(v, x + i + k * L);
+                    cour[k] += K * L;
+                    VI masque = MAX ? v > m[k] : v < m[k];
+                    m[k] = masque ? v : m[k];
+                    if constexpr (INDICE) ind[k] = masque ? cour[k] : ind[k];
+                }
+            }
+            for (int k = 0; k < K; k++) {
+                for (int j = 0; j < L; j++) {
+                    size_t q = deb + (size_t) ind[k][j];
+                    if (meilleur<MAX>(m[k][j], q, r.valeur, r.indice)) r = {m[k][j], q};
+                }
+            }
+        }
+        for (; i < fin; i++) {
+            if (MAX ? x[i] > r.valeur : x[i] < r.valeur) r = {x[i], i};
+        }
+        return r;
+    }
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        constexpr size_t B = (size_t) 1 << 30;
+        int t = omp_get_thread_num(), nt = omp_get_num_threads();
+        size_t deb = n * t / nt, fin = n * (t + 1) / nt;
+        if (deb == fin) {
+            partiels[t] = {x[0], n};
+            return;
+        }
+        ValeurIndice<S> r = bloc<L>(deb, std::min(fin, deb + B));
+        for (size_t d = deb + B; d < fin; d += B) {
+            ValeurIndice<S> q = bloc<L>(d, std::min(fin, d + B));
+            if (MAX ? q.valeur > r.valeur : q.valeur < r.valeur) r = q;
+        }
+        partiels[t] = r;
+    }
+};
+
+template <class S, bool MAX, bool INDICE>
+ValeurIndice<S> extremum(const S* x, size_t n, Isa isa) {
+    int nb_threads = n < REDUCTION_SEUIL_THREADS ? 1 : omp_get_max_threads();
+    std::vector<ValeurIndice<S>> partiels(nb_threads, ValeurIndice<S>{x[0], n});
+    Extremum<S, MAX, INDICE> e = {x, n, partiels.data()};
+    lancer<S>(e, n, nb_threads, isa);
+    /* dans l'ordre des threads : a egalite, le premier indice */
+    ValeurIndice<S> r = {x[0], n};
+    for (const ValeurIndice<S>& p : partiels) {
+        if (p.indice < n && (r.indice == n || meilleur<MAX>(p.valeur, p.indice, r.valeur, r.indice))) r = p;
+    }
+    return r;
+}
+
+} // namespace reduc_detail
+
+template <class S>
+S somme(const S* x, size_t n, const OptionsReduction& o = OptionsReduction()) {
+    return reduc_detail::somme<S, false>(x, nullptr, n, o);
+}
+
+template <class S>
+S produit_scalaire(const S* x, const S* y, size_t n, const OptionsReduction& o = OptionsReduction()) {
+    return reduc_detail::somme<S, true>(x, y, n, o);
+}
+
+/* n > 0 */
+template <class S>
+S minimum(const S* x, size_t n, Isa isa = ISA_AUTO) {
+    return reduc_detail::extremum<S, false, false>(x, n, isa).valeur;
+}
+
+template <class S>
+S maximum(const S* x, size_t n, Isa isa = ISA_AUTO) {
+    return reduc_detail::extremum<S, true, false>(x, n, isa).valeur;
+}
+
+template <class S>
+size_t argmin(const S* x, size_t n, Isa isa = ISA_AUTO) {
+    return reduc_detail::extremum<S, false, true>(x, n, isa).indice;
+}
+
+template <class S>
+size_t argmax(const S* x, size_t n, Isa isa = ISA_AUTO) {
+    return reduc_detail::extremum<S, true, true>(x, n, isa).indice;
+}
+
+#endif // REDUCTION_SIMD_H
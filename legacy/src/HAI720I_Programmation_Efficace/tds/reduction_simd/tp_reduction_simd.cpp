@@ -0,0 +1,189 @@
+/* reductions vectorisees (somme, produit scalaire, min, max, argmin,
+   argmax) sur int32, int64, float et double : boucle scalaire, 1 a 8
+   accumulateurs par isa, ordre deterministe, threads ; elements par
+   cycle et Go/s */
+#include "../EvalPerf.hpp"
+#include "ReductionSimd.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+#include <cmath>
+
+template <class S> void mesurer(const char*, size_t, int, std::ofstream&);
+template <class S> S somme_scalaire(const S*, size_t);
+template <class S> size_t argmin_scalaire(const S*, size_t);
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\nsize number_of_loops output_file\n");
+        return -1;
+    }
+    size_t n = atoll(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+
+    fichier << omp_get_max_threads() << " threads, " << n << " elements\n";
+    mesurer<int32_t>("int32_t", n, number_of_loops, fichier);
+    mesurer<int64_t>("int64_t", n, number_of_loops, fichier);
+    mesurer<float>("float", n, number_of_loops, fichier);
+    mesurer<double>("double", n, number_of_loops, fichier);
+    fichier.close();
+
+    return 0;
+}
+
+
+
+template <class S>
+void mesurer(const char* nom, size_t n, int number_of_loops, std::ofstream& fichier) {
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    int nb_threads = omp_get_max_threads();
+    std::vector<S> x(n), y(n);
+    if constexpr (std::is_integral<S>::value) {
+        std::uniform_int_distribution<S> u(-1000000, 1000000);
+        for (size_t i = 0; i < n; i++) x[i] = u(gen), y[i] = u(gen);
+    } else {
+        std::uniform_real_distribution<S> u(0, 1);
+        for (size_t i = 0; i < n; i++) x[i] = u(gen), y[i] = u(gen);
+    }
+    /* reference : entiers exacts (modulo), flottants en long double */
+    long double ref_s = 0, ref_p = 0;
+    for (size_t i = 0; i < n; i++) {
+        ref_s += x[i];
+        ref_p += (long double) x[i] * y[i];
+    }
+    if constexpr (std::is_integral<S>::value) {
+        typedef typename std::make_unsigned<S>::type U;
+        U s = 0, p = 0;
+        for (size_t i = 0; i < n; i++) s += (U) x[i], p += (U) x[i] * (U) y[i];
+        ref_s = (S) s;
+        ref_p = (S) p;
+    }
+    size_t ref_amin = argmin_scalaire(x.data(), n);
+    size_t ref_amax = std::max_element(x.begin(), x.end()) - x.begin();
+
+    /* resultat de la derniere execution, compare a la reference */
+    auto executer = [&](const std::string& variante, double octets, const std::function<double()>& f,
+                        long double attendu, bool indice) {
+        double nbc = 0, nbs = 0, r = f();
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            r = f();
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+            nbs += PE.nb_s();
+        }
+        fichier << "    " << variante << ": " << n * number_of_loops / nbc << " elements/cycle, "
+                << octets * number_of_loops / nbs * 1e-9 << " Go/s, ";
+        if (indice || std::is_integral<S>::value) {
+            fichier << ((long double) r == attendu ? "correct" : "FAUX") << "\n";
+        } else {
+            fichier << "erreur relative " << (double) fabsl((r - attendu) / attendu) << "\n";
+        }
+    };
+    auto seul = [&](const std::function<double()>& f) {
+        return [&, f] {
+            omp_set_num_threads(1);
+            double r = f();
+            omp_set_num_threads(nb_threads);
+            return r;
+        };
+    };
+    double o1 = (double) n * sizeof(S), o2 = 2 * o1;
+
+    fichier << nom << "\n";
+    executer("somme scalaire", o1, [&] { return (double) somme_scalaire(x.data(), n); }, ref_s, false);
+    std::vector<S> det;
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        for (int K : {1, 4, 8}) {
+            OptionsReduction o;
+            o.isa = (Isa) isa;
+            o.accumulateurs = K;
+            executer(std::string("somme ") + NOMS_ISA[isa] + ", " + std::to_string(K) + " acc., 1 thread", o1,
+                     seul([&, o] { return (double) somme(x.data(), n, o); }), ref_s, false);
+        }
+        OptionsReduction o;
+        o.isa = (Isa) isa;
+        o.deterministe = true;
+        executer(std::string("somme ") + NOMS_ISA[isa] + ", deterministe, 1 thread", o1,
+                 seul([&, o] { return (double) somme(x.data(), n, o); }), ref_s, false);
+        det.push_back(somme(x.data(), n, o));
+    }
+    OptionsReduction od;
+    od.deterministe = true;
+    det.push_back(somme(x.data(), n, od));
+    bool identiques = true;
+    for (S d : det) identiques = identiques && memcmp(&d, &det[0], sizeof(S)) == 0;
+    fichier << "    somme deterministe identique au bit pres (isa, threads) : " << (identiques ? "oui" : "NON")
+            << "\n";
+    if (nb_threads > 1) {
+        executer("somme, " + std::to_string(nb_threads) + " threads", o1,
+                 [&] { return (double) somme(x.data(), n); }, ref_s, false);
+        executer("somme deterministe, " + std::to_string(nb_threads) + " threads", o1,
+                 [&] { return (double) somme(x.data(), n, od); }, ref_s, false);
+    }
+
+    for (bool d : {false, true}) {
+        OptionsReduction o;
+        o.deterministe = d;
+        executer(std::string("produit scalaire") + (d ? " deterministe" : "") + ", 1 thread", o2,
+                 seul([&, o] { return (double) produit_scalaire(x.data(), y.data(), n, o); }), ref_p, false);
+        if (nb_threads > 1) {
+            executer(std::string("produit scalaire") + (d ? " deterministe, " : ", ") + std::to_string(nb_threads)
+                     + " threads", o2, [&, o] { return (double) produit_scalaire(x.data(), y.data(), n, o); },
+                     ref_p, false);
+        }
+    }
+
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        std::string s = std::string(" ") + NOMS_ISA[isa] + ", 1 thread";
+        executer("min" + s, o1, seul([&, isa] { return (double) minimum(x.data(), n, (Isa) isa); }),
+                 x[ref_amin], true);
+        executer("max" + s, o1, seul([&, isa] { return (double) maximum(x.data(), n, (Isa) isa); }),
+                 x[ref_amax], true);
+        executer("argmin" + s, o1, seul([&, isa] { return (double) argmin(x.data(), n, (Isa) isa); }),
+                 ref_amin, true);
+        executer("argmax" + s, o1, seul([&, isa] { return (double) argmax(x.data(), n, (Isa) isa); }),
+                 ref_amax, true);
+    }
+    if (nb_threads > 1) {
+        std::string s = ", " + std::to_string(nb_threads) + " threads";
+        executer("argmin" + s, o1, [&] { return (double) argmin(x.data(), n); }, ref_amin, true);
+        executer("argmax" + s, o1, [&] { return (double) argmax(x.data(), n); }, ref_amax, true);
+    }
+}
+
+/* une chaine de dependances, non vectorisee */
+template <class S>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+S somme_scalaire(const S* x, size_t n) {
+    typename reduc_detail::Acc<S> s = 0;
+    for (size_t i = 0; i < n; i++) s += x[i];
+    return (S) s;
+}
+
+template <class S>
+size_t argmin_scalaire(const S* x, size_t n) {
+    size_t k = 0;
+    for (size_t i = 1; i < n; i++) {
+        if (x[i] < x[k]) k = i;
+    }
+    return k;
+}
+
+/*  commandes d'execution (L1, L3, memoire) :
+    ./execs/tp_reduction_simd 4096 100000 reduction_simd_l1_out.txt
+    ./execs/tp_reduction_simd 1000000 100 reduction_simd_out.txt
+    ./execs/tp_reduction_simd 100000000 5 reduction_simd_grand_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_reduction_simd.cpp -o execs/tp_reduction_simd
+*/
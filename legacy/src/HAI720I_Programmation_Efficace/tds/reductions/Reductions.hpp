@@ -0,0 +1,301 @@
+#ifndef REDUCTIONS_H
+#define REDUCTIONS_H
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <omp.h>
+#include "../Graphe.hpp"
+#include "../SommePrefixe.hpp"
+
+/*  Chaine de L-reductions entre problemes de graphes (HAI802I, exos 56-57),
+    pour reutiliser un meme solveur sur plusieurs problemes.
+
+    Une reduction transforme une instance (graphe symetrique, listes de
+    voisins triees, sans boucle) en une instance d'un autre probleme et
+    remonte une solution de l'image en solution de la source. Les solutions
+    sont des ensembles de sommets (un octet par sommet).
+
+    Les graphes images sont ecrits directement en CSR en deux passes
+    (degres puis remplissage), sans liste d'aretes intermediaire ; une
+    reduction qui ne change pas le graphe renvoie le graphe source lui-meme.
+    La source peut donc etre un graphe projete en memoire (charger_graphe). */
+
+typedef std::vector<uint8_t> Ensemble;
+
+class Reduction {
+public:
+    virtual ~Reduction() {}
+    virtual const char* nom() const = 0;
+    /* construit (ou reutilise) le graphe image ; g doit survivre a la reduction */
+    virtual const Graphe& transformer(const Graphe& g) = 0;
+    /* solution de l'image -> solution de la source */
+    virtual void remonter(const Ensemble& image, Ensemble& source) const = 0;
+};
+
+
+/*  Vertex Cover <-> Independent Set : meme graphe, solutions complementaires
+    (L-reduction dans les deux sens sur les graphes de degre borne). */
+class ComplementaireIndependant : public Reduction {
+public:
+    const char* nom() const { return "VC <-> MIS (complementaire)"; }
+
+    const Graphe& transformer(const Graphe& g) {
+        return g;
+    }
+
+    void remonter(const Ensemble& image, Ensemble& source) const {
+        source.resize(image.size());
+        #pragma omp parallel for schedule(static)
+        for (size_t v = 0; v < image.size(); v++) source[v] = !image[v];
+    }
+};
+
+
+/*  Minimum Vertex Cover-4 <= Minimum Vertex Cover-3 (exo 57). Chaque sommet
+    v de degre 4 devient un chemin v1 - x - v2 : v1 (qui garde l'identifiant
+    v) recoit les deux premiers voisins de v, v2 les deux derniers. Les
+    sommets ajoutes sont numerotes a partir de n : x = n + 2r, v2 = n + 2r + 1
+    ou r est le rang de v parmi les sommets de degre 4.
+    Avec s sommets de degre 4 : OPT(G') = OPT(G) + s, |C| <= |C'| - s. */
+class VertexCover4Vers3 : public Reduction {
+public:
+    uint32_t nb_eclates = 0; /* s */
+
+    const char* nom() const { return "VC-4 -> VC-3"; }
+
+    const Graphe& transformer(const Graphe& g) {
+        source = &g;
+        uint32_t n = g.n;
+        rang.assign((size_t) n + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for (uint32_t v = 0; v < n; v++) rang[v] = g.degre(v) == 4;
+        nb_eclates = (uint32_t) somme_prefixe_exclusive_parallele(rang.data(), (size_t) n + 1);
+
+        image = Graphe();
+        image.n = n + 2 * nb_eclates;
+        image.m = g.m + 4 * (uint64_t) nb_eclates; /* deux aretes x par sommet eclate */
+        image.stock_debut.resize((size_t) image.n + 1);
+        uint64_t* D = image.stock_debut.data();
+        #pragma omp parallel for schedule(static)
+        for (uint32_t v = 0; v < n; v++) D[v] = eclate(v) ? 3 : g.degre(v);
+        #pragma omp parallel for schedule(static)
+        for (uint32_t r = 0; r < nb_eclates; r++) {
+            D[n + 2 * r] = 2;
+            D[n + 2 * r + 1] = 3;
+        }
+        D[image.n] = 0;
+        somme_prefixe_exclusive_parallele(D, (size_t) image.n + 1);
+
+        image.stock_voisins.resize(image.m);
+        sommet_t* V = image.stock_voisins.data();
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (uint32_t v = 0; v < n; v++) {
+            if (!eclate(v)) {
+                uint64_t p = D[v];
+                for (uint64_t k = g.debut[v]; k < g.debut[v + 1]; k++) {
+                    V[p++] = extremite(g.voisins[k], v);
+                }
+                std::sort(V + D[v], V + p);
+                continue;
+            }
+            sommet_t x = n + 2 * rang[v], v2 = x + 1;
+            const sommet_t* w = g.debut_voisins(v);
+            sommet_t a[2] = {extremite(w[0], v), extremite(w[1], v)};
+            sommet_t b[2] = {extremite(w[2], v), extremite(w[3], v)};
+            /* v1 = v : deux premiers voisins et x */
+            V[D[v]] = a[0];
+            V[D[v] + 1] = a[1];
+            V[D[v] + 2] = x;
+            std::sort(V + D[v], V + D[v] + 3);
+            V[D[x]] = v;
+            V[D[x] + 1] = v2;
+            V[D[v2]] = b[0];
+            V[D[v2] + 1] = b[1];
+            V[D[v2] + 2] = x;
+            std::sort(V + D[v2], V + D[v2] + 3);
+        }
+        image.adopter_stock();
+        return image;
+    }
+
+    void remonter(const Ensemble& image_sol, Ensemble& sol) const {
+        uint32_t n = source->n;
+        sol.resize(n);
+        #pragma omp parallel for schedule(static)
+        for (uint32_t v = 0; v < n; v++) {
+            sol[v] = image_sol[v] || (eclate(v) && image_sol[n + 2 * rang[v] + 1]);
+        }
+    }
+
+private:
+    const Graphe* source = nullptr;
+    std::vector<uint32_t> rang; /* rang exclusif parmi les sommets de degre 4 */
+    Graphe image;
+
+    bool eclate(sommet_t v) const { return rang[v + 1] != rang[v]; }
+
+    /*  identifiant, dans l'image, de l'extremite w de l'arete (u, w) : si w
+        est eclate et que u est l'un de ses deux derniers voisins, c'est w2 */
+    sommet_t extremite(sommet_t w, sommet_t u) const {
+        if (!eclate(w)) return w;
+        const sommet_t* l = source->debut_voisins(w);
+        uint32_t pos = (uint32_t) (std::lower_bound(l, l + 4, u) - l);
+        return pos < 2 ? w : source->n + 2 * rang[w] + 1;
+    }
+};
+
+
+/*  Minimum Vertex Cover-k <= Minimum Dominating Set-2k (exo 56) : chaque
+    arete (u, v) recoit un sommet w_e relie a u et v (triangle). Les sommets
+    w_e sont numerotes n, n+1, ... dans l'ordre des aretes (u < v). Une
+    solution dominante est ramenee a une couverture en remplacant chaque w_e
+    choisi dont l'arete n'est pas couverte par u. */
+class VertexCoverVersDomination : public Reduction {
+public:
+    const char* nom() const { return "VC-k -> Dom-2k"; }
+
+    const Graphe& transformer(const Graphe& g) {
+        source = &g;
+        uint32_t n = g.n;
+        /* numero de la premiere arete (u, v > u) de chaque sommet u */
+        premiere.assign((size_t) n + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (uint32_t u = 0; u < n; u++) {
+            premiere[u] = g.fin_voisins(u) - std::upper_bound(g.debut_voisins(u), g.fin_voisins(u), u);
+        }
+        uint64_t nb_aretes = somme_prefixe_exclusive_parallele(premiere.data(), (size_t) n + 1);
+
+        image = Graphe();
+        image.n = (uint32_t) (n + nb_aretes);
+        image.m = 2 * g.m + 2 * nb_aretes;
+        image.stock_debut.resize((size_t) image.n + 1);
+        uint64_t* D = image.stock_debut.data();
+        #pragma omp parallel for schedule(static)
+        for (uint32_t u = 0; u < n; u++) D[u] = 2 * g.degre(u);
+        #pragma omp parallel for schedule(static)
+        for (uint64_t e = 0; e < nb_aretes; e++) D[n + e] = 2;
+        D[image.n] = 0;
+        somme_prefixe_exclusive_parallele(D, (size_t) image.n + 1);
+
+        image.stock_voisins.resize(image.m);
+        sommet_t* V = image.stock_voisins.data();
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (uint32_t u = 0; u < n; u++) {
+            uint64_t p = D[u];
+            /*  voisins d'origine puis sommets d'aretes (tous >= n) ; les
+                numeros d'aretes croissent avec le voisin, la liste est triee */
+            for (uint64_t k = g.debut[u]; k < g.debut[u + 1]; k++) V[p++] = g.voisins[k];
+            for (uint64_t k = g.debut[u]; k < g.debut[u + 1]; k++) V[p++] = n + numero_arete(u, k);
+            /* chaque sommet d'arete est rempli par son extremite inferieure */
+            for (uint64_t k = g.debut[u]; k < g.debut[u + 1]; k++) {
+                sommet_t v = g.voisins[k];
+                if (v <= u) continue;
+                uint64_t w = n + numero_arete(u, k);
+                V[D[w]] = u;
+                V[D[w] + 1] = v;
+            }
+        }
+        image.adopter_stock();
+        return image;
+    }
+
+    void remonter(const Ensemble& image_sol, Ensemble& sol) const {
+        const Graphe& g = *source;
+        sol.assign(image_sol.begin(), image_sol.begin() + g.n);
+        /* chaque arete non couverte a son w_e dans la solution : on prend u.
+           Seul le sommet u (extremite inferieure) ecrit sol[u]. */
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (uint32_t u = 0; u < g.n; u++) {
+            for (uint64_t k = g.debut[u]; k < g.debut[u + 1]; k++) {
+                sommet_t v = g.voisins[k];
+                if (v > u && !image_sol[u] && !image_sol[v]) sol[u] = 1;
+            }
+        }
+    }
+
+private:
+    const Graphe* source = nullptr;
+    std::vector<uint64_t> premiere;
+    Graphe image;
+
+    /* numero de l'arete portee par l'arc k issu de u */
+    uint64_t numero_arete(sommet_t u, uint64_t k) const {
+        const Graphe& g = *source;
+        sommet_t v = g.voisins[k];
+        if (v > u) {
+            const sommet_t* q = std::upper_bound(g.debut_voisins(u), g.fin_voisins(u), u);
+            return premiere[u] + (g.voisins + k - q);
+        }
+        const sommet_t* q = std::upper_bound(g.debut_voisins(v), g.fin_voisins(v), v);
+        const sommet_t* r = std::lower_bound(q, g.fin_voisins(v), u);
+        return premiere[v] + (r - q);
+    }
+};
+
+
+/*  enchainement de reductions : transformer() applique les etapes dans
+    l'ordre, remonter() ramene une solution du dernier probleme au premier */
+class ChaineReductions {
+public:
+    std::vector<std::unique_ptr<Reduction>> etapes;
+
+    void ajouter(Reduction* r) { etapes.emplace_back(r); }
+
+    const Graphe& transformer(const Graphe& g) {
+        const Graphe* courant = &g;
+        for (auto& r : etapes) courant = &r->transformer(*courant);
+        return *courant;
+    }
+
+    void remonter(const Ensemble& image, Ensemble& source) const {
+        Ensemble tmp = image;
+        for (size_t i = etapes.size(); i-- > 0;) {
+            etapes[i]->remonter(tmp, source);
+            if (i > 0) tmp.swap(source);
+        }
+    }
+};
+
+
+/* verifications utiles apres remontee */
+inline bool est_couverture(const Graphe& g, const Ensemble& c) {
+    bool ok = true;
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(&& : ok)
+    for (uint32_t u = 0; u < g.n; u++) {
+        if (c[u]) continue;
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+            if (!c[*p]) ok = false;
+        }
+    }
+    return ok;
+}
+
+inline bool est_dominant(const Graphe& g, const Ensemble& d) {
+    bool ok = true;
+    #pragma omp parallel for schedule(dynamic, 1024) reduction(&& : ok)
+    for (uint32_t u = 0; u < g.n; u++) {
+        if (d[u]) continue;
+        bool domine = false;
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u) && !domine; p++) {
+            domine = d[*p];
+        }
+        if (!domine) ok = false;
+    }
+    return ok;
+}
+
+inline bool est_independant(const Graphe& g, const Ensemble& s) {
+    Ensemble c(s.size());
+    for (size_t v = 0; v < s.size(); v++) c[v] = !s[v];
+    return est_couverture(g, c);
+}
+
+inline uint32_t taille(const Ensemble& s) {
+    uint32_t t = 0;
+    for (uint8_t x : s) t += x;
+    return t;
+}
+
+#endif // REDUCTIONS_H
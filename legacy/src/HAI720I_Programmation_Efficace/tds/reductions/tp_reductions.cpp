@@ -0,0 +1,215 @@
+/* chaines de L-reductions sur un graphe projete en memoire : cout de la
+   transformation et de la remontee compare a celui du solveur */
+#include "../EvalPerf.hpp"
+#include "Reductions.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <queue>
+#include <random>
+
+Graphe graphe_degre_4(uint32_t, uint64_t);
+void couverture_gloutonne(const Graphe&, Ensemble&);
+void independant_glouton(const Graphe&, Ensemble&);
+void dominant_glouton(const Graphe&, Ensemble&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\nnb_vertices number_of_loops output_file [graph_file]\n");
+        return -1;
+    }
+    uint32_t n = atoi(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+    const char* chemin = argc > 4 ? argv[4] : "graphe_vc4.bin";
+    EvalPerf PE;
+
+    /* instance de VC-4 sauvegardee puis projetee : les reductions lisent
+       directement la projection */
+    {
+        Graphe g = graphe_degre_4(n, 2 * (uint64_t) n);
+        if (!sauvegarder_graphe(g, chemin)) {
+            printf("impossible d'ecrire %s\n", chemin);
+            return -1;
+        }
+    }
+    Graphe g;
+    if (!charger_graphe(chemin, g)) {
+        printf("impossible de charger %s\n", chemin);
+        return -1;
+    }
+    fichier << "graphe: n=" << g.n << " m=" << g.m << " threads=" << omp_get_max_threads() << "\n";
+
+    /* probleme final -> solveur */
+    struct Scenario {
+        const char* nom;
+        int etapes[2];
+        void (*solveur)(const Graphe&, Ensemble&);
+    };
+    Scenario scenarios[3] = {
+        {"VC-4 -> VC-3, solveur VC", {1, 0}, couverture_gloutonne},
+        {"VC-4 -> VC-3 -> MIS-3, solveur MIS", {1, 2}, independant_glouton},
+        {"VC-4 -> Dom-8, solveur Dom", {3, 0}, dominant_glouton},
+    };
+    Ensemble direct;
+    couverture_gloutonne(g, direct);
+    fichier << "couverture gloutonne directe:" << taille(direct) << "\n";
+
+    for (const Scenario& sc : scenarios) {
+        double nbs_transfo = 0, nbs_solveur = 0, nbs_remontee = 0;
+        Ensemble sol_image, sol;
+        uint32_t n_image = 0, s = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            ChaineReductions chaine;
+            VertexCover4Vers3* vc43 = nullptr;
+            for (int e : sc.etapes) {
+                if (e == 1) chaine.ajouter(vc43 = new VertexCover4Vers3());
+                if (e == 2) chaine.ajouter(new ComplementaireIndependant());
+                if (e == 3) chaine.ajouter(new VertexCoverVersDomination());
+            }
+            PE.start();
+            const Graphe& image = chaine.transformer(g);
+            PE.stop();
+            nbs_transfo += PE.nb_s();
+            n_image = image.n;
+            s = vc43 ? vc43->nb_eclates : 0;
+
+            PE.start();
+            sc.solveur(image, sol_image);
+            PE.stop();
+            nbs_solveur += PE.nb_s();
+
+            PE.start();
+            chaine.remonter(sol_image, sol);
+            PE.stop();
+            nbs_remontee += PE.nb_s();
+        }
+        fichier << sc.nom << " (image: " << n_image << " sommets, s=" << s << ")\n";
+        fichier << "    solution image:" << taille(sol_image) << " couverture remontee:" << taille(sol)
+                << (est_couverture(g, sol) ? "" : " (ERREUR pas une couverture)") << "\n";
+        fichier << "    transformation nbs:" << nbs_transfo / number_of_loops << "\n";
+        fichier << "    solveur nbs:" << nbs_solveur / number_of_loops << "\n";
+        fichier << "    remontee nbs:" << nbs_remontee / number_of_loops << "\n";
+        fichier << "    (transformation + remontee) / solveur:"
+                << (nbs_transfo + nbs_remontee) / nbs_solveur << "\n";
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* graphe aleatoire de degre maximum 4 (aretes refusees au-dela) */
+Graphe graphe_degre_4(uint32_t n, uint64_t m) {
+    std::mt19937 gen(42);
+    std::vector<uint8_t> deg(n, 0);
+    std::vector<Arete> aretes;
+    for (uint64_t e = 0; e < 4 * m && aretes.size() < m; e++) {
+        sommet_t u = gen() % n, v = gen() % n;
+        if (u == v || deg[u] == 4 || deg[v] == 4) continue;
+        deg[u]++;
+        deg[v]++;
+        aretes.push_back({u, v, 0});
+    }
+    OptionsConstruction opt;
+    opt.symetriser = true;
+    opt.boucles = false;
+    opt.dedoublonner = true;
+    return construire_csr(n, aretes, false, opt);
+}
+
+/*  glouton de degre maximum avec file de priorite paresseuse : les entrees
+    perimees (degre change depuis l'insertion) sont ignorees */
+void couverture_gloutonne(const Graphe& g, Ensemble& c) {
+    c.assign(g.n, 0);
+    std::vector<uint32_t> deg(g.n);
+    std::priority_queue<std::pair<uint32_t, sommet_t>> file;
+    for (uint32_t u = 0; u < g.n; u++) {
+        deg[u] = (uint32_t) g.degre(u);
+        if (deg[u]) file.push({deg[u], u});
+    }
+    while (!file.empty()) {
+        std::pair<uint32_t, sommet_t> x = file.top();
+        file.pop();
+        sommet_t u = x.second;
+        if (c[u] || deg[u] != x.first || deg[u] == 0) continue;
+        c[u] = 1;
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+            if (!c[*p] && deg[*p] > 0) {
+                deg[*p]--;
+                if (deg[*p]) file.push({deg[*p], *p});
+            }
+        }
+        deg[u] = 0;
+    }
+}
+
+/* glouton de degre minimum : on prend u, on retire ses voisins */
+void independant_glouton(const Graphe& g, Ensemble& s) {
+    s.assign(g.n, 0);
+    std::vector<uint8_t> retire(g.n, 0);
+    std::vector<uint32_t> deg(g.n);
+    std::priority_queue<std::pair<uint32_t, sommet_t>, std::vector<std::pair<uint32_t, sommet_t>>,
+                        std::greater<std::pair<uint32_t, sommet_t>>> file;
+    for (uint32_t u = 0; u < g.n; u++) {
+        deg[u] = (uint32_t) g.degre(u);
+        file.push({deg[u], u});
+    }
+    while (!file.empty()) {
+        std::pair<uint32_t, sommet_t> x = file.top();
+        file.pop();
+        sommet_t u = x.second;
+        if (retire[u] || deg[u] != x.first) continue;
+        s[u] = 1;
+        retire[u] = 1;
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) {
+            if (retire[*p]) continue;
+            retire[*p] = 1;
+            for (const sommet_t* q = g.debut_voisins(*p); q != g.fin_voisins(*p); q++) {
+                if (!retire[*q]) file.push({--deg[*q], *q});
+            }
+        }
+    }
+}
+
+/* glouton classique : le sommet qui domine le plus de sommets non domines */
+void dominant_glouton(const Graphe& g, Ensemble& d) {
+    d.assign(g.n, 0);
+    std::vector<uint8_t> domine(g.n, 0);
+    std::vector<uint32_t> gain(g.n);
+    std::priority_queue<std::pair<uint32_t, sommet_t>> file;
+    for (uint32_t u = 0; u < g.n; u++) {
+        gain[u] = (uint32_t) g.degre(u) + 1;
+        file.push({gain[u], u});
+    }
+    auto dominer = [&](sommet_t v) {
+        if (domine[v]) return;
+        domine[v] = 1;
+        gain[v]--;
+        file.push({gain[v], v});
+        for (const sommet_t* q = g.debut_voisins(v); q != g.fin_voisins(v); q++) {
+            gain[*q]--;
+            file.push({gain[*q], *q});
+        }
+    };
+    while (!file.empty()) {
+        std::pair<uint32_t, sommet_t> x = file.top();
+        file.pop();
+        sommet_t u = x.second;
+        if (d[u] || gain[u] != x.first || gain[u] == 0) continue;
+        d[u] = 1;
+        dominer(u);
+        for (const sommet_t* p = g.debut_voisins(u); p != g.fin_voisins(u); p++) dominer(*p);
+    }
+}
+
+/*  commandes d'execution:
+    ./execs/tp_reductions 1000000 5 reductions_out.txt /tmp/graphe_vc4.bin
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_reductions.cpp -o execs/tp_reductions
+*/
@@ -0,0 +1,349 @@
+#ifndef SPMV_H
+#define SPMV_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <omp.h>
+#include "../Simd.hpp"
+#include "../SommePrefixe.hpp"
+#include "../Graphe.hpp"
+
+/*  Produit matrice creuse - vecteur y <- A x (double, indices de colonnes
+    sur 32 bits).
+
+        MatriceCreuse : CSR, la ligne i occupe [debut[i], debut[i + 1]) ;
+            debut est la somme prefixe exclusive des longueurs de lignes
+            (SommePrefixe.hpp), construite en deux passes comme les graphes
+            (Graphe.hpp, dont depuis_graphe reprend la CSR).
+
+        spmv_csr : lignes reparties sur les threads par cout equilibre :
+            une ligne coute ses non-nuls plus SPMV_COUT_LIGNE (boucle,
+            ecriture de y) ; la somme prefixe des couts est debut[i] +
+            SPMV_COUT_LIGNE i, le thread t prend les lignes dont le cout
+            cumule tombe dans [t / nt, (t + 1) / nt) du total (recherche
+            dichotomique, pas de tableau). Une loi de puissance concentre
+            les non-nuls dans quelques lignes : un partage par nombre de
+            lignes laisse alors un thread avec l'essentiel du travail.
+
+        MatriceSell, SELL-C-sigma (Kreutzer et al.) : les lignes sont
+            triees par longueur decroissante dans des fenetres de sigma
+            lignes, puis groupees en tranches de C lignes ; une tranche est
+            completee a la longueur de sa plus longue ligne (zeros pointant
+            la colonne 0) et rangee par colonnes : l'element j des C lignes
+            est contigu. Le noyau avance d'une colonne de tranche par
+            iteration, L lignes par vecteur (le reste de C / L en
+            scalaire), x lu par gather (avx2, avx512) ; le tri borne le
+            remplissage, sigma petit garde la localite de x. Resultat remis
+            dans l'ordre d'origine par la permutation. */
+
+#define SPMV_COUT_LIGNE 2
+
+struct MatriceCreuse {
+    uint32_t lignes = 0, colonnes = 0;
+    std::vector<uint64_t> debut;
+    std::vector<uint32_t> indices;
+    std::vector<double> valeurs;
+
+    uint64_t nnz() const { return debut.empty() ? 0 : debut[lignes]; }
+};
+
+struct Triplet {
+    uint32_t i, j;
+    double v;
+};
+
+/* CSR de triplets (doublons conserves), colonnes triees dans chaque ligne */
+inline MatriceCreuse depuis_triplets(uint32_t lignes, uint32_t colonnes, const std::vector<Triplet>& t) {
+    MatriceCreuse A;
+    A.lignes = lignes;
+    A.colonnes = colonnes;
+    A.debut.assign((size_t) lignes + 1, 0);
+    uint64_t* D = A.debut.data();
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < t.size(); e++) {
+        #pragma omp atomic
+        D[t[e].i]++;
+    }
+    uint64_t nnz = somme_prefixe_exclusive_parallele(D, (size_t) lignes + 1);
+    A.indices.resize(nnz);
+    A.valeurs.resize(nnz);
+    std::vector<uint64_t> curseur(D, D + lignes);
+    #pragma omp parallel for schedule(static)
+    for (size_t e = 0; e < t.size(); e++) {
+        uint64_t p;
+        #pragma omp atomic capture
+        p = curseur[t[e].i]++;
+        A.indices[p] = t[e].j;
+        A.valeurs[p] = t[e].v;
+    }
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (uint32_t i = 0; i < lignes; i++) {
+        uint64_t a = D[i], b = D[i + 1];
+        std::vector<std::pair<uint32_t, double>> l(b - a);
+        for (uint64_t k = a; k < b; k++) l[k - a] = {A.indices[k], A.valeurs[k]};
+        std::sort(l.begin(), l.end(),
+                  [](const std::pair<uint32_t, double>& x, const std::pair<uint32_t, double>& y) {
+                      return x.first < y.first;
+                  });
+        for (uint64_t k = a; k < b; k++) {
+            A.indices[k] = l[k - a].first;
+            A.valeurs[k] = l[k - a].second;
+        }
+    }
+    return A;
+}
+
+/* matrice d'adjacence, poids des arcs ou 1 */
+inline MatriceCreuse depuis_graphe(const Graphe& g) {
+    MatriceCreuse A;
+    A.lignes = A.colonnes = g.n;
+    A.debut.assign(g.debut, g.debut + g.n + 1);
+    A.indices.assign(g.voisins, g.voisins + g.m);
+    A.valeurs.resize(g.m);
+    for (uint64_t k = 0; k < g.m; k++) A.valeurs[k] = g.pondere() ? g.poids[k] : 1;
+    return A;
+}
+
+/* reference sequentielle */
+inline void spmv_reference(const MatriceCreuse& A, const double* x, double* y) {
+    for (uint32_t i = 0; i < A.lignes; i++) {
+        double s = 0;
+        for (uint64_t k = A.debut[i]; k < A.debut[i + 1]; k++) s += A.valeurs[k] * x[A.indices[k]];
+        y[i] = s;
+    }
+}
+
+namespace spmv_detail {
+
+/* premier i de [0, n] tel que cout(i) >= c, cout croissant */
+template <class Cout>
+uint32_t chercher(uint32_t n, double c, Cout cout) {
+    uint32_t a = 0, b = n;
+    while (a < b) {
+        uint32_t m = a + (b - a) / 2;
+        if (cout(m) < c) a = m + 1;
+        else b = m;
+    }
+    return a;
+}
+
+/* bornes de n unites en nb parts de cout egal, cout(i) : cout cumule avant i */
+template <class Cout>
+std::vector<uint32_t> partager(uint32_t n, int nb, Cout cout) {
+    std::vector<uint32_t> p(nb + 1);
+    double total = cout(n);
+    for (int t = 0; t <= nb; t++) p[t] = t == nb ? n : chercher(n, total * t / nb, cout);
+    return p;
+}
+
+} // namespace spmv_detail
+
+/* lignes [p[t], p[t + 1]) de la part t */
+inline std::vector<uint32_t> partition_nnz(const MatriceCreuse& A, int nb) {
+    const uint64_t* D = A.debut.data();
+    return spmv_detail::partager(A.lignes, nb, [D](uint32_t i) {
+        return (double) D[i] + SPMV_COUT_LIGNE * (double) i;
+    });
+}
+
+/* partage naif, meme nombre de lignes par part */
+inline std::vector<uint32_t> partition_lignes(uint32_t lignes, int nb) {
+    std::vector<uint32_t> p(nb + 1);
+    for (int t = 0; t <= nb; t++) p[t] = (uint32_t) ((uint64_t) lignes * t / nb);
+    return p;
+}
+
+/* une part par thread (nb parts = nb threads + 1 bornes), sinon parts distribuees */
+inline void spmv_csr(const MatriceCreuse& A, const double* x, double* y, const std::vector<uint32_t>& parts) {
+    const uint64_t* D = A.debut.data();
+    const uint32_t* J = A.indices.data();
+    const double* V = A.valeurs.data();
+    int nb = (int) parts.size() - 1;
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int t = 0; t < nb; t++) {
+        for (uint32_t i = parts[t]; i < parts[t + 1]; i++) {
+            double s = 0;
+            for (uint64_t k = D[i]; k < D[i + 1]; k++) s += V[k] * x[J[k]];
+            y[i] = s;
+        }
+    }
+}
+
+inline void spmv_csr(const MatriceCreuse& A, const double* x, double* y) {
+    spmv_csr(A, x, y, partition_nnz(A, omp_get_max_threads()));
+}
+
+struct MatriceSell {
+    uint32_t lignes = 0, colonnes = 0;
+    int C = 0, sigma = 0;
+    uint32_t tranches = 0;
+    std::vector<uint64_t> debut;        /* tranches + 1, en elements */
+    std::vector<uint32_t> largeur;
+    std::vector<uint32_t> indices;
+    std::vector<double> valeurs;
+    std::vector<uint32_t> permutation;  /* ligne d'origine de la ligne triee */
+    uint64_t nnz = 0;
+
+    uint64_t stockes() const { return debut.empty() ? 0 : debut[tranches]; }
+};
+
+inline MatriceSell vers_sell(const MatriceCreuse& A, int C, int sigma) {
+    MatriceSell S;
+    S.lignes = A.lignes;
+    S.colonnes = A.colonnes;
+    S.C = C;
+    S.sigma = sigma = std::max(sigma, 1);
+    S.nnz = A.nnz();
+    S.tranches = (A.lignes + C - 1) / C;
+    const uint64_t* D = A.debut.data();
+    auto longueur = [D](uint32_t i) { return D[i + 1] - D[i]; };
+
+    S.permutation.resize(A.lignes);
+    std::iota(S.permutation.begin(), S.permutation.end(), 0);
+    #pragma omp parallel for schedule(static)
+    for (uint32_t f = 0; f < (A.lignes + sigma - 1) / sigma; f++) {
+        uint32_t a = f * sigma, b = std::min<uint64_t>(A.lignes, (uint64_t) a + sigma);
+        std::stable_sort(S.permutation.begin() + a, S.permutation.begin() + b,
+                         [&](uint32_t i, uint32_t j) { return longueur(i) > longueur(j); });
+    }
+
+    /* largeurs, puis somme prefixe des tailles de tranches */
+    S.largeur.resize(S.tranches);
+    S.debut.assign((size_t) S.tranches + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (uint32_t c = 0; c < S.tranches; c++) {
+        uint64_t w = 0;
+        for (uint32_t r = c * C; r < std::min<uint64_t>(A.lignes, (uint64_t) (c + 1) * C); r++) {
+            w = std::max(w, longueur(S.permutation[r]));
+        }
+        S.largeur[c] = (uint32_t) w;
+        S.debut[c] = w * C;
+    }
+    somme_prefixe_exclusive_parallele(S.debut.data(), (size_t) S.tranches + 1);
+    S.indices.assign(S.stockes(), 0);
+    S.valeurs.assign(S.stockes(), 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (uint32_t c = 0; c < S.tranches; c++) {
+        for (int r = 0; r < C && (uint64_t) c * C + r < A.lignes; r++) {
+            uint32_t i = S.permutation[(size_t) c * C + r];
+            for (uint64_t k = D[i]; k < D[i + 1]; k++) {
+                size_t p = S.debut[c] + (k - D[i]) * C + r;
+                S.indices[p] = A.indices[k];
+                S.valeurs[p] = A.valeurs[k];
+            }
+        }
+    }
+    return S;
+}
+
+namespace spmv_detail {
+
+/* r <- L valeurs x[j[0 .. L-1]], par gather en avx2 et avx512 */
+template <class V>
+SIMD_EN_LIGNE void rassembler(V& r, const double* x, const uint32_t* j) {
+    for (int k = 0; k < (int) (sizeof(V) / sizeof(double)); k++) r[k] = x[j[k]];
+}
+
+SIMD_EN_LIGNE_AVX2 void rassembler(Simd<double, 4>::v& r, const double* x, const uint32_t* j) {
+    typedef Simd<double, 4>::v V;
+    typedef int v4si __attribute__((vector_size(16)));
+    v4si q;
+    memcpy(&q, j, sizeof(q));
+    r = __builtin_ia32_gathersiv4df(V(), x, q, (V) (V() == V()), 8);
+}
+
+SIMD_EN_LIGNE_AVX512 void rassembler(Simd<double, 8>::v& r, const double* x, const uint32_t* j) {
+    typedef Simd<double, 8>::v V;
+    typedef int v8si __attribute__((vector_size(32)));
+    v8si q;
+    memcpy(&q, j, sizeof(q));
+    r = __builtin_ia32_gathersiv8df(V(), x, q, 0xFF, 8);
+}
+
+struct Sell {
+    const MatriceSell* S;
+    const double* x;
+    double* y;
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        typedef typename Simd<double, L>::v V;
+        const MatriceSell& s = *S;
+        const int C = s.C;
+        /* tranches partagees par elements stockes, comme les lignes en CSR */
+        int t = omp_get_thread_num(), nt = omp_get_num_threads();
+        const uint64_t* D = s.debut.data();
+        auto cout = [D](uint32_t c) { return (double) D[c] + SPMV_COUT_LIGNE * (double) c; };
+        double total = cout(s.tranches);
+        uint32_t c0 = chercher(s.tranches, total * t / nt, cout);
+        uint32_t c1 = t == nt - 1 ? s.tranches : chercher(s.tranches, total * (t + 1) / nt, cout);
+        for (uint32_t c = c0; c < c1; c++) {
+            const double* val = s.valeurs.data() + D[c];
+            const uint32_t* col = s.indices.data() + D[c];
+            uint32_t w = s.largeur[c];
+            int r = 0;
+            for (; r + L <= C; r += L) {
+                /* deux accumulateurs : la latence de la fma ne limite pas */
+                V a0 = V(), a1 = V();
+                uint32_t j = 0;
+                for (; j + 1 < w; j += 2) {
+                    V v0, v1, x0, x1;
+                    memcpy(&v0, val + (size_t) j * C + r, sizeof(V));
+                    memcpy(&v1, val + (size_t) (j + 1) * C + r, sizeof(V));
+                    rassembler(x0, x, col + (size_t) j * C + r);
+                    rassembler(x1, x, col + (size_t) (j + 1) * C + r);
+                    a0 += v0 * x0;
+                    a1 += v1 * x1;
+                }
+                if (j < w) {
+                    V v0, x0;
+                    memcpy(&v0, val + (size_t) j * C + r, sizeof(V));
+                    rassembler(x0, x, col + (size_t) j * C + r);
+                    a0 += v0 * x0;
+                }
+                a0 += a1;
+                for (int k = 0; k < L; k++) {
+                    uint64_t p = (uint64_t) c * C + r + k;
+                    if (p < s.lignes) y[s.permutation[p]] = a0[k];
+                }
+            }
+            /* lignes restantes si C n'est pas multiple de L */
+            for (; r < C && (uint64_t) c * C + r < s.lignes; r++) {
+                double a = 0;
+                for (uint32_t j = 0; j < w; j++) a += val[(size_t) j * C + r] * x[col[(size_t) j * C + r]];
+                y[s.permutation[(size_t) c * C + r]] = a;
+            }
+        }
+    }
+};
+
+} // namespace spmv_detail
+
+/* isa de spmv_sell : abaissee jusqu'a ce que C soit multiple de ses voies
+   (sse2 au plus bas, le reste de C / L en scalaire) */
+inline Isa isa_sell(const MatriceSell& S, Isa isa = ISA_AUTO) {
+    isa = isa_effective(isa);
+    while (isa > ISA_SSE2 && S.C % voies<double>(isa) != 0) isa = (Isa) (isa - 1);
+    return isa;
+}
+
+inline void spmv_sell(const MatriceSell& S, const double* x, double* y, Isa isa = ISA_AUTO) {
+    isa = isa_sell(S, isa);
+    spmv_detail::Sell e = {&S, x, y};
+    #pragma omp parallel
+    lancer_simd<double>(e, isa);
+}
+
+/*  octets au minimum lus et ecrits par un produit : valeurs, indices,
+    pointeurs de lignes (ou de tranches et permutation), y, et x une fois */
+inline double octets_spmv(const MatriceCreuse& A) {
+    return A.nnz() * 12.0 + (A.lignes + 1) * 8.0 + A.lignes * 8.0 + A.colonnes * 8.0;
+}
+
+inline double octets_spmv(const MatriceSell& S) {
+    return S.stockes() * 12.0 + (S.tranches + 1) * 12.0 + S.lignes * 12.0 + S.colonnes * 8.0;
+}
+
+#endif // SPMV_H
@@ -0,0 +1,168 @@
+/* produit matrice creuse - vecteur : CSR (partage par lignes ou par
+   non-nuls) et SELL-C-sigma vectorise, sur des matrices en bande et en loi
+   de puissance ; GFLOP/s et Go/s */
+#include "../EvalPerf.hpp"
+#include "Spmv.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+#include <cmath>
+
+MatriceCreuse bandee(uint32_t, int, std::mt19937_64&);
+MatriceCreuse loi_puissance(uint32_t, int, double, std::mt19937_64&);
+double desequilibre(const MatriceCreuse&, const std::vector<uint32_t>&);
+double ecart_max(const std::vector<double>&, const std::vector<double>&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nrows mean_nnz_per_row number_of_loops output_file\n");
+        return -1;
+    }
+    uint32_t n = atoi(argv[1]);
+    int nnz_ligne = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    int nb_threads = omp_get_max_threads();
+
+    struct Cas {
+        const char* nom;
+        MatriceCreuse A;
+    };
+    Cas cas[2] = {
+        {"bande", bandee(n, nnz_ligne, gen)},
+        {"loi de puissance (alpha = 2.5)", loi_puissance(n, nnz_ligne, 2.5, gen)},
+    };
+    fichier << nb_threads << " threads\n";
+
+    for (Cas& c : cas) {
+        const MatriceCreuse& A = c.A;
+        std::vector<double> x(A.colonnes), y(A.lignes), ref(A.lignes);
+        std::uniform_real_distribution<double> u(-1, 1);
+        for (double& v : x) v = u(gen);
+        spmv_reference(A, x.data(), ref.data());
+        uint64_t lmax = 0;
+        for (uint32_t i = 0; i < A.lignes; i++) lmax = std::max(lmax, A.debut[i + 1] - A.debut[i]);
+        fichier << c.nom << " : " << A.lignes << " lignes, " << A.nnz() << " non-nuls, ligne max " << lmax << "\n";
+        /* travail de la part la plus chargee / moyenne, pour 16 parts */
+        fichier << "    desequilibre sur 16 parts : par lignes " << desequilibre(A, partition_lignes(A.lignes, 16))
+                << ", par non-nuls " << desequilibre(A, partition_nnz(A, 16)) << "\n";
+
+        auto mesurer = [&](const std::string& nom, double octets, const std::function<void()>& f) {
+            double nbs = 0;
+            std::fill(y.begin(), y.end(), NAN);
+            f();
+            for (int k = 0; k < number_of_loops; k++) {
+                PE.start();
+                f();
+                PE.stop();
+                nbs += PE.nb_s();
+            }
+            double s = nbs / number_of_loops;
+            fichier << "    " << nom << ": " << s * 1e3 << " ms, " << 2.0 * A.nnz() / s * 1e-9 << " GFLOP/s, "
+                    << octets / s * 1e-9 << " Go/s, ecart " << ecart_max(y, ref) << "\n";
+        };
+        auto seul = [&](const std::function<void()>& f) {
+            return [&, f] {
+                omp_set_num_threads(1);
+                f();
+                omp_set_num_threads(nb_threads);
+            };
+        };
+
+        mesurer("CSR reference", octets_spmv(A), [&] { spmv_reference(A, x.data(), y.data()); });
+        std::vector<uint32_t> par_lignes = partition_lignes(A.lignes, nb_threads);
+        std::vector<uint32_t> par_nnz = partition_nnz(A, nb_threads);
+        mesurer("CSR, " + std::to_string(nb_threads) + " threads, partage par lignes", octets_spmv(A),
+                [&] { spmv_csr(A, x.data(), y.data(), par_lignes); });
+        mesurer("CSR, " + std::to_string(nb_threads) + " threads, partage par non-nuls", octets_spmv(A),
+                [&] { spmv_csr(A, x.data(), y.data(), par_nnz); });
+
+        for (int C : {1, 3, 5, 8, 32}) {
+            for (int sigma : {1, 256, (int) A.lignes}) {
+                MatriceSell S = vers_sell(A, C, sigma);
+                fichier << "    SELL-" << C << "-" << sigma << " : remplissage " << (double) S.stockes() / A.nnz()
+                        << "\n";
+                /* une ligne par noyau reellement lance (isa_sell) ; C < L : tout en scalaire */
+                for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+                    if (isa_sell(S, (Isa) isa) != isa) continue;
+                    std::string nom = C < voies<double>((Isa) isa) ? "scalaire" : NOMS_ISA[isa];
+                    mesurer("        " + nom + ", 1 thread", octets_spmv(S),
+                            seul([&, isa] { spmv_sell(S, x.data(), y.data(), (Isa) isa); }));
+                }
+                if (nb_threads > 1) {
+                    mesurer("        " + std::to_string(nb_threads) + " threads", octets_spmv(S),
+                            [&] { spmv_sell(S, x.data(), y.data()); });
+                }
+            }
+        }
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* colonnes i - b .. i + b, b = nnz_ligne / 2 */
+MatriceCreuse bandee(uint32_t n, int nnz_ligne, std::mt19937_64& gen) {
+    std::uniform_real_distribution<double> u(-1, 1);
+    int b = nnz_ligne / 2;
+    std::vector<Triplet> t;
+    t.reserve((size_t) n * (2 * b + 1));
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t j0 = std::max<int64_t>(0, (int64_t) i - b), j1 = std::min<int64_t>(n - 1, (int64_t) i + b);
+        for (int64_t j = j0; j <= j1; j++) t.push_back({i, (uint32_t) j, u(gen)});
+    }
+    return depuis_triplets(n, n, t);
+}
+
+/*  longueurs de lignes de Pareto P(l > k) = (k / lmin)^(1 - alpha), de
+    moyenne nnz_ligne pour alpha > 2 (tronquees a n), colonnes uniformes */
+MatriceCreuse loi_puissance(uint32_t n, int nnz_ligne, double alpha, std::mt19937_64& gen) {
+    std::uniform_real_distribution<double> u(0, 1), v(-1, 1);
+    std::uniform_int_distribution<uint32_t> col(0, n - 1);
+    double lmin = nnz_ligne * (alpha - 2) / (alpha - 1);
+    std::vector<Triplet> t;
+    for (uint32_t i = 0; i < n; i++) {
+        double l = lmin * pow(1 - u(gen), -1 / (alpha - 1));
+        uint64_t k = (uint64_t) std::min<double>(n, std::max(1.0, l));
+        for (uint64_t e = 0; e < k; e++) t.push_back({i, col(gen), v(gen)});
+    }
+    return depuis_triplets(n, n, t);
+}
+
+double desequilibre(const MatriceCreuse& A, const std::vector<uint32_t>& p) {
+    double total = 0, pire = 0;
+    int nb = (int) p.size() - 1;
+    for (int t = 0; t < nb; t++) {
+        double w = (double) (A.debut[p[t + 1]] - A.debut[p[t]]) + SPMV_COUT_LIGNE * (double) (p[t + 1] - p[t]);
+        total += w;
+        pire = std::max(pire, w);
+    }
+    return pire / (total / nb);
+}
+
+double ecart_max(const std::vector<double>& a, const std::vector<double>& b) {
+    double e = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        double d = fabs(a[i] - b[i]);
+        if (std::isnan(d)) return NAN;    /* ligne non ecrite */
+        e = std::max(e, d);
+    }
+    return e;
+}
+
+/*  commandes d'execution:
+    ./execs/tp_spmv 1000000 16 10 spmv_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_spmv.cpp -o execs/tp_spmv
+*/
@@ -0,0 +1,347 @@
+#ifndef STENCIL_H
+#define STENCIL_H
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <omp.h>
+#include "../Simd.hpp"
+
+/*  Stencils de Jacobi symetriques sur des grilles 1D, 2D et 3D (double,
+    x le plus rapide), repetes sur T pas de temps avec deux tampons :
+
+        u'(x, y, z) = sum c(k) u(x + dx, y + dy, z + dz),   |dx|, |dy|, |dz| <= 1
+
+    ou k est le nombre de decalages non nuls (centre, faces, aretes, coins)
+    et k <= classe_max : 3 points en 1D, 5 en 2D, 7 en 3D pour
+    classe_max = 1 ; 27 points en 3D pour classe_max = 3. Le bord (une
+    maille d'epaisseur) est fixe (conditions de Dirichlet).
+
+    Une mise a jour est une somme de lignes voisines (dy, dz) : pour chacune
+    c(k) u(x) + c(k + 1) (u(x - 1) + u(x + 1)), vectorisee sur x par
+    chargements non alignes (Simd.hpp, une version par isa).
+
+        avancer_naif : boucles directes, un balayage complet par pas.
+
+        avancer, pas_temps = 1 : lignes vectorisees, et en 3D tuiles de
+            bloc_y lignes parcourues sur tout z (les trois plans voisins
+            d'une tuile restent en cache) ; les tuiles sont reparties sur
+            les threads.
+
+        avancer, pas_temps = TB > 1 : blocage temporel par front d'onde le
+            long de la dimension externe (z en 3D, y en 2D, x en 1D). La
+            grille est coupee en blocs de B plans ; le bloc [a, b) avance de
+            TB pas d'un coup, le pas t (0 .. TB - 1) portant sur les plans
+            [a - t, b - t) : le parallelogramme penche vers les blocs deja
+            traites, dont il lit les plans calcules au pas t - 1, et
+            n'ecrase (deux tampons) aucune valeur encore utile au bloc
+            suivant. B + TB plans des deux
+            tampons restent dans STENCIL_CACHE octets (moitie du L2) : chaque
+            valeur est lue en memoire une fois tous les TB pas au lieu de
+            chaque pas. Les threads se partagent les lignes de chaque pas
+            d'un bloc (une barriere par pas). */
+
+#ifndef STENCIL_CACHE
+#define STENCIL_CACHE (1 << 20)
+#endif
+#define STENCIL_BLOC_Y 16
+
+struct Stencil {
+    int dim;
+    int classe_max;
+    double c[4];
+
+    int points() const {
+        int p = 0;
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if ((dim < 3 && dz) || (dim < 2 && dy)) continue;
+                    if ((dx != 0) + (dy != 0) + (dz != 0) <= classe_max) p++;
+                }
+            }
+        }
+        return p;
+    }
+};
+
+inline Stencil stencil_3pts(double c0, double c1) { return {1, 1, {c0, c1, 0, 0}}; }
+inline Stencil stencil_5pts(double c0, double c1) { return {2, 1, {c0, c1, 0, 0}}; }
+inline Stencil stencil_7pts(double c0, double c1) { return {3, 1, {c0, c1, 0, 0}}; }
+inline Stencil stencil_27pts(double c0, double c1, double c2, double c3) { return {3, 3, {c0, c1, c2, c3}}; }
+
+/* nx x ny x nz mailles bord compris (ny = nz = 1 en 1D, nz = 1 en 2D) */
+struct Grille {
+    int nx = 0, ny = 1, nz = 1;
+    std::vector<double> u;
+
+    Grille() {}
+    Grille(int nx, int ny = 1, int nz = 1) : nx(nx), ny(ny), nz(nz), u((size_t) nx * ny * nz) {}
+
+    double& operator()(int x, int y = 0, int z = 0) { return u[((size_t) z * ny + y) * nx + x]; }
+    double operator()(int x, int y = 0, int z = 0) const { return u[((size_t) z * ny + y) * nx + x]; }
+    /* mailles mises a jour a chaque pas */
+    size_t interieur(int dim) const {
+        return (size_t) (nx - 2) * (dim >= 2 ? ny - 2 : 1) * (dim >= 3 ? nz - 2 : 1);
+    }
+};
+
+/* un pas, reference */
+inline void pas_naif(const Stencil& st, const Grille& s, Grille& d) {
+    int y0 = st.dim >= 2, y1 = st.dim >= 2 ? s.ny - 1 : 1;
+    int z0 = st.dim >= 3, z1 = st.dim >= 3 ? s.nz - 1 : 1;
+    for (int z = z0; z < z1; z++) {
+        for (int y = y0; y < y1; y++) {
+            for (int x = 1; x < s.nx - 1; x++) {
+                double a = 0;
+                for (int dz = -z0; dz <= z0; dz++) {
+                    for (int dy = -y0; dy <= y0; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            int k = (dx != 0) + (dy != 0) + (dz != 0);
+                            if (k <= st.classe_max) a += st.c[k] * s(x + dx, y + dy, z + dz);
+                        }
+                    }
+                }
+                d(x, y, z) = a;
+            }
+        }
+    }
+}
+
+/* T pas, resultat dans g ; tmp recoit le bord de g */
+inline void avancer_naif(const Stencil& st, Grille& g, Grille& tmp, int T) {
+    tmp = g;
+    for (int t = 0; t < T; t++) {
+        pas_naif(st, g, tmp);
+        std::swap(g.u, tmp.u);
+    }
+}
+
+struct OptionsStencil {
+    Isa isa = ISA_AUTO;
+    int pas_temps = 1;      /* TB, pas par bloc temporel */
+    int bloc = 0;           /* B plans externes par bloc, 0 : selon STENCIL_CACHE */
+    int bloc_y = STENCIL_BLOC_Y;
+};
+
+namespace stencil_detail {
+
+/*  lignes voisines (dy, dz) d'une ligne : decalage dans la grille, poids du
+    centre et des voisins en x ; celles qui ont des voisins en x d'abord */
+struct Voisinage {
+    int nb, nb_x;
+    std::ptrdiff_t decalage[9];
+    double w0[9], w1[9];
+};
+
+inline Voisinage voisinage(const Stencil& st, const Grille& g) {
+    Voisinage v;
+    v.nb = v.nb_x = 0;
+    int ry = st.dim >= 2, rz = st.dim >= 3;
+    for (int passe = 0; passe < 2; passe++) {
+        for (int dz = -rz; dz <= rz; dz++) {
+            for (int dy = -ry; dy <= ry; dy++) {
+                int k = (dy != 0) + (dz != 0);
+                if (k > st.classe_max) continue;
+                bool voisins_x = k + 1 <= st.classe_max && st.c[k + 1] != 0;
+                if (voisins_x != (passe == 0)) continue;
+                v.decalage[v.nb] = ((std::ptrdiff_t) dz * g.ny + dy) * g.nx;
+                v.w0[v.nb] = st.c[k];
+                v.w1[v.nb] = voisins_x ? st.c[k + 1] : 0;
+                v.nb++;
+            }
+        }
+        if (passe == 0) v.nb_x = v.nb;
+    }
+    return v;
+}
+
+/*  d[x] pour x dans [x0, x1), s et d pointent sur la meme maille de la
+    ligne ; NB, NBX > 0 fixent v.nb, v.nb_x a la compilation (boucles
+    deroulees, poids et pointeurs en registres) */
+template <class V>
+SIMD_EN_LIGNE void charger(V& r, const double* p) {
+    memcpy(&r, p, sizeof(V));
+}
+
+/* r <- w0 p[0] + w1 (p[-1] + p[1]), vecteurs par reference (Simd.hpp) */
+template <class V>
+SIMD_EN_LIGNE void croix(V& r, const V& w0, const V& w1, const double* p) {
+    V c, g, d;
+    charger(c, p);
+    charger(g, p - 1);
+    charger(d, p + 1);
+    r = w0 * c + w1 * (g + d);
+}
+
+template <int L, int NB, int NBX>
+SIMD_EN_LIGNE void ligne(const Voisinage& v, const double* s, double* d, int x0, int x1) {
+    typedef typename Simd<double, L>::v V;
+    const int nb = NB > 0 ? NB : v.nb, nb_x = NB > 0 ? NBX : v.nb_x;
+    if (NB > 0) {
+        V w0[9] = {}, w1[9] = {};
+        const double* r[9];
+        #pragma GCC unroll 9
+        for (int k = 0; k < nb; k++) {
+            w0[k] = v.w0[k] - V();
+            w1[k] = v.w1[k] - V();
+            r[k] = s + v.decalage[k];
+        }
+        int x = x0;
+        for (; x + L <= x1; x += L) {
+            V a, t;
+            croix(a, w0[0], w1[0], r[0] + x);
+            #pragma GCC unroll 9
+            for (int k = 1; k < nb_x; k++) {
+                croix(t, w0[k], w1[k], r[k] + x);
+                a += t;
+            }
+            #pragma GCC unroll 9
+            for (int k = nb_x; k < nb; k++) {
+                charger(t, r[k] + x);
+                a += w0[k] * t;
+            }
+            memcpy(d + x, &a, sizeof(V));
+        }
+        x0 = x;
+    } else {
+        int x = x0;
+        for (; x + L <= x1; x += L) {
+            V a, t;
+            croix(a, v.w0[0] - V(), v.w1[0] - V(), s + v.decalage[0] + x);
+            for (int k = 1; k < nb_x; k++) {
+                croix(t, v.w0[k] - V(), v.w1[k] - V(), s + v.decalage[k] + x);
+                a += t;
+            }
+            for (int k = nb_x; k < nb; k++) {
+                charger(t, s + v.decalage[k] + x);
+                a += (v.w0[k] - V()) * t;
+            }
+            memcpy(d + x, &a, sizeof(V));
+        }
+        x0 = x;
+    }
+    for (int x = x0; x < x1; x++) {
+        double a = 0;
+        for (int k = 0; k < nb; k++) {
+            const double* r = s + v.decalage[k] + x;
+            a += v.w0[k] * r[0] + v.w1[k] * (r[-1] + r[1]);
+        }
+        d[x] = a;
+    }
+}
+
+struct Moteur {
+    const Stencil* st;
+    Voisinage v;
+    double* tampon[2];
+    int nx, ny, nz, T;
+    OptionsStencil o;
+    int B;      /* plans par bloc temporel */
+
+    /*  plans externes [a, b) de s vers d, lignes reparties sur les threads
+        (omp for orpheline, barriere implicite) */
+    template <int L, int NB, int NBX> SIMD_EN_LIGNE void plans(const double* s, double* d, int a, int b) const {
+        if (st->dim == 1) {
+            const int morceau = 4096;
+            int nb = (b - a + morceau - 1) / morceau;
+            #pragma omp for schedule(static)
+            for (int i = 0; i < nb; i++) {
+                ligne<L, NB, NBX>(v, s, d, a + i * morceau, std::min(b, a + (i + 1) * morceau));
+            }
+        } else if (st->dim == 2) {
+            #pragma omp for schedule(static)
+            for (int y = a; y < b; y++) {
+                size_t o = (size_t) y * nx;
+                ligne<L, NB, NBX>(v, s + o, d + o, 1, nx - 1);
+            }
+        } else {
+            int nl = ny - 2;
+            #pragma omp for schedule(static)
+            for (long i = 0; i < (long) (b - a) * nl; i++) {
+                size_t o = ((size_t) (a + i / nl) * ny + 1 + i % nl) * nx;
+                ligne<L, NB, NBX>(v, s + o, d + o, 1, nx - 1);
+            }
+        }
+    }
+
+    /* un pas sans blocage temporel ; en 3D tuiles de bloc_y lignes sur tout z */
+    template <int L, int NB, int NBX> SIMD_EN_LIGNE void pas(const double* s, double* d) const {
+        if (st->dim < 3) {
+            plans<L, NB, NBX>(s, d, 1, (st->dim == 1 ? nx : ny) - 1);
+            return;
+        }
+        int by = std::max(1, o.bloc_y), nb = (ny - 2 + by - 1) / by;
+        #pragma omp for schedule(static)
+        for (int t = 0; t < nb; t++) {
+            int y0 = 1 + t * by, y1 = std::min(ny - 1, y0 + by);
+            for (int z = 1; z < nz - 1; z++) {
+                for (int y = y0; y < y1; y++) {
+                    size_t o = ((size_t) z * ny + y) * nx;
+                    ligne<L, NB, NBX>(v, s + o, d + o, 1, nx - 1);
+                }
+            }
+        }
+    }
+
+    template <int L, int NB, int NBX> SIMD_EN_LIGNE void derouler() const {
+        int TB = std::max(1, o.pas_temps);
+        int n = st->dim == 1 ? nx : st->dim == 2 ? ny : nz;
+        for (int t0 = 0; t0 < T; t0 += TB) {
+            int tb = std::min(TB, T - t0);
+            if (tb == 1) {
+                pas<L, NB, NBX>(tampon[t0 % 2], tampon[(t0 + 1) % 2]);
+                continue;
+            }
+            /* blocs [a, b) de B plans, le dernier prolonge de tb - 1 pour finir */
+            for (int a = 1; a < n - 1; a += B) {
+                int b = a + B >= n - 1 ? n - 1 + tb - 1 : a + B;
+                for (int t = 0; t < tb; t++) {
+                    int p0 = std::max(1, a - t), p1 = std::min(n - 1, b - t);
+                    if (p0 < p1) plans<L, NB, NBX>(tampon[(t0 + t) % 2], tampon[(t0 + t + 1) % 2], p0, p1);
+                }
+                if (b >= n - 1) break;
+            }
+        }
+    }
+
+    /* voisinages des stencils 3, 5, 7 et 27 points, sinon boucles generiques */
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        if (v.nb == 1 && v.nb_x == 1) derouler<L, 1, 1>();
+        else if (v.nb == 3 && v.nb_x == 1) derouler<L, 3, 1>();
+        else if (v.nb == 5 && v.nb_x == 1) derouler<L, 5, 1>();
+        else if (v.nb == 9 && v.nb_x == 9) derouler<L, 9, 9>();
+        else derouler<L, 0, 0>();
+    }
+};
+
+} // namespace stencil_detail
+
+/* T pas, resultat dans g ; tmp recoit le bord de g */
+inline void avancer(const Stencil& st, Grille& g, Grille& tmp, int T, OptionsStencil o = OptionsStencil()) {
+    tmp = g;
+    if (T <= 0) return;
+    stencil_detail::Moteur m;
+    m.st = &st;
+    m.v = stencil_detail::voisinage(st, g);
+    m.tampon[0] = g.u.data();
+    m.tampon[1] = tmp.u.data();
+    m.nx = g.nx;
+    m.ny = g.ny;
+    m.nz = g.nz;
+    m.T = T;
+    m.o = o;
+    /* plan externe : une ligne en 2D, un plan en 3D ; en 1D des mailles */
+    size_t plan = st.dim == 1 ? sizeof(double) : st.dim == 2 ? (size_t) g.nx * sizeof(double)
+                                                             : (size_t) g.nx * g.ny * sizeof(double);
+    int TB = std::max(1, o.pas_temps);
+    m.B = o.bloc > 0 ? o.bloc : (int) (STENCIL_CACHE / (2 * plan)) - TB - 2;
+    if (o.bloc <= 0 && m.B < TB) m.o.pas_temps = 1;      /* plans trop gros pour le cache */
+    #pragma omp parallel
+    lancer_simd<double>(m, o.isa);
+    if (T % 2) std::swap(g.u, tmp.u);
+}
+
+#endif // STENCIL_H
@@ -0,0 +1,124 @@
+/* stencils de Jacobi 3, 5, 7 et 27 points : boucles naives, lignes
+   vectorisees et tuiles, blocage temporel, threads ; mailles par seconde */
+#include "../EvalPerf.hpp"
+#include "Stencil.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+#include <cmath>
+
+double ecart_max(const Grille&, const Grille&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 7) {
+        printf("You must enter the following details:\n"
+               "size_1d size_2d size_3d timesteps number_of_loops output_file\n");
+        return -1;
+    }
+    int n1 = atoi(argv[1]);
+    int n2 = atoi(argv[2]);
+    int n3 = atoi(argv[3]);
+    int T = atoi(argv[4]);
+    int number_of_loops = atoi(argv[5]);
+    std::ofstream fichier {argv[6]};
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> u(0, 1);
+    int nb_threads = omp_get_max_threads();
+
+    /* poids positifs de somme 1 : diffusion stable */
+    struct Cas {
+        const char* nom;
+        Stencil st;
+        Grille g;
+    };
+    std::vector<Cas> cas = {
+        {"1D 3 points", stencil_3pts(0.5, 0.25), Grille(n1)},
+        {"2D 5 points", stencil_5pts(0.6, 0.1), Grille(n2, n2)},
+        {"3D 7 points", stencil_7pts(0.4, 0.1), Grille(n3, n3, n3)},
+        {"3D 27 points", stencil_27pts(0.2, 0.05, 0.025, 0.0125), Grille(n3, n3, n3)},
+    };
+    fichier << nb_threads << " threads, " << T << " pas\n";
+
+    for (Cas& c : cas) {
+        for (double& x : c.g.u) x = u(gen);
+        Grille ref = c.g, tmp;
+        double mailles = (double) c.g.interieur(c.st.dim) * T;
+        fichier << c.nom << " (" << c.st.points() << "), " << c.g.nx
+                << (c.st.dim >= 2 ? " x " + std::to_string(c.g.ny) : "")
+                << (c.st.dim >= 3 ? " x " + std::to_string(c.g.nz) : "") << "\n";
+
+        double s_naif = 0;
+        auto mesurer = [&](const std::string& nom, const std::function<void(Grille&)>& f) {
+            double nbs = 0;
+            Grille g;
+            for (int k = 0; k < number_of_loops; k++) {
+                g = c.g;
+                PE.start();
+                f(g);
+                PE.stop();
+                nbs += PE.nb_s();
+            }
+            double s = nbs / number_of_loops;
+            if (s_naif == 0) {
+                s_naif = s;
+                ref = g;
+            }
+            fichier << "    " << nom << ": " << s * 1e3 << " ms, " << mailles / s * 1e-6 << " Mmailles/s, x"
+                    << s_naif / s << ", ecart " << ecart_max(g, ref) << "\n";
+        };
+        auto seul = [&](OptionsStencil o) {
+            return [&, o](Grille& g) {
+                omp_set_num_threads(1);
+                avancer(c.st, g, tmp, T, o);
+                omp_set_num_threads(nb_threads);
+            };
+        };
+
+        mesurer("naif", [&](Grille& g) { avancer_naif(c.st, g, tmp, T); });
+        for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+            OptionsStencil o;
+            o.isa = (Isa) isa;
+            mesurer(std::string("lignes ") + NOMS_ISA[isa] + ", 1 thread", seul(o));
+        }
+        for (int tb : {4, 8, 16}) {
+            OptionsStencil o;
+            o.pas_temps = tb;
+            mesurer("front d'onde, " + std::to_string(tb) + " pas, 1 thread", seul(o));
+        }
+        if (nb_threads > 1) {
+            for (int tb : {1, 8}) {
+                OptionsStencil o;
+                o.pas_temps = tb;
+                mesurer(std::to_string(tb) + " pas par bloc, " + std::to_string(nb_threads) + " threads",
+                        [&, o](Grille& g) { avancer(c.st, g, tmp, T, o); });
+            }
+        }
+    }
+    fichier.close();
+
+    return 0;
+}
+
+
+
+double ecart_max(const Grille& X, const Grille& Y) {
+    double e = 0;
+    for (size_t i = 0; i < X.u.size(); i++) e = std::max(e, fabs(X.u[i] - Y.u[i]));
+    return e;
+}
+
+/*  commandes d'execution (le blocage temporel ne paie que si la grille
+    depasse le dernier niveau de cache) :
+    ./execs/tp_stencil 4000000 2000 64 50 3 stencil_out.txt
+    ./execs/tp_stencil 32000000 6000 300 20 1 stencil_grand_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_stencil.cpp -o execs/tp_stencil
+*/
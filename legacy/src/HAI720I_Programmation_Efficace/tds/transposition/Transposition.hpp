@@ -0,0 +1,323 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <omp.h>
+#include "../Simd.hpp"
+
+/*  Transposition de matrices rangees par lignes (S = float ou double) :
+    A (n x m, pas lda) -> B (m x n, pas ldb), B[j][i] = A[i][j]. Sert aussi
+    aux changements de disposition : un tableau de structures de k champs
+    est une matrice n x k, sa transposee le rangement par champs.
+
+    Le parcours naif lit A par lignes et ecrit B par colonnes : chaque
+    ecriture touche une nouvelle ligne de cache des que n * sizeof(S)
+    depasse quelques Ko.
+
+        transposer_recursif : cache-oblivious, coupe en deux la plus grande
+            dimension jusqu'a des feuilles de TRANSPOSITION_FEUILLE^2
+            elements ; toute sous-matrice qui tient dans un niveau de cache
+            y est transposee sans defaut, sans connaitre sa taille.
+
+        transposer : tuiles TRANSPOSITION_TUILE x TRANSPOSITION_TUILE (tient
+            dans le L1 des deux cotes), chacune decoupee en blocs L x L
+            transposes dans les registres (L voies de l'isa : 4 x 4 float en
+            sse2, 8 x 8 float ou 4 x 4 double en avx2, 16 x 16 ou 8 x 8 en
+            avx512). log2(L) etapes de melanges : l'etape h echange le bit h
+            de l'indice de ligne avec celui de l'indice de colonne,
+
+                r(a)     <- demi-blocs bas de r(a) et r(a + h)   (a & h = 0)
+                r(a + h) <- demi-blocs hauts
+
+            Option non_temporel : ecritures de B en movnt (contournent les
+            caches, pas de lecture de la ligne avant ecriture), utile quand
+            B ne tient pas dans le dernier niveau de cache ; B aligne sur
+            un vecteur et ldb multiple de L, sinon ecritures normales. Les
+            tuiles sont reparties sur les threads OpenMP disponibles.
+
+        transposer_sur_place : matrice carree, paires de blocs (i, j) et
+            (j, i) echangees apres transposition dans les registres ;
+            transposer_recursif_sur_place en est la version cache-oblivious.
+
+        transposer_sur_place_rectangle : n x m quelconque sans tableau
+            auxiliaire de meme taille, par cycles de la permutation
+            k -> k n mod (n m - 1) (un bit de marquage par element) ;
+            acces aleatoires, a reserver aux cas ou la memoire manque. */
+
+#define TRANSPOSITION_FEUILLE 16
+#ifndef TRANSPOSITION_TUILE
+#define TRANSPOSITION_TUILE 64
+#endif
+
+/* reference */
+template <class S>
+void transposer_naif(const S* A, size_t lda, S* B, size_t ldb, int n, int m) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) B[j * ldb + i] = A[i * lda + j];
+    }
+}
+
+template <class S>
+void transposer_recursif(const S* A, size_t lda, S* B, size_t ldb, int n, int m) {
+    if (n <= TRANSPOSITION_FEUILLE && m <= TRANSPOSITION_FEUILLE) {
+        transposer_naif(A, lda, B, ldb, n, m);
+    } else if (n >= m) {
+        int h = n / 2;
+        transposer_recursif(A, lda, B, ldb, h, m);
+        transposer_recursif(A + h * lda, lda, B + h, ldb, n - h, m);
+    } else {
+        int h = m / 2;
+        transposer_recursif(A, lda, B, ldb, n, h);
+        transposer_recursif(A + h, lda, B + h * ldb, ldb, n, m - h);
+    }
+}
+
+namespace transp_detail {
+
+/* P (n x m) <-> Q^T (Q : m x n), blocs disjoints de la meme matrice */
+template <class S>
+void echanger_transposes(S* P, S* Q, size_t lda, int n, int m) {
+    if (n <= TRANSPOSITION_FEUILLE && m <= TRANSPOSITION_FEUILLE) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < m; j++) std::swap(P[i * lda + j], Q[j * lda + i]);
+        }
+    } else if (n >= m) {
+        int h = n / 2;
+        echanger_transposes(P, Q, lda, h, m);
+        echanger_transposes(P + h * lda, Q + h, lda, n - h, m);
+    } else {
+        int h = m / 2;
+        echanger_transposes(P, Q, lda, n, h);
+        echanger_transposes(P + h, Q + h * lda, lda, n, m - h);
+    }
+}
+
+} // namespace transp_detail
+
+/* A (n x n) <- A^T : [A11 A12; A21 A22] -> [A11^T A21^T; A12^T A22^T] */
+template <class S>
+void transposer_recursif_sur_place(S* A, size_t lda, int n) {
+    if (n <= TRANSPOSITION_FEUILLE) {
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) std::swap(A[i * lda + j], A[j * lda + i]);
+        }
+        return;
+    }
+    int h = n / 2;
+    transposer_recursif_sur_place(A, lda, h);
+    transposer_recursif_sur_place(A + h * lda + h, lda, n - h);
+    transp_detail::echanger_transposes(A + h, A + h * lda, lda, h, n - h);
+}
+
+template <class S>
+void transposer_sur_place_rectangle(S* A, int n, int m) {
+    size_t nm = (size_t) n * m;
+    if (nm < 3 || n == 1 || m == 1) return;
+    std::vector<bool> place(nm);
+    /*  l'element d'indice k = i m + j va en j n + i = k n mod (nm - 1) ;
+        on suit chaque cycle en portant l'element deplace */
+    for (size_t debut = 1; debut < nm - 1; debut++) {
+        if (place[debut]) continue;
+        size_t k = debut;
+        S x = A[k];
+        do {
+            size_t d = (size_t) ((unsigned __int128) k * n % (nm - 1));
+            std::swap(x, A[d]);
+            place[d] = true;
+            k = d;
+        } while (k != debut);
+    }
+}
+
+namespace transp_detail {
+
+/* masques de l'etape h : demi-blocs bas (haut = false) ou hauts de x, y ;
+   vecteur par reference (Simd.hpp) */
+template <int L, class VI>
+SIMD_EN_LIGNE void masque_etape(VI& r, int h, bool haut) {
+    for (int t = 0; t < L; t++) {
+        r[t] = (t & h) ? (haut ? L + t : L + t - h) : (haut ? t + h : t);
+    }
+}
+
+/* r[0..L-1] <- transposee du bloc L x L */
+template <class S, int L>
+SIMD_EN_LIGNE void transposer_registres(typename Simd<S, L>::v* r) {
+    typedef typename Simd<S, L>::v V;
+    typedef typename Simd<S, L>::vi VI;
+    #pragma GCC unroll 8
+    for (int h = L / 2; h >= 1; h /= 2) {
+        VI bas, haut;
+        masque_etape<L>(bas, h, false);
+        masque_etape<L>(haut, h, true);
+        #pragma GCC unroll 16
+        for (int a = 0; a < L; a++) {
+            if (a & h) continue;
+            V x = r[a], y = r[a + h];
+            r[a] = __builtin_shuffle(x, y, bas);
+            r[a + h] = __builtin_shuffle(x, y, haut);
+        }
+    }
+}
+
+template <class S, int L>
+SIMD_EN_LIGNE void charger_bloc(typename Simd<S, L>::v* r, const S* A, size_t lda) {
+    #pragma GCC unroll 16
+    for (int k = 0; k < L; k++) memcpy(&r[k], A + k * lda, sizeof(r[k]));
+}
+
+/* p aligne sur le vecteur si flux (movnt ; intrinseques inutilisables hors cible) */
+template <class S, int L, bool FLUX>
+SIMD_EN_LIGNE void ecrire_vecteur(S* p, const typename Simd<S, L>::v& x) {
+    if constexpr (!FLUX) memcpy(p, &x, sizeof(x));
+    else if constexpr (sizeof(S) == 4 && L == 4) __builtin_ia32_movntps(p, x);
+    else if constexpr (sizeof(S) == 4 && L == 8) __builtin_ia32_movntps256(p, x);
+    else if constexpr (sizeof(S) == 4 && L == 16) __builtin_ia32_movntps512(p, x);
+    else if constexpr (sizeof(S) == 8 && L == 2) __builtin_ia32_movntpd(p, x);
+    else if constexpr (sizeof(S) == 8 && L == 4) __builtin_ia32_movntpd256(p, x);
+    else __builtin_ia32_movntpd512(p, x);
+}
+
+template <class S, int L>
+SIMD_EN_LIGNE void ecrire_bloc(S* B, size_t ldb, const typename Simd<S, L>::v* r) {
+    #pragma GCC unroll 16
+    for (int k = 0; k < L; k++) ecrire_vecteur<S, L, false>(B + k * ldb, r[k]);
+}
+
+/* tuiles hors place, une boucle omp for orpheline (region dans transposer) */
+template <class S>
+struct HorsPlace {
+    const S* A;
+    size_t lda;
+    S* B;
+    size_t ldb;
+    int n, m;
+    bool non_temporel;
+
+    template <int L, bool FLUX> SIMD_EN_LIGNE void parcourir() const {
+        typedef typename Simd<S, L>::v V;
+        const int T = TRANSPOSITION_TUILE;
+        const int G = sizeof(V) >= 64 ? 1 : 64 / sizeof(V);
+        int ti = (n + T - 1) / T, tj = (m + T - 1) / T;
+        #pragma omp for schedule(static)
+        for (long u = 0; u < (long) ti * tj; u++) {
+            int i0 = (int) (u / tj) * T, j0 = (int) (u % tj) * T;
+            int i1 = std::min(i0 + T, n), j1 = std::min(j0 + T, m);
+            int ie = i0 + (i1 - i0) / L * L, je = j0 + (j1 - j0) / L * L;
+            /*  i en boucle interne : chaque ligne de B est ecrite d'un trait ;
+                G blocs voisins transposes ensemble pour ecrire une ligne de
+                cache entiere de suite (un tampon d'ecriture par ligne en
+                movnt, au lieu de L lignes partielles en attente) */
+            for (int j = j0; j < je; j += L) {
+                int i = i0;
+                for (; i + G * L <= ie; i += G * L) {
+                    V r[G][L];
+                    #pragma GCC unroll 4
+                    for (int g = 0; g < G; g++) {
+                        charger_bloc<S, L>(r[g], A + (i + g * L) * lda + j, lda);
+                        transposer_registres<S, L>(r[g]);
+                    }
+                    #pragma GCC unroll 16
+                    for (int k = 0; k < L; k++) {
+                        #pragma GCC unroll 4
+                        for (int g = 0; g < G; g++) {
+                            ecrire_vecteur<S, L, FLUX>(B + (j + k) * ldb + i + g * L, r[g][k]);
+                        }
+                    }
+                }
+                for (; i < ie; i += L) {
+                    V r[L];
+                    charger_bloc<S, L>(r, A + i * lda + j, lda);
+                    transposer_registres<S, L>(r);
+                    #pragma GCC unroll 16
+                    for (int k = 0; k < L; k++) ecrire_vecteur<S, L, FLUX>(B + (j + k) * ldb + i, r[k]);
+                }
+                for (int k = 0; k < L; k++) {
+                    for (int q = ie; q < i1; q++) B[(j + k) * ldb + q] = A[q * lda + j + k];
+                }
+            }
+            for (int j = je; j < j1; j++) {
+                for (int i = i0; i < i1; i++) B[j * ldb + i] = A[i * lda + j];
+            }
+        }
+    }
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        if (non_temporel && (uintptr_t) B % (L * sizeof(S)) == 0 && ldb % L == 0) {
+            parcourir<L, true>();
+            /* les movnt sont faiblement ordonnees : visibles avant la barriere */
+            __builtin_ia32_sfence();
+        } else {
+            parcourir<L, false>();
+        }
+    }
+};
+
+/* blocs plus larges que la matrice (m = 8 champs en avx512 float) : isa inferieure */
+inline Isa isa_pour(Isa isa, int cote, int (*voies_isa)(Isa)) {
+    isa = isa_effective(isa);
+    while (isa > ISA_SSE2 && cote < voies_isa(isa)) isa = (Isa) (isa - 1);
+    return isa;
+}
+
+/* carre sur place, lignes de blocs i distribuees, j >= i */
+template <class S>
+struct SurPlace {
+    S* A;
+    size_t lda;
+    int n;
+
+    template <int L> SIMD_EN_LIGNE void executer() const {
+        typedef typename Simd<S, L>::v V;
+        int ne = n / L * L;
+        #pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < ne; i += L) {
+            V r[L], s[L];
+            charger_bloc<S, L>(r, A + i * lda + i, lda);
+            transposer_registres<S, L>(r);
+            ecrire_bloc<S, L>(A + i * lda + i, lda, r);
+            for (int j = i + L; j < ne; j += L) {
+                charger_bloc<S, L>(r, A + i * lda + j, lda);
+                charger_bloc<S, L>(s, A + j * lda + i, lda);
+                transposer_registres<S, L>(r);
+                transposer_registres<S, L>(s);
+                ecrire_bloc<S, L>(A + j * lda + i, lda, r);
+                ecrire_bloc<S, L>(A + i * lda + j, lda, s);
+            }
+            /* bord droit (colonnes ne .. n-1) contre bord bas */
+            for (int k = i; k < i + L; k++) {
+                for (int j = ne; j < n; j++) std::swap(A[k * lda + j], A[j * lda + k]);
+            }
+        }
+        #pragma omp single
+        for (int k = ne; k < n; k++) {
+            for (int j = k + 1; j < n; j++) std::swap(A[k * lda + j], A[j * lda + k]);
+        }
+    }
+};
+
+} // namespace transp_detail
+
+template <class S>
+void transposer(const S* A, size_t lda, S* B, size_t ldb, int n, int m, Isa isa = ISA_AUTO,
+                bool non_temporel = false) {
+    transp_detail::HorsPlace<S> e = {A, lda, B, ldb, n, m, non_temporel};
+    isa = transp_detail::isa_pour(isa, std::min(n, m), voies<S>);
+    #pragma omp parallel
+    lancer_simd<S>(e, isa);
+}
+
+template <class S>
+void transposer_sur_place(S* A, size_t lda, int n, Isa isa = ISA_AUTO) {
+    transp_detail::SurPlace<S> e = {A, lda, n};
+    isa = transp_detail::isa_pour(isa, n, voies<S>);
+    #pragma omp parallel
+    lancer_simd<S>(e, isa);
+}
+
+#endif // TRANSPOSITION_H
@@ -0,0 +1,150 @@
+/* transposition hors place et sur place : naive, recursive, par tuiles
+   vectorielles (avec ou sans ecritures non temporelles, 1 ou plusieurs
+   threads), en Go/s effectifs compares a memcpy */
+#include "../EvalPerf.hpp"
+#include "Transposition.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+template <class S> void mesurer(const char*, int, int, int, std::ofstream&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nrows columns number_of_loops output_file\n");
+        return -1;
+    }
+    int n = atoi(argv[1]);
+    int m = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+
+    fichier << omp_get_max_threads() << " threads ; Go/s = 2 n m sizeof(S) / temps (lecture + ecriture)\n";
+    mesurer<float>("float", n, m, number_of_loops, fichier);
+    mesurer<double>("double", n, m, number_of_loops, fichier);
+    fichier.close();
+
+    return 0;
+}
+
+
+
+template <class S>
+bool egales(const S* X, const S* Y, size_t n) {
+    return memcmp(X, Y, n * sizeof(S)) == 0;
+}
+
+template <class S>
+void mesurer(const char* nom, int n, int m, int number_of_loops, std::ofstream& fichier) {
+    EvalPerf PE;
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<S> u(-1, 1);
+    size_t nm = (size_t) n * m;
+    double octets = 2.0 * nm * sizeof(S);
+    int nb_threads = omp_get_max_threads();
+    /* B aligne sur 64 octets pour les movnt */
+    std::vector<S> A(nm), R(nm), B0(nm + 64 / sizeof(S));
+    S* B = B0.data() + (64 - (uintptr_t) B0.data() % 64) % 64 / sizeof(S);
+    for (S& x : A) x = u(gen);
+    transposer_naif(A.data(), m, R.data(), n, n, m);
+
+    auto executer = [&](const std::string& variante, const std::function<void()>& f,
+                        const S* resultat, const S* attendu) {
+        double nbc = 0, nbs = 0;
+        f();
+        for (int k = 0; k < number_of_loops; k++) {
+            PE.start();
+            f();
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+            nbs += PE.nb_s();
+        }
+        double s = nbs / number_of_loops;
+        fichier << "    " << variante << ": " << s * 1e3 << " ms, " << octets / s * 1e-9 << " Go/s, "
+                << nbc / number_of_loops / nm << " cycles/element";
+        if (resultat) fichier << (egales(resultat, attendu, nm) ? ", correct" : ", FAUX");
+        fichier << "\n";
+    };
+    auto seul = [&](const std::function<void()>& f) {
+        return [&, f] {
+            omp_set_num_threads(1);
+            f();
+            omp_set_num_threads(nb_threads);
+        };
+    };
+
+    fichier << nom << ", A " << n << " x " << m << " -> B " << m << " x " << n << "\n";
+    executer("memcpy", [&] { memcpy(B, A.data(), nm * sizeof(S)); }, nullptr, nullptr);
+    executer("naive", [&] { transposer_naif(A.data(), m, B, n, n, m); }, nullptr, nullptr);
+    executer("recursive", [&] { transposer_recursif(A.data(), m, B, n, n, m); }, B, R.data());
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        for (bool nt : {false, true}) {
+            std::string v = std::string("tuiles ") + NOMS_ISA[isa] + (nt ? " movnt" : "") + ", 1 thread";
+            executer(v, seul([&, isa, nt] { transposer(A.data(), m, B, n, n, m, (Isa) isa, nt); }), B,
+                     R.data());
+        }
+    }
+    if (nb_threads > 1) {
+        for (bool nt : {false, true}) {
+            executer(std::string("tuiles") + (nt ? " movnt, " : ", ") + std::to_string(nb_threads) + " threads",
+                     [&, nt] { transposer(A.data(), m, B, n, n, m, ISA_AUTO, nt); }, B, R.data());
+        }
+    }
+
+    /*  sur place : la matrice carree p x p, p = min(n, m), est transposee
+        number_of_loops + 1 fois, on verifie la parite */
+    int p = std::min(n, m);
+    std::vector<S> P(A.begin(), A.begin() + (size_t) p * p), Pt((size_t) p * p);
+    transposer_naif(P.data(), p, Pt.data(), p, p, p);
+    const std::vector<S>& attendu = number_of_loops % 2 == 0 ? Pt : P;
+    octets = 2.0 * p * p * sizeof(S);
+    nm = (size_t) p * p;
+    fichier << nom << ", sur place " << p << " x " << p << "\n";
+    std::vector<S> Q = P;
+    executer("naive", [&] {
+        for (int i = 0; i < p; i++) {
+            for (int j = i + 1; j < p; j++) std::swap(Q[i * p + j], Q[j * p + i]);
+        }
+    }, Q.data(), attendu.data());
+    Q = P;
+    executer("recursive", [&] { transposer_recursif_sur_place(Q.data(), p, p); }, Q.data(), attendu.data());
+    for (int isa = ISA_SSE2; isa <= isa_disponible(); isa++) {
+        Q = P;
+        executer(std::string("blocs ") + NOMS_ISA[isa] + ", 1 thread",
+                 seul([&, isa] { transposer_sur_place(Q.data(), p, p, (Isa) isa); }), Q.data(), attendu.data());
+    }
+    if (nb_threads > 1) {
+        Q = P;
+        executer("blocs, " + std::to_string(nb_threads) + " threads",
+                 [&] { transposer_sur_place(Q.data(), p, p); }, Q.data(), attendu.data());
+    }
+
+    /* rectangle sur place : une transposition de A, puis retour */
+    std::vector<S> E = A;
+    octets = 2.0 * A.size() * sizeof(S);
+    nm = A.size();
+    PE.start();
+    transposer_sur_place_rectangle(E.data(), n, m);
+    PE.stop();
+    bool correct = egales(E.data(), R.data(), nm);
+    double s = PE.nb_s();
+    transposer_sur_place_rectangle(E.data(), m, n);
+    fichier << nom << ", rectangle sur place par cycles " << n << " x " << m << ": " << s * 1e3 << " ms, "
+            << octets / s * 1e-9 << " Go/s, " << (correct && egales(E.data(), A.data(), nm) ? "correct" : "FAUX")
+            << "\n";
+}
+
+/*  commandes d'execution:
+    ./execs/tp_transposition 4096 4096 5 transposition_out.txt
+    ./execs/tp_transposition 1000000 8 5 transposition_soa_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_transposition.cpp -o execs/tp_transposition
+*/
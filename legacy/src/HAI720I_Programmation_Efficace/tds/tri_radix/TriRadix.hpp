@@ -0,0 +1,357 @@
+#ifndef TRI_RADIX_H
+#define TRI_RADIX_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+#include "../SommePrefixe.hpp"
+
+/*  Tri par base de cles entieres non signees 32 ou 64 bits, seules
+    (uint32_t, uint64_t) ou avec une valeur (Paire<K, V>, triee sur cle).
+    Les deux tris sont stables.
+
+        tri_radix_lsd : une passe par chiffre de B bits (8, 11 ou 16), du
+            poids faible au poids fort. Une premiere lecture compte les
+            chiffres de toutes les passes ; une passe dont un chiffre
+            regroupe les n cles ne change rien et est sautee (cles petites
+            dans un type large, bits constants). Chaque passe : comptage
+            par thread sur son bloc, decalages par somme prefixe exclusive
+            du tableau (chiffre, thread) (SommePrefixe.hpp, la boucle de
+            tp2_exo5), puis dispersion de son bloc.
+
+        tri_radix_msd : la premiere passe porte sur le chiffre le plus
+            fort parmi les bits qui varient (B bits, en parallele comme une
+            passe LSD) ; les paquets obtenus sont independants et tries
+            chacun par un thread (plus gros d'abord), recursivement par
+            chiffres de 8 bits, par insertion sous TRI_RADIX_SEUIL_INSERTION
+            elements.
+
+    Dispersion avec tampons (write-combining logiciel) : au lieu d'ecrire
+    chaque element dans une des 2^B lignes de destination (2^B lignes de
+    cache et pages ouvertes a la fois), on le range dans un tampon d'une
+    ligne de cache par chiffre, recopie d'un bloc quand il est plein ; la
+    premiere recopie s'arrete sur une frontiere de ligne de destination, les
+    suivantes ecrivent des lignes entieres alignees en movnt (sans lecture
+    prealable de la ligne). Utile tant que les 2^B tampons tiennent en
+    TRI_RADIX_CACHE octets. */
+
+#ifndef TRI_RADIX_SEUIL_INSERTION
+#define TRI_RADIX_SEUIL_INSERTION 32
+#endif
+#ifndef TRI_RADIX_CACHE
+#define TRI_RADIX_CACHE (1 << 18)
+#endif
+#define TRI_RADIX_LIGNE 64
+
+template <class K, class V>
+struct Paire {
+    K cle;
+    V valeur;
+};
+
+template <class E> struct Cle {
+    typedef E type;
+    static E de(const E& e) { return e; }
+};
+template <class K, class V> struct Cle<Paire<K, V>> {
+    typedef K type;
+    static K de(const Paire<K, V>& e) { return e.cle; }
+};
+
+struct OptionsRadix {
+    int bits = 0;       /* bits par chiffre, 0 : 8 si n < 2^16, 11 sinon */
+    int tampons = -1;   /* dispersion par tampons : -1 auto, 0 non, 1 oui */
+};
+
+namespace radix_detail {
+
+inline int bits_chiffre(const OptionsRadix& o, size_t n) {
+    return o.bits > 0 ? o.bits : n < ((size_t) 1 << 16) ? 8 : 11;
+}
+
+inline bool avec_tampons(const OptionsRadix& o, int B) {
+    return o.tampons < 0 ? ((size_t) TRI_RADIX_LIGNE << B) <= TRI_RADIX_CACHE : o.tampons > 0;
+}
+
+template <class E>
+void insertion(E* a, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        E e = a[i];
+        auto k = Cle<E>::de(e);
+        size_t j = i;
+        for (; j > 0 && Cle<E>::de(a[j - 1]) > k; j--) a[j] = a[j - 1];
+        a[j] = e;
+    }
+}
+
+/* elements par tampon : une ligne de cache */
+template <class E>
+constexpr uint32_t par_ligne() {
+    return TRI_RADIX_LIGNE % sizeof(E) == 0 ? TRI_RADIX_LIGNE / sizeof(E) : 1;
+}
+
+/*  une ligne de tampon vers une ligne de destination alignee, en movntdq
+    (sse2) : pas de lecture de la ligne avant ecriture */
+inline void ecrire_ligne(void* dst, const void* src) {
+    typedef long long v2di __attribute__((vector_size(16)));
+    for (int k = 0; k < TRI_RADIX_LIGNE / 16; k++) {
+        v2di x;
+        memcpy(&x, (const char*) src + 16 * k, 16);
+        __builtin_ia32_movntdq((v2di*) dst + k, x);
+    }
+}
+
+template <class E>
+E* allouer(size_t n) {
+    size_t o = (n * sizeof(E) + TRI_RADIX_LIGNE - 1) / TRI_RADIX_LIGNE * TRI_RADIX_LIGNE;
+    return static_cast<E*>(aligned_alloc(TRI_RADIX_LIGNE, std::max<size_t>(o, TRI_RADIX_LIGNE)));
+}
+
+/*  src[deb, fin) -> dst selon le chiffre (cle >> decalage) & masque, pos
+    (2^B) : position suivante de chaque chiffre, avancee */
+template <class E>
+void disperser(const E* src, size_t deb, size_t fin, E* dst, size_t* pos, int decalage, uint64_t masque) {
+    for (size_t i = deb; i < fin; i++) {
+        uint64_t d = (Cle<E>::de(src[i]) >> decalage) & masque;
+        dst[pos[d]++] = src[i];
+    }
+}
+
+/*  idem par tampons de T elements par chiffre (tb : (masque + 1) T
+    elements). premier[d] > 0 tant que la ligne de destination du chiffre d
+    est entamee par un autre : ses premieres cases ne sont pas recopiees. */
+template <class E>
+void disperser_tampons(const E* src, size_t deb, size_t fin, E* dst, size_t* pos, int decalage, uint64_t masque,
+                       E* tb, uint32_t* rempli, uint32_t* premier) {
+    constexpr uint32_t T = par_ligne<E>();
+    size_t nb = masque + 1;
+    for (size_t d = 0; d < nb; d++) {
+        uint32_t r = T > 1 ? (uint32_t) ((uintptr_t) (dst + pos[d]) % TRI_RADIX_LIGNE / sizeof(E)) : 0;
+        rempli[d] = premier[d] = r;
+    }
+    for (size_t i = deb; i < fin; i++) {
+        E e = src[i];
+        uint64_t d = (Cle<E>::de(e) >> decalage) & masque;
+        uint32_t c = rempli[d];
+        tb[d * T + c] = e;
+        if (++c == T) {
+            uint32_t p = premier[d];
+            if (p == 0 && T > 1) {
+                ecrire_ligne(dst + pos[d], tb + d * T);
+            } else {
+                memcpy(dst + pos[d], tb + d * T + p, (T - p) * sizeof(E));
+                premier[d] = 0;
+            }
+            pos[d] += T - p;
+            c = 0;
+        }
+        rempli[d] = c;
+    }
+    for (size_t d = 0; d < nb; d++) {
+        uint32_t p = premier[d], c = rempli[d];
+        if (c > p) memcpy(dst + pos[d], tb + d * T + p, (c - p) * sizeof(E));
+        pos[d] += c - p;
+    }
+    __builtin_ia32_sfence();
+}
+
+/*  une passe parallele, appelee par tous les threads de l'equipe : h
+    (comptes du thread sur son bloc [deb, fin) de src) -> decalages
+    communs P (2^B x nt), puis dispersion */
+template <class E>
+void passe(const E* src, E* dst, size_t deb, size_t fin, const std::vector<size_t*>& H, size_t* P, int decalage,
+           int B, bool tampons, std::vector<size_t>& pos, E* tb, uint32_t* rempli, uint32_t* premier) {
+    int t = omp_get_thread_num(), nt = omp_get_num_threads();
+    size_t nb = (size_t) 1 << B;
+    #pragma omp barrier
+    #pragma omp single
+    {
+        for (size_t d = 0; d < nb; d++) {
+            for (int u = 0; u < nt; u++) P[d * nt + u] = H[u][d];
+        }
+        somme_prefixe_exclusive(P, nb * nt);
+    }
+    for (size_t d = 0; d < nb; d++) pos[d] = P[d * nt + t];
+    if (tampons) {
+        disperser_tampons(src, deb, fin, dst, pos.data(), decalage, nb - 1, tb, rempli, premier);
+    } else {
+        disperser(src, deb, fin, dst, pos.data(), decalage, nb - 1);
+    }
+    #pragma omp barrier
+}
+
+/*  tampons d'un thread pour la dispersion : (2^B) T elements alignes et
+    deux compteurs par chiffre */
+template <class E>
+struct Tampons {
+    E* tb = nullptr;
+    std::vector<uint32_t> rempli, premier;
+
+    Tampons(int B, bool actifs) {
+        if (!actifs) return;
+        tb = allouer<E>((size_t) par_ligne<E>() << B);
+        rempli.resize((size_t) 1 << B);
+        premier.resize((size_t) 1 << B);
+    }
+    ~Tampons() { free(tb); }
+};
+
+/*  MSD sequentiel sur les bits [0, decalage) : donnees dans x ; le
+    resultat doit finir dans x si x_est_a, dans y sinon */
+template <class E>
+void msd(E* x, E* y, size_t n, int decalage, bool x_est_a) {
+    size_t c[256], pos[256];
+    uint64_t masque;
+    /* chiffre constant : on passe au suivant sans deplacer */
+    do {
+        if (n <= TRI_RADIX_SEUIL_INSERTION || decalage == 0) {
+            if (decalage > 0) insertion(x, n);
+            if (!x_est_a) memcpy(y, x, n * sizeof(E));
+            return;
+        }
+        int b = std::min(8, decalage);
+        decalage -= b;
+        masque = ((uint64_t) 1 << b) - 1;
+        std::fill(c, c + masque + 1, 0);
+        for (size_t i = 0; i < n; i++) c[(Cle<E>::de(x[i]) >> decalage) & masque]++;
+    } while (*std::max_element(c, c + masque + 1) == n);
+    std::copy(c, c + masque + 1, pos);
+    somme_prefixe_exclusive(pos, masque + 1);
+    disperser(x, 0, n, y, pos, decalage, masque);
+    for (size_t d = 0, o = 0; d <= masque; o += c[d], d++) {
+        if (c[d] > 0) msd(y + o, x + o, c[d], decalage, !x_est_a);
+    }
+}
+
+} // namespace radix_detail
+
+/* tmp : n elements de travail */
+template <class E>
+void tri_radix_lsd(E* a, size_t n, E* tmp, OptionsRadix o = OptionsRadix()) {
+    using namespace radix_detail;
+    if (n <= TRI_RADIX_SEUIL_INSERTION) {
+        insertion(a, n);
+        return;
+    }
+    const int cle_bits = 8 * sizeof(typename Cle<E>::type);
+    const int B = bits_chiffre(o, n), passes = (cle_bits + B - 1) / B;
+    const size_t nb = (size_t) 1 << B;
+    const bool tampons = avec_tampons(o, B);
+    int nb_threads = n < ((size_t) 1 << 16) ? 1 : omp_get_max_threads();
+    /* H[t] : comptes du thread t, passe p en H[t] + p 2^B */
+    std::vector<size_t> comptes((size_t) nb_threads * passes * nb);
+    std::vector<size_t> P(nb * nb_threads);
+    std::vector<char> active(passes);
+    #pragma omp parallel num_threads(nb_threads)
+    {
+        int t = omp_get_thread_num(), nt = omp_get_num_threads();
+        size_t deb = n * t / nt, fin = n * (t + 1) / nt;
+        size_t* h = comptes.data() + (size_t) t * passes * nb;
+        for (size_t i = deb; i < fin; i++) {
+            uint64_t k = Cle<E>::de(a[i]);
+            for (int p = 0; p < passes; p++) h[p * nb + ((k >> (p * B)) & (nb - 1))]++;
+        }
+        #pragma omp barrier
+        #pragma omp for schedule(static)
+        for (int p = 0; p < passes; p++) {
+            size_t m = 0;
+            for (size_t d = 0; d < nb; d++) {
+                size_t s = 0;
+                for (int u = 0; u < nt; u++) s += comptes[((size_t) u * passes + p) * nb + d];
+                m = std::max(m, s);
+            }
+            active[p] = m < n;
+        }
+        Tampons<E> tb(B, tampons);
+        std::vector<size_t> pos(nb);
+        std::vector<size_t*> H(nt);
+        E* src = a;
+        E* dst = tmp;
+        bool premiere = true;
+        for (int p = 0; p < passes; p++) {
+            if (!active[p]) continue;
+            for (int u = 0; u < nt; u++) H[u] = comptes.data() + ((size_t) u * passes + p) * nb;
+            /*  les comptes initiaux valent pour l'ordre de depart ; ensuite
+                le bloc du thread a change (sauf thread unique) */
+            if (!premiere && nt > 1) {
+                std::fill(h + p * nb, h + (p + 1) * nb, 0);
+                for (size_t i = deb; i < fin; i++) h[p * nb + ((Cle<E>::de(src[i]) >> (p * B)) & (nb - 1))]++;
+            }
+            premiere = false;
+            passe(src, dst, deb, fin, H, P.data(), p * B, B, tampons, pos, tb.tb, tb.rempli.data(),
+                  tb.premier.data());
+            std::swap(src, dst);
+        }
+        if (src != a) memcpy(a + deb, src + deb, (fin - deb) * sizeof(E));
+    }
+}
+
+template <class E>
+void tri_radix_lsd(E* a, size_t n, OptionsRadix o = OptionsRadix()) {
+    E* tmp = radix_detail::allouer<E>(n);
+    tri_radix_lsd(a, n, tmp, o);
+    free(tmp);
+}
+
+template <class E>
+void tri_radix_msd(E* a, size_t n, E* tmp, OptionsRadix o = OptionsRadix()) {
+    using namespace radix_detail;
+    if (n <= TRI_RADIX_SEUIL_INSERTION) {
+        insertion(a, n);
+        return;
+    }
+    /* seuls les bits qui different de ceux de a[0] comptent */
+    uint64_t k0 = Cle<E>::de(a[0]), diff = 0;
+    #pragma omp parallel for reduction(|:diff) schedule(static)
+    for (size_t i = 0; i < n; i++) diff |= Cle<E>::de(a[i]) ^ k0;
+    if (diff == 0) return;
+    const int bits = 64 - __builtin_clzll(diff);
+    const int B = std::min(bits_chiffre(o, n), bits), decalage = bits - B;
+    const size_t nb = (size_t) 1 << B;
+    const bool tampons = avec_tampons(o, B);
+    int nb_threads = n < ((size_t) 1 << 16) ? 1 : omp_get_max_threads();
+    std::vector<size_t> comptes((size_t) nb_threads * nb), P(nb * nb_threads), total(nb + 1);
+    std::vector<uint32_t> ordre(nb);
+    #pragma omp parallel num_threads(nb_threads)
+    {
+        int t = omp_get_thread_num(), nt = omp_get_num_threads();
+        size_t deb = n * t / nt, fin = n * (t + 1) / nt;
+        size_t* h = comptes.data() + (size_t) t * nb;
+        for (size_t i = deb; i < fin; i++) h[(Cle<E>::de(a[i]) >> decalage) & (nb - 1)]++;
+        std::vector<size_t*> H(nt);
+        for (int u = 0; u < nt; u++) H[u] = comptes.data() + (size_t) u * nb;
+        {
+            Tampons<E> tb(B, tampons);
+            std::vector<size_t> pos(nb);
+            passe(a, tmp, deb, fin, H, P.data(), decalage, B, tampons, pos, tb.tb, tb.rempli.data(),
+                  tb.premier.data());
+        }
+        /* paquets du plus gros au plus petit : les derniers equilibrent */
+        #pragma omp single
+        {
+            for (size_t d = 0; d < nb; d++) total[d] = P[d * nt];
+            total[nb] = n;
+            for (size_t d = 0; d < nb; d++) ordre[d] = (uint32_t) d;
+            std::stable_sort(ordre.begin(), ordre.end(), [&](uint32_t x, uint32_t y) {
+                return total[x + 1] - total[x] > total[y + 1] - total[y];
+            });
+        }
+        #pragma omp for schedule(dynamic, 1)
+        for (size_t k = 0; k < nb; k++) {
+            size_t d = ordre[k], m = total[d + 1] - total[d];
+            if (m > 0) msd(tmp + total[d], a + total[d], m, decalage, false);
+        }
+    }
+}
+
+template <class E>
+void tri_radix_msd(E* a, size_t n, OptionsRadix o = OptionsRadix()) {
+    E* tmp = radix_detail::allouer<E>(n);
+    tri_radix_msd(a, n, tmp, o);
+    free(tmp);
+}
+
+#endif // TRI_RADIX_H
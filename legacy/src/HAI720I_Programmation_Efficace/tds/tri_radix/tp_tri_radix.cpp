@@ -0,0 +1,157 @@
+/* tri par base LSD et MSD (chiffres de 8, 11 ou 16 bits, avec ou sans
+   tampons de dispersion, 1 ou plusieurs threads) compare a std::sort, sur
+   cles 32 / 64 bits et paires cle-valeur */
+#include "../EvalPerf.hpp"
+#include "TriRadix.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <functional>
+
+template <class E> void mesurer(const char*, const std::vector<E>&, int, std::ofstream&);
+template <class E> void mesurer_si(const char*, size_t, uint64_t, size_t, std::mt19937_64&, int, std::ofstream&);
+template <class E> std::vector<E> tirer(size_t, uint64_t, std::mt19937_64&);
+
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        printf("You must enter the following details:\nsize number_of_loops output_file [max_element_bytes]\n");
+        return -1;
+    }
+    size_t n = atoll(argv[1]);
+    int number_of_loops = atoi(argv[2]);
+    std::ofstream fichier {argv[3]};
+    /* types d'au plus max_octets octets : borne la memoire (cf. commandes) */
+    size_t max_octets = argc > 4 ? atoll(argv[4]) : 16;
+    std::mt19937_64 gen(42);
+
+    fichier << omp_get_max_threads() << " threads, " << n << " elements\n";
+    mesurer_si<uint32_t>("uint32_t uniformes", n, UINT32_MAX, max_octets, gen, number_of_loops, fichier);
+    mesurer_si<uint64_t>("uint64_t uniformes", n, UINT64_MAX, max_octets, gen, number_of_loops, fichier);
+    /* 44 bits de poids fort nuls : 4 passes sur 6 sautees a 11 bits */
+    mesurer_si<uint64_t>("uint64_t < 2^20", n, (1 << 20) - 1, max_octets, gen, number_of_loops, fichier);
+    mesurer_si<Paire<uint32_t, uint32_t>>("Paire<uint32_t, uint32_t>", n, UINT32_MAX, max_octets, gen,
+                                          number_of_loops, fichier);
+    mesurer_si<Paire<uint64_t, uint64_t>>("Paire<uint64_t, uint64_t>", n, UINT64_MAX, max_octets, gen,
+                                          number_of_loops, fichier);
+    fichier.close();
+
+    return 0;
+}
+
+
+
+template <class E>
+std::vector<E> tirer(size_t n, uint64_t max, std::mt19937_64& gen) {
+    typedef typename Cle<E>::type K;
+    std::uniform_int_distribution<uint64_t> u(0, max);
+    std::vector<E> a(n);
+    for (size_t i = 0; i < n; i++) {
+        if constexpr (std::is_same<E, K>::value) {
+            a[i] = (K) u(gen);
+        } else {
+            a[i].cle = (K) u(gen);
+            a[i].valeur = i;
+        }
+    }
+    return a;
+}
+
+template <class E>
+void mesurer_si(const char* nom, size_t n, uint64_t max, size_t max_octets, std::mt19937_64& gen,
+                int number_of_loops, std::ofstream& fichier) {
+    if (sizeof(E) > max_octets) {
+        fichier << nom << ": ignore (" << sizeof(E) << " octets > " << max_octets << ")\n";
+        return;
+    }
+    mesurer(nom, tirer<E>(n, max, gen), number_of_loops, fichier);
+}
+
+template <class E>
+void mesurer(const char* nom, const std::vector<E>& donnees, int number_of_loops, std::ofstream& fichier) {
+    EvalPerf PE;
+    size_t n = donnees.size();
+    int nb_threads = omp_get_max_threads();
+    auto avant = [](const E& x, const E& y) { return Cle<E>::de(x) < Cle<E>::de(y); };
+    /* reference stable : les paires de meme cle gardent leur ordre */
+    std::vector<E> ref = donnees;
+    std::stable_sort(ref.begin(), ref.end(), avant);
+    E* a = radix_detail::allouer<E>(n);
+    E* tmp = radix_detail::allouer<E>(n);
+    double s_sort = 0;
+
+    /* std::sort n'est pas stable : on ne compare alors que les cles */
+    auto correct = [&](bool stable) {
+        if (stable) return memcmp(a, ref.data(), n * sizeof(E)) == 0;
+        for (size_t i = 0; i < n; i++) {
+            if (Cle<E>::de(a[i]) != Cle<E>::de(ref[i])) return false;
+        }
+        return true;
+    };
+    auto executer = [&](const std::string& variante, const std::function<void()>& f, bool stable = true) {
+        double nbc = 0, nbs = 0;
+        for (int k = 0; k < number_of_loops; k++) {
+            memcpy(a, donnees.data(), n * sizeof(E));
+            PE.start();
+            f();
+            PE.stop();
+            PE.nb_c();
+            nbc += PE.nb_tot;
+            nbs += PE.nb_s();
+        }
+        double s = nbs / number_of_loops;
+        if (s_sort == 0) s_sort = s;
+        fichier << "    " << variante << ": " << s * 1e3 << " ms, " << n / s * 1e-6 << " Melements/s, "
+                << nbc / number_of_loops / n << " cycles/element, x" << s_sort / s << ", "
+                << (correct(stable) ? "correct" : "FAUX") << "\n";
+    };
+    auto seul = [&](const std::function<void()>& f) {
+        return [&, f] {
+            omp_set_num_threads(1);
+            f();
+            omp_set_num_threads(nb_threads);
+        };
+    };
+
+    fichier << nom << " (" << sizeof(E) << " octets)\n";
+    executer("std::stable_sort", [&] { std::stable_sort(a, a + n, avant); });
+    s_sort = 0;
+    executer("std::sort", [&] { std::sort(a, a + n, avant); }, false);
+    for (int bits : {8, 11, 16}) {
+        for (int tampons : {0, 1}) {
+            OptionsRadix o;
+            o.bits = bits;
+            o.tampons = tampons;
+            executer("LSD " + std::to_string(bits) + " bits" + (tampons ? ", tampons" : "") + ", 1 thread",
+                     seul([&, o] { tri_radix_lsd(a, n, tmp, o); }));
+        }
+    }
+    for (int bits : {8, 11}) {
+        OptionsRadix o;
+        o.bits = bits;
+        executer("MSD " + std::to_string(bits) + " bits, 1 thread", seul([&, o] { tri_radix_msd(a, n, tmp, o); }));
+    }
+    if (nb_threads > 1) {
+        executer("LSD, " + std::to_string(nb_threads) + " threads", [&] { tri_radix_lsd(a, n, tmp); });
+        executer("MSD, " + std::to_string(nb_threads) + " threads", [&] { tri_radix_msd(a, n, tmp); });
+    }
+    free(a);
+    free(tmp);
+}
+
+/*  commandes d'execution. Pic memoire d'un type : donnees, reference, tri
+    et tableau de travail vivent ensemble (4 n sizeof(E)), plus le tampon de
+    std::stable_sort (jusqu'a n sizeof(E)) : a 10^9 elements, 16 a 20 Go en
+    uint32_t, 40 Go en uint64_t, 80 Go en Paire<uint64_t, uint64_t>. Le
+    dernier argument ne garde que les types de 4 octets :
+    ./execs/tp_tri_radix 1000000 10 tri_radix_out.txt
+    ./execs/tp_tri_radix 100000000 3 tri_radix_grand_out.txt
+    ./execs/tp_tri_radix 1000000000 1 tri_radix_1e9_out.txt 4
+*/
+/* commandes de compilation:
+    g++ -O2 -fopenmp tp_tri_radix.cpp -o execs/tp_tri_radix
+*/
@@ -0,0 +1,447 @@
+#ifndef UNIMODULARITE_H
+#define UNIMODULARITE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+/*  Test de totale unimodularite (TU) pour des matrices creuses a coefficients
+    dans {0, 1, -1} (cf. HAI820I, td 1, exercice 1).
+
+    Strategie, de la plus rapide a la plus couteuse:
+        1. coefficients hors de {0, 1, -1}          -> NON_TU
+        2. on retire les lignes/colonnes avec au plus un coefficient non nul
+           et les colonnes egales (au signe pres) : la TU est preservee
+        3. decomposition en blocs (composantes connexes du graphe
+           lignes-colonnes) : A est TU ssi chaque bloc l'est
+        4. pour chaque bloc, reconnaissance structurelle :
+             - au plus 2 non nuls par colonne (ou par ligne) : matrice
+               d'incidence de graphe oriente / biparti, on teste la
+               2-coloration de Heller-Tompkins (union-find avec parite)
+             - matrice d'intervalles (0/1, uns consecutifs dans chaque
+               colonne pour l'ordre donne des lignes)
+        5. test de Ghouila-Houri exhaustif si le bloc a au plus
+           GH_MAX_LIGNES lignes (ou colonnes, par transposition)
+        6. sinon on renvoie INCONNU
+*/
+
+enum Verdict { NON_TU = 0, TU = 1, INCONNU = 2 };
+
+/* stockage CSR : la ligne i occupe [debut[i], debut[i+1]) */
+struct MatriceCreuse {
+    uint32_t nb_lignes = 0, nb_colonnes = 0;
+    std::vector<uint32_t> debut;
+    std::vector<uint32_t> indices;
+    std::vector<int8_t> valeurs;
+
+    uint32_t nnz() const { return (uint32_t) indices.size(); }
+};
+
+/* construit une matrice CSR a partir d'une matrice dense ligne par ligne */
+inline MatriceCreuse depuis_dense(const std::vector<std::vector<int>>& A) {
+    MatriceCreuse M;
+    M.nb_lignes = (uint32_t) A.size();
+    M.nb_colonnes = A.empty() ? 0 : (uint32_t) A[0].size();
+    M.debut.push_back(0);
+    for (const auto& ligne : A) {
+        for (uint32_t j = 0; j < ligne.size(); j++) {
+            if (ligne[j] != 0) {
+                M.indices.push_back(j);
+                M.valeurs.push_back((int8_t) ligne[j]);
+            }
+        }
+        M.debut.push_back(M.nnz());
+    }
+    return M;
+}
+
+/*  transposition CSR <-> CSC par tri comptage : histogramme des colonnes,
+    somme prefixe, puis dispersion. Les indices restent tries. */
+inline MatriceCreuse transposee(const MatriceCreuse& A) {
+    MatriceCreuse T;
+    T.nb_lignes = A.nb_colonnes;
+    T.nb_colonnes = A.nb_lignes;
+    T.debut.assign(A.nb_colonnes + 1, 0);
+    T.indices.resize(A.nnz());
+    T.valeurs.resize(A.nnz());
+    for (uint32_t k = 0; k < A.nnz(); k++) {
+        T.debut[A.indices[k] + 1]++;
+    }
+    for (uint32_t j = 0; j < A.nb_colonnes; j++) {
+        T.debut[j + 1] += T.debut[j];
+    }
+    std::vector<uint32_t> pos(T.debut.begin(), T.debut.end() - 1);
+    for (uint32_t i = 0; i < A.nb_lignes; i++) {
+        for (uint32_t k = A.debut[i]; k < A.debut[i + 1]; k++) {
+            uint32_t p = pos[A.indices[k]]++;
+            T.indices[p] = i;
+            T.valeurs[p] = A.valeurs[k];
+        }
+    }
+    return T;
+}
+
+/* hachage des dimensions et des tableaux CSR, mot par mot (melange de murmur3) */
+inline uint64_t melange64(uint64_t h, uint64_t x) {
+    h ^= x + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64_t hash_matrice(const MatriceCreuse& A) {
+    uint64_t h = melange64(A.nb_lignes, A.nb_colonnes);
+    for (uint32_t i = 0; i <= A.nb_lignes; i++) h = melange64(h, A.debut[i]);
+    for (uint32_t k = 0; k < A.nnz(); k++) {
+        h = melange64(h, ((uint64_t) A.indices[k] << 8) | (uint8_t) A.valeurs[k]);
+    }
+    return h;
+}
+
+inline bool memes_matrices(const MatriceCreuse& A, const MatriceCreuse& B) {
+    return A.nb_lignes == B.nb_lignes && A.nb_colonnes == B.nb_colonnes && A.debut == B.debut
+        && A.indices == B.indices && A.valeurs == B.valeurs;
+}
+
+
+namespace tu_detail {
+
+/* union-find avec parite : parite[x] = couleur de x relativement a sa racine */
+struct UnionFindParite {
+    std::vector<uint32_t> parent;
+    std::vector<uint8_t> parite;
+
+    explicit UnionFindParite(uint32_t n) : parent(n), parite(n, 0) {
+        for (uint32_t i = 0; i < n; i++) parent[i] = i;
+    }
+
+    uint32_t trouver(uint32_t x, uint8_t& p) {
+        p = 0;
+        uint32_t r = x;
+        while (parent[r] != r) { p ^= parite[r]; r = parent[r]; }
+        /* compression de chemin en conservant les parites */
+        uint8_t q = p;
+        while (parent[x] != r) {
+            uint32_t suivant = parent[x];
+            uint8_t px = parite[x];
+            parent[x] = r;
+            parite[x] = q;
+            q ^= px;
+            x = suivant;
+        }
+        return r;
+    }
+
+    /* impose couleur(a) xor couleur(b) = d, renvoie false si contradiction */
+    bool unir(uint32_t a, uint32_t b, uint8_t d) {
+        uint8_t pa, pb;
+        uint32_t ra = trouver(a, pa), rb = trouver(b, pb);
+        if (ra == rb) return (pa ^ pb) == d;
+        parent[ra] = rb;
+        parite[ra] = pa ^ pb ^ d;
+        return true;
+    }
+};
+
+/*  Heller-Tompkins : si chaque colonne a au plus deux non nuls, A est TU ssi
+    on peut 2-colorer les lignes de sorte que deux non nuls de meme signe
+    soient de couleurs differentes et deux non nuls de signes opposes de
+    meme couleur. A est donnee en CSC (une "ligne" de C = une colonne de A).
+    Renvoie INCONNU si une colonne a plus de deux non nuls. */
+inline Verdict heller_tompkins(const MatriceCreuse& C) {
+    for (uint32_t j = 0; j < C.nb_lignes; j++) {
+        if (C.debut[j + 1] - C.debut[j] > 2) return INCONNU;
+    }
+    UnionFindParite uf(C.nb_colonnes);
+    for (uint32_t j = 0; j < C.nb_lignes; j++) {
+        uint32_t k = C.debut[j];
+        if (C.debut[j + 1] - k < 2) continue;
+        uint8_t d = (C.valeurs[k] == C.valeurs[k + 1]) ? 1 : 0;
+        if (!uf.unir(C.indices[k], C.indices[k + 1], d)) return NON_TU;
+    }
+    return TU;
+}
+
+/*  matrice d'intervalles : coefficients 0/1 et, dans chaque colonne (CSC),
+    des indices de lignes consecutifs. Condition suffisante seulement. */
+inline bool est_intervalles(const MatriceCreuse& C) {
+    for (uint32_t j = 0; j < C.nb_lignes; j++) {
+        for (uint32_t k = C.debut[j]; k < C.debut[j + 1]; k++) {
+            if (C.valeurs[k] != 1) return false;
+            if (k > C.debut[j] && C.indices[k] != C.indices[k - 1] + 1) return false;
+        }
+    }
+    return true;
+}
+
+/*  Ghouila-Houri : A est TU ssi tout sous-ensemble R de lignes admet une
+    partition R1/R2 telle que somme(R1) - somme(R2) soit dans {0,1,-1}^n.
+    Chaque colonne est codee par deux masques (lignes a +1, lignes a -1),
+    d'ou un cout en O(3^m * colonnes distinctes) pour m <= 20 lignes. */
+inline Verdict ghouila_houri(const MatriceCreuse& C, uint32_t m) {
+    std::vector<uint64_t> cols;
+    cols.reserve(C.nb_lignes);
+    for (uint32_t j = 0; j < C.nb_lignes; j++) {
+        uint32_t plus = 0, moins = 0;
+        for (uint32_t k = C.debut[j]; k < C.debut[j + 1]; k++) {
+            if (C.valeurs[k] > 0) plus |= 1u << C.indices[k];
+            else moins |= 1u << C.indices[k];
+        }
+        cols.push_back(((uint64_t) plus << 32) | moins);
+    }
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+    for (uint32_t R = 1; R < (1u << m); R++) {
+        /* par symetrie, la ligne de plus petit indice de R est dans R1 */
+        uint32_t bas = R & (0u - R);
+        uint32_t reste = R ^ bas;
+        bool trouve = false;
+        uint32_t S = reste;
+        while (true) {
+            uint32_t R1 = S | bas;
+            uint32_t R2 = R ^ R1;
+            bool ok = true;
+            for (uint64_t c : cols) {
+                uint32_t plus = (uint32_t) (c >> 32), moins = (uint32_t) c;
+                int s = __builtin_popcount(plus & R1) - __builtin_popcount(plus & R2)
+                      - __builtin_popcount(moins & R1) + __builtin_popcount(moins & R2);
+                if (s > 1 || s < -1) { ok = false; break; }
+            }
+            if (ok) { trouve = true; break; }
+            if (S == 0) break;
+            S = (S - 1) & reste;
+        }
+        if (!trouve) return NON_TU;
+    }
+    return TU;
+}
+
+/* extrait le sous-bloc (lignes, colonnes) de A en CSR, avec renumerotation */
+inline MatriceCreuse sous_bloc(const MatriceCreuse& A,
+                               const std::vector<uint32_t>& lignes,
+                               const std::vector<uint32_t>& nouvel_indice_colonne,
+                               uint32_t nb_colonnes) {
+    MatriceCreuse B;
+    B.nb_lignes = (uint32_t) lignes.size();
+    B.nb_colonnes = nb_colonnes;
+    B.debut.push_back(0);
+    for (uint32_t i : lignes) {
+        for (uint32_t k = A.debut[i]; k < A.debut[i + 1]; k++) {
+            uint32_t j = nouvel_indice_colonne[A.indices[k]];
+            if (j != UINT32_MAX) {
+                B.indices.push_back(j);
+                B.valeurs.push_back(A.valeurs[k]);
+            }
+        }
+        B.debut.push_back(B.nnz());
+    }
+    return B;
+}
+
+} // namespace tu_detail
+
+
+struct StatsUnimodularite {
+    uint64_t appels = 0, succes_cache = 0;
+    uint64_t blocs = 0, blocs_heller_tompkins = 0, blocs_intervalles = 0;
+    uint64_t blocs_ghouila_houri = 0, blocs_inconnus = 0;
+};
+
+class TesteurUnimodularite {
+public:
+    /* nombre maximal de lignes pour le test exhaustif de Ghouila-Houri */
+    uint32_t GH_MAX_LIGNES = 12;
+    StatsUnimodularite stats;
+
+    /*  le cache garde une copie de chaque matrice testee : deux matrices de
+        meme hachage ne partagent pas leur verdict */
+    Verdict tester(const MatriceCreuse& A) {
+        stats.appels++;
+        uint64_t h = hash_matrice(A);
+        auto r = cache.equal_range(h);
+        for (auto it = r.first; it != r.second; ++it) {
+            if (memes_matrices(it->second.first, A)) {
+                stats.succes_cache++;
+                return it->second.second;
+            }
+        }
+        Verdict v = tester_sans_cache(A);
+        cache.emplace(h, std::make_pair(A, v));
+        return v;
+    }
+
+    void vider_cache() { cache.clear(); }
+
+    Verdict tester_sans_cache(const MatriceCreuse& A) {
+        for (int8_t v : A.valeurs) {
+            if (v < -1 || v > 1) return NON_TU;
+        }
+        std::vector<uint8_t> ligne_active, colonne_active;
+        MatriceCreuse C = transposee(A);
+        reduire(A, C, ligne_active, colonne_active);
+        return tester_blocs(A, C, ligne_active, colonne_active);
+    }
+
+private:
+    std::unordered_multimap<uint64_t, std::pair<MatriceCreuse, Verdict>> cache;
+
+    /*  retire iterativement les lignes et colonnes ayant au plus un non nul
+        (une colonne unitaire ne change pas la TU), puis les colonnes
+        identiques au signe pres. */
+    void reduire(const MatriceCreuse& A, const MatriceCreuse& C,
+                 std::vector<uint8_t>& ligne_active,
+                 std::vector<uint8_t>& colonne_active) {
+        ligne_active.assign(A.nb_lignes, 1);
+        colonne_active.assign(A.nb_colonnes, 1);
+        std::vector<uint32_t> deg_ligne(A.nb_lignes), deg_colonne(A.nb_colonnes);
+        /* file commune : x < nb_lignes pour une ligne, sinon colonne */
+        std::vector<uint32_t> file;
+        for (uint32_t i = 0; i < A.nb_lignes; i++) {
+            deg_ligne[i] = A.debut[i + 1] - A.debut[i];
+            if (deg_ligne[i] <= 1) file.push_back(i);
+        }
+        for (uint32_t j = 0; j < A.nb_colonnes; j++) {
+            deg_colonne[j] = C.debut[j + 1] - C.debut[j];
+            if (deg_colonne[j] <= 1) file.push_back(A.nb_lignes + j);
+        }
+        while (!file.empty()) {
+            uint32_t x = file.back();
+            file.pop_back();
+            if (x < A.nb_lignes) {
+                if (!ligne_active[x]) continue;
+                ligne_active[x] = 0;
+                for (uint32_t k = A.debut[x]; k < A.debut[x + 1]; k++) {
+                    uint32_t j = A.indices[k];
+                    if (colonne_active[j] && --deg_colonne[j] == 1) file.push_back(A.nb_lignes + j);
+                }
+            } else {
+                uint32_t j = x - A.nb_lignes;
+                if (!colonne_active[j]) continue;
+                colonne_active[j] = 0;
+                for (uint32_t k = C.debut[j]; k < C.debut[j + 1]; k++) {
+                    uint32_t i = C.indices[k];
+                    if (ligne_active[i] && --deg_ligne[i] == 1) file.push_back(i);
+                }
+            }
+        }
+        /*  colonnes paralleles : on hache chaque colonne active (signe du
+            premier non nul normalise), on trie puis on compare les voisines */
+        std::vector<std::pair<uint64_t, uint32_t>> h_colonnes;
+        for (uint32_t j = 0; j < A.nb_colonnes; j++) {
+            if (!colonne_active[j]) continue;
+            uint64_t h = 0;
+            int8_t signe = 0;
+            for (uint32_t k = C.debut[j]; k < C.debut[j + 1]; k++) {
+                if (!ligne_active[C.indices[k]]) continue;
+                if (signe == 0) signe = C.valeurs[k];
+                h = melange64(h, ((uint64_t) C.indices[k] << 1) | (C.valeurs[k] == signe));
+            }
+            h_colonnes.push_back({h, j});
+        }
+        std::sort(h_colonnes.begin(), h_colonnes.end());
+        for (size_t a = 0, b = 1; b < h_colonnes.size(); b++) {
+            if (h_colonnes[b].first != h_colonnes[a].first) {
+                a = b;
+            } else if (colonnes_egales(C, ligne_active, h_colonnes[a].second, h_colonnes[b].second)) {
+                colonne_active[h_colonnes[b].second] = 0;
+            }
+        }
+    }
+
+    static bool colonnes_egales(const MatriceCreuse& C, const std::vector<uint8_t>& ligne_active,
+                                uint32_t a, uint32_t b) {
+        uint32_t ka = C.debut[a], kb = C.debut[b];
+        int produit = 0;
+        while (true) {
+            while (ka < C.debut[a + 1] && !ligne_active[C.indices[ka]]) ka++;
+            while (kb < C.debut[b + 1] && !ligne_active[C.indices[kb]]) kb++;
+            bool fin_a = ka == C.debut[a + 1], fin_b = kb == C.debut[b + 1];
+            if (fin_a || fin_b) return fin_a && fin_b;
+            if (C.indices[ka] != C.indices[kb]) return false;
+            int p = C.valeurs[ka] * C.valeurs[kb];
+            if (produit == 0) produit = p;
+            else if (p != produit) return false;
+            ka++;
+            kb++;
+        }
+    }
+
+    /* composantes connexes du graphe biparti lignes/colonnes actives */
+    Verdict tester_blocs(const MatriceCreuse& A, const MatriceCreuse& C,
+                         const std::vector<uint8_t>& ligne_active,
+                         const std::vector<uint8_t>& colonne_active) {
+        std::vector<uint32_t> composante(A.nb_lignes, UINT32_MAX);
+        std::vector<uint8_t> colonne_vue(A.nb_colonnes, 0);
+        std::vector<uint32_t> pile, lignes;
+        std::vector<uint32_t> nouvel_indice(A.nb_colonnes, UINT32_MAX);
+        std::vector<uint32_t> colonnes_du_bloc;
+        bool inconnu = false;
+
+        for (uint32_t s = 0; s < A.nb_lignes; s++) {
+            if (!ligne_active[s] || composante[s] != UINT32_MAX) continue;
+            lignes.clear();
+            colonnes_du_bloc.clear();
+            pile.push_back(s);
+            composante[s] = s;
+            while (!pile.empty()) {
+                uint32_t i = pile.back();
+                pile.pop_back();
+                lignes.push_back(i);
+                for (uint32_t k = A.debut[i]; k < A.debut[i + 1]; k++) {
+                    uint32_t j = A.indices[k];
+                    if (!colonne_active[j] || colonne_vue[j]) continue;
+                    colonne_vue[j] = 1;
+                    nouvel_indice[j] = (uint32_t) colonnes_du_bloc.size();
+                    colonnes_du_bloc.push_back(j);
+                    for (uint32_t l = C.debut[j]; l < C.debut[j + 1]; l++) {
+                        uint32_t i2 = C.indices[l];
+                        if (ligne_active[i2] && composante[i2] == UINT32_MAX) {
+                            composante[i2] = s;
+                            pile.push_back(i2);
+                        }
+                    }
+                }
+            }
+            std::sort(lignes.begin(), lignes.end());
+            MatriceCreuse B = tu_detail::sous_bloc(A, lignes, nouvel_indice,
+                                                   (uint32_t) colonnes_du_bloc.size());
+            for (uint32_t j : colonnes_du_bloc) nouvel_indice[j] = UINT32_MAX;
+
+            Verdict v = tester_bloc(B);
+            if (v == NON_TU) return NON_TU;
+            if (v == INCONNU) inconnu = true;
+        }
+        return inconnu ? INCONNU : TU;
+    }
+
+    Verdict tester_bloc(const MatriceCreuse& B) {
+        stats.blocs++;
+        MatriceCreuse Bt = transposee(B);
+        /* Bt est la CSC de B et B la CSC de Bt */
+        Verdict v = tu_detail::heller_tompkins(Bt);
+        if (v == INCONNU) v = tu_detail::heller_tompkins(B);
+        if (v != INCONNU) {
+            stats.blocs_heller_tompkins++;
+            return v;
+        }
+        if (tu_detail::est_intervalles(Bt) || tu_detail::est_intervalles(B)) {
+            stats.blocs_intervalles++;
+            return TU;
+        }
+        uint32_t m = std::min(B.nb_lignes, B.nb_colonnes);
+        if (m <= GH_MAX_LIGNES) {
+            stats.blocs_ghouila_houri++;
+            return B.nb_lignes <= B.nb_colonnes ? tu_detail::ghouila_houri(Bt, B.nb_lignes)
+                                                : tu_detail::ghouila_houri(B, B.nb_colonnes);
+        }
+        stats.blocs_inconnus++;
+        return INCONNU;
+    }
+};
+
+#endif // UNIMODULARITE_H
@@ -0,0 +1,186 @@
+/* test de totale unimodularite : verdicts sur les matrices du td 1 de HAI820I
+   puis mesure du cout du test sur de grandes matrices creuses */
+#include "../EvalPerf.hpp"
+#include "Unimodularite.hpp"
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+
+MatriceCreuse matrice_reseau(uint32_t, uint32_t);
+MatriceCreuse matrice_intervalles(uint32_t, uint32_t, uint32_t);
+MatriceCreuse matrice_cycle_impair(uint32_t);
+double produit_matrice_vecteur(const MatriceCreuse&, const std::vector<double>&, std::vector<double>&);
+const char* nom_verdict(Verdict);
+
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("You must enter the following details:\nnb_rows nb_columns number_of_loops output_file\n");
+        return -1;
+    }
+    uint32_t nb_lignes = atoi(argv[1]);
+    uint32_t nb_colonnes = atoi(argv[2]);
+    int number_of_loops = atoi(argv[3]);
+    std::ofstream fichier {argv[4]};
+    srand(42);
+
+    /* matrices de l'exercice 1 : A est TU, C, D et E ne le sont pas */
+    TesteurUnimodularite T;
+    std::vector<std::pair<const char*, std::vector<std::vector<int>>>> td = {
+        {"A", {{1, -1, 1}, {-1, 1, 0}}},
+        {"B", {{1, 1, 0, 0, 1}, {0, 1, 1, 1, 0}, {-1, 0, 0, 0, -1}, {0, 0, -1, 0, 0}}},
+        {"C", {{1, -1}, {1, 1}}},
+        {"D", {{1, 1, 0}, {0, 1, 1}, {1, 0, 1}}},
+        {"E", {{1, -1, 1}, {1, 1, 0}}},
+    };
+    for (auto& m : td) {
+        printf("%s: %s\n", m.first, nom_verdict(T.tester(depuis_dense(m.second))));
+    }
+
+    std::vector<std::pair<const char*, MatriceCreuse>> instances;
+    instances.push_back({"reseau", matrice_reseau(nb_lignes, nb_colonnes)});
+    instances.push_back({"intervalles", matrice_intervalles(nb_lignes, nb_colonnes, 8)});
+    instances.push_back({"cycle_impair", matrice_cycle_impair(nb_lignes | 1)});
+
+    EvalPerf PE;
+    for (auto& inst : instances) {
+        const MatriceCreuse& A = inst.second;
+        std::vector<double> x(A.nb_colonnes, 1.0), y(A.nb_lignes);
+        double nbc_test = 0, nbs_test = 0, nbc_cache = 0, nbc_spmv = 0;
+        Verdict v = INCONNU;
+        for (int k = 0; k < number_of_loops; k++) {
+            T.vider_cache();
+            PE.start();
+            v = T.tester(A);
+            PE.stop();
+            PE.nb_c();
+            nbc_test += PE.nb_tot;
+            nbs_test += PE.nb_s();
+
+            PE.start();
+            T.tester(A);
+            PE.stop();
+            PE.nb_c();
+            nbc_cache += PE.nb_tot;
+
+            PE.start();
+            produit_matrice_vecteur(A, x, y);
+            PE.stop();
+            PE.nb_c();
+            nbc_spmv += PE.nb_tot;
+        }
+        nbc_test /= number_of_loops;
+        nbc_cache /= number_of_loops;
+        nbc_spmv /= number_of_loops;
+        /*  un solveur (simplexe ou branch-and-bound) fait au moins plusieurs
+            centaines de produits matrice-vecteur : le test doit rester a
+            quelques produits pour etre rentable */
+        fichier << inst.first << " (" << A.nb_lignes << "x" << A.nb_colonnes
+                << ", nnz=" << A.nnz() << ") verdict=" << nom_verdict(v) << "\n";
+        fichier << "nbc test:" << nbc_test << "\n";
+        fichier << "nbs test:" << nbs_test / number_of_loops << "\n";
+        fichier << "cycles/nnz:" << nbc_test / A.nnz() << "\n";
+        fichier << "nbc cache:" << nbc_cache << "\n";
+        fichier << "test en produits matrice-vecteur:" << nbc_test / nbc_spmv << "\n";
+    }
+    fichier << "blocs:" << T.stats.blocs
+            << " heller_tompkins:" << T.stats.blocs_heller_tompkins
+            << " intervalles:" << T.stats.blocs_intervalles
+            << " ghouila_houri:" << T.stats.blocs_ghouila_houri
+            << " inconnus:" << T.stats.blocs_inconnus << "\n";
+    fichier.close();
+
+    return 0;
+}
+
+
+
+/* matrice d'incidence sommets x arcs d'un graphe oriente aleatoire */
+MatriceCreuse matrice_reseau(uint32_t n, uint32_t m) {
+    std::vector<std::vector<std::pair<uint32_t, int8_t>>> lignes(n);
+    for (uint32_t j = 0; j < m; j++) {
+        uint32_t u = rand() % n, v = rand() % n;
+        if (u == v) v = (u + 1) % n;
+        lignes[u].push_back({j, 1});
+        lignes[v].push_back({j, -1});
+    }
+    MatriceCreuse A;
+    A.nb_lignes = n;
+    A.nb_colonnes = m;
+    A.debut.push_back(0);
+    for (auto& l : lignes) {
+        for (auto& e : l) {
+            A.indices.push_back(e.first);
+            A.valeurs.push_back(e.second);
+        }
+        A.debut.push_back(A.nnz());
+    }
+    return A;
+}
+
+/* colonnes 0/1 formees d'intervalles de lignes de longueur au plus lmax */
+MatriceCreuse matrice_intervalles(uint32_t n, uint32_t m, uint32_t lmax) {
+    std::vector<std::vector<uint32_t>> lignes(n);
+    for (uint32_t j = 0; j < m; j++) {
+        uint32_t a = rand() % n;
+        uint32_t l = 1 + rand() % lmax;
+        for (uint32_t i = a; i < std::min(n, a + l); i++) lignes[i].push_back(j);
+    }
+    MatriceCreuse A;
+    A.nb_lignes = n;
+    A.nb_colonnes = m;
+    A.debut.push_back(0);
+    for (auto& l : lignes) {
+        for (uint32_t j : l) {
+            A.indices.push_back(j);
+            A.valeurs.push_back(1);
+        }
+        A.debut.push_back(A.nnz());
+    }
+    return A;
+}
+
+/* incidence d'un cycle non oriente de longueur impaire : determinant 2 */
+MatriceCreuse matrice_cycle_impair(uint32_t n) {
+    MatriceCreuse A;
+    A.nb_lignes = n;
+    A.nb_colonnes = n;
+    A.debut.push_back(0);
+    for (uint32_t i = 0; i < n; i++) {
+        /* la ligne i touche les aretes i-1 et i */
+        uint32_t a = (i + n - 1) % n, b = i;
+        if (a > b) std::swap(a, b);
+        A.indices.push_back(a);
+        A.valeurs.push_back(1);
+        A.indices.push_back(b);
+        A.valeurs.push_back(1);
+        A.debut.push_back(A.nnz());
+    }
+    return A;
+}
+
+double produit_matrice_vecteur(const MatriceCreuse& A, const std::vector<double>& x, std::vector<double>& y) {
+    double s = 0;
+    for (uint32_t i = 0; i < A.nb_lignes; i++) {
+        double t = 0;
+        for (uint32_t k = A.debut[i]; k < A.debut[i + 1]; k++) {
+            t += A.valeurs[k] * x[A.indices[k]];
+        }
+        y[i] = t;
+        s += t;
+    }
+    return s;
+}
+
+const char* nom_verdict(Verdict v) {
+    return v == TU ? "TU" : (v == NON_TU ? "non TU" : "inconnu");
+}
+
+/*  commandes d'execution:
+    ./execs/tp_unimodularite 100000 400000 10 unimodularite_out.txt
+*/
+/* commandes de compilation:
+    g++ -O2 tp_unimodularite.cpp -o execs/tp_unimodularite
+*/